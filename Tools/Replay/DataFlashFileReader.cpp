@@ -27,11 +27,25 @@ bool AP_LoggerFileReader::open_log(const char *logfile)
     if (fd == -1) {
         return false;
     }
+#if HAL_LOGGER_FILE_COMPRESSION_ENABLED
+    if (compressed_reader.open(fd)) {
+        ::printf("Reading compressed log\n");
+    }
+#endif
     return true;
 }
 
 ssize_t AP_LoggerFileReader::read_input(void *buffer, const size_t count)
 {
+#if HAL_LOGGER_FILE_COMPRESSION_ENABLED
+    if (compressed_reader.is_open()) {
+        const int32_t ret = compressed_reader.read((uint8_t *)buffer, count);
+        if (ret > 0) {
+            bytes_read += ret;
+        }
+        return ret;
+    }
+#endif
     uint64_t ret = AP::FS().read(fd, buffer, count);
     bytes_read += ret;
     return ret;
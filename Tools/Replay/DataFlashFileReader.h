@@ -1,6 +1,7 @@
 #pragma once
 
 #include <AP_Logger/AP_Logger.h>
+#include <AP_Logger/AP_Logger_Compress.h>
 
 #define LOGREADER_MAX_FORMATS 255 // must be >= highest MESSAGE
 
@@ -28,6 +29,11 @@ protected:
 private:
     ssize_t read_input(void *buf, size_t count);
 
+#if HAL_LOGGER_FILE_COMPRESSION_ENABLED
+    // decodes the log if it was written compressed
+    AP_Logger_CompressedReader compressed_reader;
+#endif
+
     uint64_t bytes_read = 0;
     uint32_t message_count = 0;
     uint64_t start_micros;
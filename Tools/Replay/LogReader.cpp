@@ -59,6 +59,18 @@ bool LogReader::handle_log_format_msg(const struct log_Format &f)
         return true;
     }
 
+    if (streq(name, "RDLT")) {
+        rdlt_type = f.type;
+        return true;
+    }
+
+    // per-instance replay messages end in an "I" field holding the
+    // instance
+    char labels[sizeof(f.labels)+1] {};
+    memcpy(labels, f.labels, sizeof(f.labels));
+    const size_t labels_len = strlen(labels);
+    delta_has_instance[f.type] = labels_len >= 2 && streq(&labels[labels_len-2], ",I");
+
     // map from format name to a parser subclass:
 	if (streq(name, "PARM")) {
         msgparser[f.type] = new LR_MsgHandler_PARM(formats[f.type]);
@@ -135,6 +147,11 @@ bool LogReader::handle_msg(const struct log_Format &f, uint8_t *msg) {
     // emit the output as we receive it:
     AP::logger().WriteBlock(msg, f.length);
 
+    if (f.type == rdlt_type) {
+        apply_delta(msg);
+        return true;
+    }
+
     LR_MsgHandler *p = msgparser[f.type];
     if (p == NULL) {
         return true;
@@ -142,9 +159,63 @@ bool LogReader::handle_msg(const struct log_Format &f, uint8_t *msg) {
 
     p->process_message(msg);
 
+    if (f.name[0] == 'R') {
+        save_delta_base(f, msg);
+    }
+
     return true;
 }
 
+/*
+  keep a copy of a replay message for RDLT deltas to be applied to
+ */
+void LogReader::save_delta_base(const struct log_Format &f, const uint8_t *msg)
+{
+    const uint8_t instance = delta_has_instance[f.type] ? msg[f.length-1] : 0;
+    if (instance >= delta_max_instances) {
+        return;
+    }
+    uint8_t *&base = delta_base[f.type][instance];
+    if (base == nullptr) {
+        base = new uint8_t[f.length];
+    }
+    memcpy(base, msg, f.length);
+}
+
+/*
+  rebuild a replay message from a RDLT delta and process it as though
+  the whole message had been in the log
+ */
+void LogReader::apply_delta(const uint8_t *msg)
+{
+    log_RDLT delta;
+    memcpy(&delta, &msg[3], offsetof(log_RDLT, _end));
+
+    const struct log_Format &f = formats[delta.id];
+    LR_MsgHandler *p = msgparser[delta.id];
+    uint8_t *base = delta.instance < delta_max_instances ? delta_base[delta.id][delta.instance] : nullptr;
+    if (p == nullptr || base == nullptr) {
+        // the log started part way through, or the message was lost
+        if (!delta_base_missing) {
+            ::printf("RDLT for type %u instance %u with no previous message\n",
+                     unsigned(delta.id), unsigned(delta.instance));
+            delta_base_missing = true;
+        }
+        return;
+    }
+
+    const uint8_t len = f.length - 3;
+    uint8_t count = 0;
+    for (uint8_t ofs=0; ofs<len && count<RDLT_MAX_WORDS; ofs+=4) {
+        if ((delta.mask & (1UL<<(ofs/4))) == 0) {
+            continue;
+        }
+        memcpy(&base[3+ofs], &delta.data[count++], MIN(4, len - ofs));
+    }
+
+    p->process_message(base);
+}
+
 /*
   see if a user parameter is set
  */
@@ -31,6 +31,18 @@ private:
     uint8_t _log_structure_count;
 
     class LR_MsgHandler *msgparser[LOGREADER_MAX_FORMATS] {};
+
+    // RDLT messages carry the changed words of a replay message, to
+    // be applied to the last copy of that message with the same
+    // instance
+    static const uint8_t delta_max_instances = 16;
+    uint8_t *delta_base[LOGREADER_MAX_FORMATS][delta_max_instances] {};
+    bool delta_has_instance[LOGREADER_MAX_FORMATS] {};
+    int16_t rdlt_type = -1;
+    bool delta_base_missing;
+
+    void save_delta_base(const struct log_Format &f, const uint8_t *msg);
+    void apply_delta(const uint8_t *msg);
 };
 
 // some vars are difficult to get through the layers
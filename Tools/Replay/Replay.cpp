@@ -39,6 +39,7 @@ static ReplayVehicle replayvehicle;
 user_parameter *user_parameters;
 bool replay_force_ekf2;
 bool replay_force_ekf3;
+bool replay_benchmark;
 
 #define GSCALAR(v, name, def) { replayvehicle.g.v.vtype, name, Parameters::k_param_ ## v, &replayvehicle.g.v, {def_value : def} }
 #define GOBJECT(v, name, class) { AP_PARAM_GROUP, name, Parameters::k_param_ ## v, &replayvehicle.v, {group_info : class::var_info} }
@@ -127,6 +128,10 @@ void ReplayVehicle::init_ardupilot(void)
     // message as a product of Replay), or the format understood in
     // the current code (if we do emit the message in the normal
     // places in the EKF, for example)
+    if (replay_benchmark) {
+        // no backends, so only the estimators are timed
+        AP_Param::set_by_name("LOG_BACKEND_TYPE", 0);
+    }
     logger.Init(log_structure, 0);
     logger.set_force_log_disarmed(true);
 }
@@ -138,11 +143,13 @@ void Replay::usage(void)
     ::printf("\t--param-file FILENAME  load parameters from a file\n");
     ::printf("\t--force-ekf2 force enable EKF2\n");
     ::printf("\t--force-ekf3 force enable EKF3\n");
+    ::printf("\t--benchmark  do not write a log and report EKF3 run times\n");
 }
 
 enum param_key : uint8_t {
     FORCE_EKF2 = 1,
     FORCE_EKF3,
+    BENCHMARK,
 };
 
 void Replay::_parse_command_line(uint8_t argc, char * const argv[])
@@ -154,6 +161,7 @@ void Replay::_parse_command_line(uint8_t argc, char * const argv[])
         {"param-file",      true,   0, 'F'},
         {"force-ekf2",      false,  0, param_key::FORCE_EKF2},
         {"force-ekf3",      false,  0, param_key::FORCE_EKF3},
+        {"benchmark",       false,  0, param_key::BENCHMARK},
         {"help",            false,  0, 'h'},
         {0, false, 0, 0}
     };
@@ -189,6 +197,10 @@ void Replay::_parse_command_line(uint8_t argc, char * const argv[])
             replay_force_ekf3 = true;
             break;
 
+        case param_key::BENCHMARK:
+            replay_benchmark = true;
+            break;
+
         case 'h':
         default:
             usage();
@@ -252,6 +264,9 @@ void Replay::setup()
 void Replay::loop()
 {
     if (!reader.update()) {
+        if (replay_benchmark) {
+            print_benchmark();
+        }
 #if CONFIG_HAL_BOARD == HAL_BOARD_LINUX
     // If we don't tear down the threads then they continue to access
     // global state during object destruction.
@@ -261,6 +276,47 @@ void Replay::loop()
     }
 }
 
+/*
+  print the time spent in EKF3, per IMU frame and per function for
+  each core. Times are wall clock so depend on the machine running
+  Replay; compare runs on the same machine
+ */
+void Replay::print_benchmark(void)
+{
+#if EK3_FEATURE_PROFILE
+    const NavEKF3_Profile &frame = _vehicle.ekf3.get_frame_profile();
+    const NavEKF3_Profile::Stats &fs = frame.get(NavEKF3_Profile::Section::UpdateFilter);
+    ::printf("EKF3 benchmark: ftype=%s frames=%u total_us=%llu us_per_frame=%.2f\n",
+             sizeof(ftype) == sizeof(double) ? "double" : "float",
+             unsigned(fs.count),
+             (unsigned long long)fs.total_us,
+             fs.count ? double(fs.total_us) / fs.count : 0.0);
+    for (uint8_t i=0; i<MAX_EKF_CORES; i++) {
+        const NavEKF3_Profile *p = _vehicle.ekf3.get_core_profile(i);
+        if (p == nullptr) {
+            break;
+        }
+        for (uint8_t s=0; s<NavEKF3_Profile::num_sections; s++) {
+            const auto section = NavEKF3_Profile::Section(s);
+            const NavEKF3_Profile::Stats &st = p->get(section);
+            if (st.count == 0) {
+                continue;
+            }
+            ::printf("EKF3 core %u %s: count=%u total_us=%llu avg_us=%.2f max_us=%u us_per_frame=%.2f\n",
+                     unsigned(i),
+                     NavEKF3_Profile::name(section),
+                     unsigned(st.count),
+                     (unsigned long long)st.total_us,
+                     double(st.total_us) / st.count,
+                     unsigned(st.max_us),
+                     fs.count ? double(st.total_us) / fs.count : 0.0);
+        }
+    }
+#else
+    ::printf("EKF3 profiling not available in this build\n");
+#endif
+}
+
 /*
   setup user -p parameters
  */
@@ -26,6 +26,7 @@ struct user_parameter {
 extern user_parameter *user_parameters;
 extern bool replay_force_ekf2;
 extern bool replay_force_ekf3;
+extern bool replay_benchmark;
 
 class ReplayVehicle : public AP_Vehicle {
 public:
@@ -92,4 +93,5 @@ private:
     bool parse_param_line(char *line, char **vname, float &value);
     void load_param_file(const char *filename);
     void usage();
+    void print_benchmark(void);
 };
@@ -0,0 +1,119 @@
+#!/usr/bin/env python
+
+'''
+time EKF3 by replaying logs through Replay --benchmark, for float
+and double ftype builds
+
+Run from the top of the tree. Results can be saved and used as a
+baseline for a later run, failing if any time has grown by more than
+the allowed percentage. Times are wall clock, so only compare runs
+made on the same machine
+'''
+
+from __future__ import print_function
+
+import json
+import os
+import re
+import subprocess
+import sys
+
+FTYPES = ['float', 'double']
+
+frame_re = re.compile(r'^EKF3 benchmark: ftype=(\w+) frames=(\d+) total_us=(\d+) us_per_frame=([0-9.]+)')
+section_re = re.compile(r'^EKF3 core (\d+) (\w+): count=(\d+) total_us=(\d+) avg_us=([0-9.]+) max_us=(\d+) us_per_frame=([0-9.]+)')
+
+
+def replay_binary(ftype):
+    return os.path.join("build", "replay-%s" % ftype, "sitl", "tool", "Replay")
+
+
+def build_replay(ftype):
+    '''build Replay for one ftype into its own output directory'''
+    out = os.path.join("build", "replay-%s" % ftype)
+    opt = "--ekf-double" if ftype == 'double' else "--ekf-single"
+    subprocess.check_call(["./waf", "configure", "--board", "sitl", opt, "--out", out])
+    subprocess.check_call(["./waf", "--out", out, "replay"])
+
+
+def run_replay(ftype, logfile, params):
+    '''run Replay on a log and return a dict of results, keyed by
+    "frame" for the time per IMU frame and "coreN.Function" for the
+    time per IMU frame spent in each function'''
+    cmd = [replay_binary(ftype), "--benchmark"]
+    for p in params:
+        cmd.extend(["--parm", p])
+    cmd.append(logfile)
+    output = subprocess.check_output(cmd, universal_newlines=True)
+    results = {}
+    for line in output.splitlines():
+        m = frame_re.match(line)
+        if m is not None:
+            if m.group(1) != ftype:
+                raise ValueError("%s built with ftype=%s" % (cmd[0], m.group(1)))
+            results["frame"] = float(m.group(4))
+            results["frames"] = int(m.group(2))
+            continue
+        m = section_re.match(line)
+        if m is not None:
+            results["core%s.%s" % (m.group(1), m.group(2))] = float(m.group(7))
+    if "frame" not in results:
+        raise ValueError("no EKF3 benchmark output from %s" % logfile)
+    return results
+
+
+def compare(baseline, results, max_regression):
+    '''print any times more than max_regression percent over baseline,
+    returning true if there were none'''
+    ok = True
+    for key in sorted(results.keys()):
+        old = baseline.get(key, None)
+        if old is None or key.endswith(".frames"):
+            continue
+        new = results[key]
+        if old > 0 and (new - old) * 100.0 / old > max_regression:
+            print("REGRESSION %s: %.2f -> %.2f us per frame" % (key, old, new))
+            ok = False
+    return ok
+
+
+if __name__ == '__main__':
+    from argparse import ArgumentParser
+    parser = ArgumentParser(description=__doc__)
+    parser.add_argument("--no-build", action='store_true', help="use existing Replay builds")
+    parser.add_argument("--ftype", choices=FTYPES, action='append', default=[], help="only benchmark this ftype")
+    parser.add_argument("--parm", action='append', default=[], help="set parameter NAME=VALUE in Replay")
+    parser.add_argument("--save", default=None, help="save results to this JSON file")
+    parser.add_argument("--baseline", default=None, help="compare against results saved with --save")
+    parser.add_argument("--max-regression", type=float, default=10.0, help="allowed percentage increase over baseline")
+    parser.add_argument("logs", metavar="LOG", nargs="+")
+
+    args = parser.parse_args()
+
+    ftypes = args.ftype if len(args.ftype) else FTYPES
+
+    results = {}
+    for ftype in ftypes:
+        if not args.no_build:
+            build_replay(ftype)
+        for logfile in args.logs:
+            r = run_replay(ftype, logfile, args.parm)
+            print("%s %s: %u frames, %.2f us per frame" % (logfile, ftype, r["frames"], r["frame"]))
+            for key in sorted(r.keys()):
+                if key.startswith("core"):
+                    print("  %-30s %8.2f us per frame" % (key, r[key]))
+            for key in r.keys():
+                results["%s.%s.%s" % (os.path.basename(logfile), ftype, key)] = r[key]
+
+    if args.save is not None:
+        with open(args.save, "w") as f:
+            json.dump(results, f, indent=2, sort_keys=True)
+
+    if args.baseline is not None:
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+        if not compare(baseline, results, args.max_regression):
+            print("FAILED")
+            sys.exit(1)
+        print("Passed")
+    sys.exit(0)
@@ -416,10 +416,14 @@ def ap_find_benchmarks(bld, use=[]):
         while to_remove in bld.env.CXXFLAGS:
             bld.env.CXXFLAGS.remove(to_remove)
 
+    features = ['gbenchmark']
+    if bld.cmd == 'benchmark':
+        features.append('gbenchmark_run')
+
     for f in bld.path.ant_glob(incl='*.cpp'):
         ap_program(
             bld,
-            features=['gbenchmark'],
+            features=features,
             includes=includes,
             source=[f],
             use=use,
@@ -75,3 +75,33 @@ def wait_for_gbenchmark_install(self):
     for task in self.compiled_tasks:
         task.set_run_after(gbenchmark_install.cmake_build_task)
         task.dep_nodes.extend(gbenchmark_install.cmake_build_task.outputs)
+
+class gbenchmark_run(Task.Task):
+    """runs a benchmark program and writes its results as JSON"""
+    color = 'CYAN'
+    always_run = True
+
+    def run(self):
+        exe = self.inputs[0].abspath()
+        out = self.outputs[0].abspath()
+        cmd = [
+            exe,
+            '--benchmark_out=%s' % out,
+            '--benchmark_out_format=json',
+        ]
+        return self.exec_command(cmd, cwd=self.inputs[0].parent.abspath())
+
+    def __str__(self):
+        return self.outputs[0].path_from(self.generator.bld.bldnode)
+
+@feature('gbenchmark_run')
+@after_method('apply_link')
+def create_gbenchmark_run_task(self):
+    link_task = getattr(self, 'link_task', None)
+    if not link_task:
+        return
+
+    exe = link_task.outputs[0]
+    results = self.bld.bldnode.make_node('benchmarks/%s.json' % exe.name)
+    results.parent.mkdir()
+    self.create_task('gbenchmark_run', exe, results)
@@ -795,12 +795,21 @@ void AC_Avoid::adjust_velocity_inclusion_and_exclusion_polygons(float kP, float
         return;
     }
 
+    // vehicle position, used to skip polygons too far away to matter
+    Vector2f position_xy;
+    const bool have_position = AP::ahrs().get_relative_position_NE_origin(position_xy);
+    position_xy *= 100.0f;  // m to cm
+
     // for backing away
     Vector2f quad_1_back_vel, quad_2_back_vel, quad_3_back_vel, quad_4_back_vel;
 
     // iterate through inclusion polygons
     const uint8_t num_inclusion_polygons = fence->polyfence().get_inclusion_polygon_count();
     for (uint8_t i = 0; i < num_inclusion_polygons; i++) {
+        if (have_position &&
+            polygon_out_of_reach(kP, accel_cmss, desired_vel_cms, fence->polyfence().get_inclusion_polygon_boundary_distance(i, position_xy), fence->get_margin(), dt)) {
+            continue;
+        }
         uint16_t num_points;
         const Vector2f* boundary = fence->polyfence().get_inclusion_polygon(i, num_points);
         Vector2f backup_vel_inc;
@@ -812,6 +821,10 @@ void AC_Avoid::adjust_velocity_inclusion_and_exclusion_polygons(float kP, float
     // iterate through exclusion polygons
     const uint8_t num_exclusion_polygons = fence->polyfence().get_exclusion_polygon_count();
     for (uint8_t i = 0; i < num_exclusion_polygons; i++) {
+        if (have_position &&
+            polygon_out_of_reach(kP, accel_cmss, desired_vel_cms, fence->polyfence().get_exclusion_polygon_boundary_distance(i, position_xy), fence->get_margin(), dt)) {
+            continue;
+        }
         uint16_t num_points;
         const Vector2f* boundary = fence->polyfence().get_exclusion_polygon(i, num_points);
         Vector2f backup_vel_exc;
@@ -1378,6 +1391,33 @@ void AC_Avoid::adjust_velocity_polygon(float kP, float accel_cmss, Vector2f &des
     backup_vel = desired_back_vel_cms;
 }
 
+/*
+ * Returns true if a polygon whose edges are all at least boundary_dist_cm
+ * from the vehicle can neither limit desired_vel_cms nor require backing away.
+ * This mirrors the edge handling in adjust_velocity_polygon: backing away only
+ * happens within the margin, sliding limits speed towards an edge to
+ * get_max_speed() of the distance beyond the margin, and stopping only
+ * considers edges within the stopping distance plus margin
+ */
+bool AC_Avoid::polygon_out_of_reach(float kP, float accel_cmss, const Vector2f &desired_vel_cms, float boundary_dist_cm, float margin, float dt) const
+{
+    const float margin_cm = MAX(margin * 100.0f, 0.0f);
+    if (boundary_dist_cm <= margin_cm) {
+        return false;
+    }
+    if (desired_vel_cms.is_zero()) {
+        return true;
+    }
+    const float speed = desired_vel_cms.length();
+    switch (_behavior) {
+    case BEHAVIOR_SLIDE:
+        return get_max_speed(kP, accel_cmss, boundary_dist_cm - margin_cm, dt) >= speed;
+    case BEHAVIOR_STOP:
+        return boundary_dist_cm > 2.0f + margin_cm + get_stopping_distance(kP, accel_cmss, speed);
+    }
+    return false;
+}
+
 /*
  * Computes distance required to stop, given current speed.
  *
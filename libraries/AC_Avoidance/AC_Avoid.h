@@ -158,6 +158,13 @@ private:
      */
     void adjust_velocity_polygon(float kP, float accel_cmss, Vector2f &desired_vel_cms, Vector2f &backup_vel, const Vector2f* boundary, uint16_t num_points, float margin, float dt, bool stay_inside);
 
+    /*
+     * Returns true if a polygon whose edges are all at least boundary_dist_cm
+     * from the vehicle can neither limit desired_vel_cms nor require backing away,
+     * so adjust_velocity_polygon need not be called for it
+     */
+    bool polygon_out_of_reach(float kP, float accel_cmss, const Vector2f &desired_vel_cms, float boundary_dist_cm, float margin, float dt) const;
+
     /*
      * Computes distance required to stop, given current speed.
      */
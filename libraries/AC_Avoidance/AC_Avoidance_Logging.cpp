@@ -29,6 +29,20 @@ void AP_OABendyRuler::Write_OABendyRuler(const uint8_t type, const bool active,
     AP::logger().WriteBlock(&pkt, sizeof(pkt));
 }
 
+void AP_OABendyRuler::Write_OABendyRulerTiming(const uint8_t type, const uint32_t duration_us) const
+{
+    const struct log_OABendyRulerTiming pkt{
+        LOG_PACKET_HEADER_INIT(LOG_OA_BENDYRULER_TIMING_MSG),
+        time_us         : AP_HAL::micros64(),
+        type            : type,
+        duration_us     : duration_us,
+        num_calculated  : _stats.probes_calculated,
+        num_reused      : _stats.probes_reused,
+        num_objects     : _snapshot.db_count,
+    };
+    AP::logger().WriteBlock(&pkt, sizeof(pkt));
+}
+
 void AP_OADijkstra::Write_OADijkstra(const uint8_t state, const uint8_t error_id, const uint8_t curr_point, const uint8_t tot_points, const Location &final_dest, const Location &oa_dest) const
 {
     const struct log_OADijkstra pkt{
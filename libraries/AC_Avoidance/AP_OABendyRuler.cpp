@@ -31,6 +31,7 @@ const float OA_BENDYRULER_LOOKAHEAD_STEP2_RATIO = 1.0f; // step2's lookahead len
 const float OA_BENDYRULER_LOOKAHEAD_STEP2_MIN = 2.0f;   // step2 checks at least this many meters past step1's location
 const float OA_BENDYRULER_LOOKAHEAD_PAST_DEST = 2.0f;   // lookahead length will be at least this many meters past the destination
 const float OA_BENDYRULER_LOW_SPEED_SQUARED = (0.2f * 0.2f);    // when ground course is below this speed squared, vehicle's heading will be used
+const float OA_BENDYRULER_REUSE_DIST_MAX = 0.25f;       // previous update's margins are reused if probe segments have moved less than this many meters
 
 #define VERTICAL_ENABLED APM_BUILD_COPTER_OR_HELI
 
@@ -88,6 +89,10 @@ bool AP_OABendyRuler::update(const Location& current_loc, const Location& destin
     // init bendy_type returned
     bendy_type = OABendyType::OA_BENDY_DISABLED;
 
+    const uint32_t start_us = AP_HAL::micros();
+    _stats.probes_calculated = 0;
+    _stats.probes_reused = 0;
+
     // calculate bearing and distance to final destination
     const float bearing_to_dest = current_loc.get_bearing_to(destination) * 0.01f;
     const float distance_to_dest = current_loc.get_distance(destination);
@@ -114,6 +119,9 @@ bool AP_OABendyRuler::update(const Location& current_loc, const Location& destin
         ground_course_deg = degrees(ground_speed_vec.angle());
     }
 
+    // the snapshot is used by the horizontal search and provides the obstacle count logged for both types
+    update_obstacle_snapshot(current_loc, proximity_only);
+
     bool ret;
     switch (get_type()) {
         case OABendyType::OA_BENDY_VERTICAL:
@@ -129,6 +137,8 @@ bool AP_OABendyRuler::update(const Location& current_loc, const Location& destin
             bendy_type = OABendyType::OA_BENDY_HORIZONTAL;
     }
 
+    Write_OABendyRulerTiming((uint8_t)bendy_type, AP_HAL::micros() - start_us);
+
     return ret;
 }
 
@@ -138,6 +148,8 @@ bool AP_OABendyRuler::search_xy_path(const Location& current_loc, const Location
     // check OA_BEARING_INC definition allows checking in all directions
     static_assert(360 % OA_BENDYRULER_BEARING_INC_XY == 0, "check 360 is a multiple of OA_BEARING_INC");
 
+    static_assert(XY_PROBE_COUNT == 1 + 2 * (170 / OA_BENDYRULER_BEARING_INC_XY), "check XY_PROBE_COUNT matches OA_BEARING_INC");
+
     // search in OA_BENDYRULER_BEARING_INC degree increments around the vehicle alternating left
     // and right. For each direction check if vehicle would avoid all obstacles
     float best_bearing = bearing_to_dest;
@@ -146,6 +158,14 @@ bool AP_OABendyRuler::search_xy_path(const Location& current_loc, const Location
     float best_margin = -FLT_MAX;
     float best_margin_bearing = best_bearing;
 
+    // build the fan of bearings to probe in the order they are tested
+    // probe end points are calculated directly in the snapshot's frame
+    float probe_bearing[XY_PROBE_COUNT];
+    uint8_t probe_index[XY_PROBE_COUNT];
+    Vector3f probe_end_NEU[XY_PROBE_COUNT];
+    float probe_margin[XY_PROBE_COUNT];
+    bool probe_exact[XY_PROBE_COUNT];
+    uint8_t num_probes = 0;
     for (uint8_t i = 0; i <= (170 / OA_BENDYRULER_BEARING_INC_XY); i++) {
         for (uint8_t bdir = 0; bdir <= 1; bdir++) {
             // skip duplicate check of bearing straight towards destination
@@ -155,66 +175,107 @@ bool AP_OABendyRuler::search_xy_path(const Location& current_loc, const Location
             // bearing that we are probing
             const float bearing_delta = i * OA_BENDYRULER_BEARING_INC_XY * (bdir == 0 ? -1.0f : 1.0f);
             const float bearing_test = wrap_180(bearing_to_dest + bearing_delta);
+            const float bearing_rad = radians(bearing_test);
+            probe_bearing[num_probes] = bearing_test;
+            probe_index[num_probes] = i;
+            probe_end_NEU[num_probes] = _snapshot.start_NEU + Vector3f{cosf(bearing_rad), sinf(bearing_rad), 0.0f} * (lookahead_step1_dist * 100.0f);
+            num_probes++;
+        }
+    }
+
+    // the bearing straight towards the destination usually succeeds so it is calculated on its own
+    // the rest of the fan is calculated in a single pass over the obstacles only if required
+    uint8_t num_calculated = 0;
+
+    for (uint8_t p = 0; p < num_probes; p++) {
+        if (p >= num_calculated) {
+            const uint8_t count = (p == 0) ? 1 : (num_probes - p);
+            calc_xy_probe_margins(probe_end_NEU, p, count, probe_margin, probe_exact, proximity_only);
+            num_calculated = p + count;
+        }
 
-            // ToDo: add effective groundspeed calculations using airspeed
-            // ToDo: add prediction of vehicle's position change as part of turn to desired heading
+        const uint8_t i = probe_index[p];
+        const float bearing_test = probe_bearing[p];
+
+        // ToDo: add effective groundspeed calculations using airspeed
+        // ToDo: add prediction of vehicle's position change as part of turn to desired heading
+
+        // a reused margin is a lower bound that only decides pass or fail
+        // the exact margin is calculated before the value is used
+        if (probe_margin[p] > _margin_max) {
+            make_xy_probe_margins_exact(probe_end_NEU, &p, 1, probe_margin, probe_exact, proximity_only);
+
+            // margin from obstacles for this scenario
+            const float margin = probe_margin[p];
+            // this bearing avoids obstacles out to the lookahead_step1_dist
+            // now check in there is a clear path in three directions towards the destination
+            if (!have_best_bearing) {
+                best_bearing = bearing_test;
+                best_bearing_margin = margin;
+                have_best_bearing = true;
+            } else if (fabsf(wrap_180(ground_course_deg - bearing_test)) <
+                       fabsf(wrap_180(ground_course_deg - best_bearing))) {
+                // replace bearing with one that is closer to our current ground course
+                best_bearing = bearing_test;
+                best_bearing_margin = margin;
+            }
 
             // test location is projected from current location at test bearing
             Location test_loc = current_loc;
             test_loc.offset_bearing(bearing_test, lookahead_step1_dist);
 
-            // calculate margin from obstacles for this scenario
-            float margin = calc_avoidance_margin(current_loc, test_loc, proximity_only);
-            if (margin > best_margin) {
-                best_margin_bearing = bearing_test;
-                best_margin = margin;
+            // perform second stage test in three directions looking for obstacles
+            const float test_bearings[] { 0.0f, 45.0f, -45.0f };
+            const float bearing_to_dest2 = test_loc.get_bearing_to(destination) * 0.01f;
+            float distance2 = constrain_float(lookahead_step2_dist, OA_BENDYRULER_LOOKAHEAD_STEP2_MIN, test_loc.get_distance(destination));
+            Vector3f test_end_NEU[ARRAY_SIZE(test_bearings)];
+            float test_margin[ARRAY_SIZE(test_bearings)];
+            for (uint8_t j = 0; j < ARRAY_SIZE(test_bearings); j++) {
+                const float bearing_test2_rad = radians(wrap_180(bearing_to_dest2 + test_bearings[j]));
+                test_end_NEU[j] = probe_end_NEU[p] + Vector3f{cosf(bearing_test2_rad), sinf(bearing_test2_rad), 0.0f} * (distance2 * 100.0f);
             }
-            if (margin > _margin_max) {
-                // this bearing avoids obstacles out to the lookahead_step1_dist
-                // now check in there is a clear path in three directions towards the destination
-                if (!have_best_bearing) {
-                    best_bearing = bearing_test;
-                    best_bearing_margin = margin;
-                    have_best_bearing = true;
-                } else if (fabsf(wrap_180(ground_course_deg - bearing_test)) <
-                           fabsf(wrap_180(ground_course_deg - best_bearing))) {
-                    // replace bearing with one that is closer to our current ground course
-                    best_bearing = bearing_test;
-                    best_bearing_margin = margin;
-                }
 
-                // perform second stage test in three directions looking for obstacles
-                const float test_bearings[] { 0.0f, 45.0f, -45.0f };
-                const float bearing_to_dest2 = test_loc.get_bearing_to(destination) * 0.01f;
-                float distance2 = constrain_float(lookahead_step2_dist, OA_BENDYRULER_LOOKAHEAD_STEP2_MIN, test_loc.get_distance(destination));
-                for (uint8_t j = 0; j < ARRAY_SIZE(test_bearings); j++) {
-                    float bearing_test2 = wrap_180(bearing_to_dest2 + test_bearings[j]);
-                    Location test_loc2 = test_loc;
-                    test_loc2.offset_bearing(bearing_test2, distance2);
-
-                    // calculate minimum margin to fence and obstacles for this scenario
-                    float margin2 = calc_avoidance_margin(test_loc, test_loc2, proximity_only);
-                    if (margin2 > _margin_max) {
-                        // if the chosen direction is directly towards the destination avoidance can be turned off
-                        // i == 0 && j == 0 implies no deviation from bearing to destination 
-                        const bool active = (i != 0 || j != 0);
-                        float final_bearing = bearing_test;
-                        float final_margin = margin;
-                        // check if we need ignore test_bearing and continue on previous bearing
-                        const bool ignore_bearing_change = resist_bearing_change(destination, current_loc, active, bearing_test, lookahead_step1_dist, margin, _destination_prev,_bearing_prev, final_bearing, final_margin, proximity_only);
-
-                        // all good, now project in the chosen direction by the full distance
-                        destination_new = current_loc;
-                        destination_new.offset_bearing(final_bearing, MIN(distance_to_dest, lookahead_step1_dist));
-                        _current_lookahead = MIN(_lookahead, _current_lookahead * 1.1f);
-                        Write_OABendyRuler((uint8_t)OABendyType::OA_BENDY_HORIZONTAL, active, bearing_to_dest, 0.0f, ignore_bearing_change, final_margin, destination, destination_new);
-                        return active;
-                    }
+            // calculate minimum margin to fence and obstacles for all three directions
+            calc_avoidance_margins(probe_end_NEU[p], test_end_NEU, ARRAY_SIZE(test_bearings), test_margin, proximity_only);
+            _stats.probes_calculated += ARRAY_SIZE(test_bearings);
+
+            for (uint8_t j = 0; j < ARRAY_SIZE(test_bearings); j++) {
+                if (test_margin[j] > _margin_max) {
+                    // if the chosen direction is directly towards the destination avoidance can be turned off
+                    // i == 0 && j == 0 implies no deviation from bearing to destination 
+                    const bool active = (i != 0 || j != 0);
+                    float final_bearing = bearing_test;
+                    float final_margin = margin;
+                    // check if we need ignore test_bearing and continue on previous bearing
+                    const bool ignore_bearing_change = resist_bearing_change(destination, current_loc, active, bearing_test, lookahead_step1_dist, margin, _destination_prev,_bearing_prev, final_bearing, final_margin, proximity_only);
+
+                    // all good, now project in the chosen direction by the full distance
+                    destination_new = current_loc;
+                    destination_new.offset_bearing(final_bearing, MIN(distance_to_dest, lookahead_step1_dist));
+                    _current_lookahead = MIN(_lookahead, _current_lookahead * 1.1f);
+                    Write_OABendyRuler((uint8_t)OABendyType::OA_BENDY_HORIZONTAL, active, bearing_to_dest, 0.0f, ignore_bearing_change, final_margin, destination, destination_new);
+                    return active;
                 }
             }
         }
     }
 
+    // none of the probes succeeded so all have been evaluated.  Find the best margin from exact values
+    uint8_t inexact[XY_PROBE_COUNT];
+    uint8_t num_inexact = 0;
+    for (uint8_t p = 0; p < num_probes; p++) {
+        if (!probe_exact[p]) {
+            inexact[num_inexact++] = p;
+        }
+    }
+    make_xy_probe_margins_exact(probe_end_NEU, inexact, num_inexact, probe_margin, probe_exact, proximity_only);
+    for (uint8_t p = 0; p < num_probes; p++) {
+        if (probe_margin[p] > best_margin) {
+            best_margin_bearing = probe_bearing[p];
+            best_margin = probe_margin[p];
+        }
+    }
+
     float chosen_bearing;
     float chosen_distance;
     if (have_best_bearing) {
@@ -452,6 +513,265 @@ float AP_OABendyRuler::calc_avoidance_margin(const Location &start, const Locati
     return margin_min;
 }
 
+// capture the enabled fences and object database state used by all horizontal probes during this update
+void AP_OABendyRuler::update_obstacle_snapshot(const Location &current_loc, bool proximity_only)
+{
+    ObstacleSnapshot &snap = _snapshot;
+    snap = {};
+
+    // vehicle position as offset from EKF origin.  If unavailable only the circular fence can be checked
+    // and the vehicle's position is used as the frame's origin
+    if (current_loc.get_vector_from_origin_NEU(snap.start_NEU)) {
+        snap.origin_NEU_valid = true;
+        snap.origin_NE_valid = true;
+    } else {
+        snap.start_NEU.zero();
+        snap.origin_NE_valid = current_loc.get_vector_xy_from_origin_NE(snap.start_NEU.xy());
+        if (!snap.origin_NE_valid) {
+            snap.start_NEU.zero();
+        }
+    }
+
+    const AP_OADatabase *oaDb = AP::oadatabase();
+    if (oaDb != nullptr && oaDb->healthy() && snap.origin_NEU_valid) {
+        snap.db_count = oaDb->database_count();
+        snap.db_version = oaDb->database_version();
+    }
+
+    if (proximity_only) {
+        return;
+    }
+
+#if AP_FENCE_ENABLED
+    const AC_Fence *fence = AC_Fence::get_singleton();
+    if (fence == nullptr) {
+        return;
+    }
+    const uint8_t enabled_fences = fence->get_enabled_fences();
+    if ((enabled_fences & AC_FENCE_TYPE_CIRCLE) != 0) {
+        snap.circle_fence = true;
+        snap.home_NE_cm = snap.start_NEU.xy() + current_loc.get_distance_NE(AP::ahrs().get_home()) * 100.0f;
+        snap.circle_radius = fence->get_radius() - fence->get_margin();
+    }
+    if (((enabled_fences & AC_FENCE_TYPE_POLYGON) != 0) && snap.origin_NE_valid) {
+        snap.polygon_fence = true;
+        snap.fence_margin = fence->get_margin();
+        snap.fence_load_ms = fence->polyfence().get_inclusion_polygon_update_ms();
+    }
+#endif // AP_FENCE_ENABLED
+}
+
+// returns true if two snapshots describe the same obstacles
+bool AP_OABendyRuler::same_obstacles(const ObstacleSnapshot &a, const ObstacleSnapshot &b)
+{
+    return (a.origin_NE_valid == b.origin_NE_valid) &&
+           (a.origin_NEU_valid == b.origin_NEU_valid) &&
+           (a.circle_fence == b.circle_fence) &&
+           (a.polygon_fence == b.polygon_fence) &&
+           (a.home_NE_cm == b.home_NE_cm) &&
+           is_equal(a.circle_radius, b.circle_radius) &&
+           is_equal(a.fence_margin, b.fence_margin) &&
+           (a.fence_load_ms == b.fence_load_ms) &&
+           (a.db_count == b.db_count) &&
+           (a.db_version == b.db_version);
+}
+
+// calculate minimum distance between any obstacle in the snapshot and num_segments horizontal paths sharing the same start
+// obstacles are the outer loop so each is fetched once and quantities depending only on the start are calculated once
+void AP_OABendyRuler::calc_avoidance_margins(const Vector3f &start_NEU, const Vector3f *end_NEU, uint8_t num_segments, float *margins, bool proximity_only) const
+{
+    for (uint8_t i = 0; i < num_segments; i++) {
+        margins[i] = FLT_MAX;
+    }
+
+    // proximity sensor obstacles
+    if (_snapshot.db_count > 0) {
+        const AP_OADatabase *oaDb = AP::oadatabase();
+        for (uint16_t k = 0; k < _snapshot.db_count; k++) {
+            const AP_OADatabase::OA_DbItem& item = oaDb->get_item(k);
+            const Vector3f point_cm = item.pos * 100.0f;
+            for (uint8_t i = 0; i < num_segments; i++) {
+                if (start_NEU == end_NEU[i]) {
+                    continue;
+                }
+                // margin is distance between line segment and obstacle minus obstacle's radius
+                const float m = Vector3f::closest_distance_between_line_and_point(start_NEU, end_NEU[i], point_cm) * 0.01f - item.radius;
+                margins[i] = MIN(margins[i], m);
+            }
+        }
+    }
+
+    if (proximity_only) {
+        // only need margin from proximity data
+        return;
+    }
+
+    const Vector2f &start_NE = start_NEU.xy();
+
+    // circular fence centered on home.  margin is fence radius minus the longer of start or end distance
+    if (_snapshot.circle_fence) {
+        const float start_dist_sq = (start_NE - _snapshot.home_NE_cm).length_squared();
+        for (uint8_t i = 0; i < num_segments; i++) {
+            const float end_dist_sq = (end_NEU[i].xy() - _snapshot.home_NE_cm).length_squared();
+            const float m = _snapshot.circle_radius - sqrtf(MAX(start_dist_sq, end_dist_sq)) * 0.01f;
+            margins[i] = MIN(margins[i], m);
+        }
+    }
+
+#if AP_FENCE_ENABLED
+    if (!_snapshot.polygon_fence) {
+        return;
+    }
+    const AC_PolyFence_loader &polyfence = AC_Fence::get_singleton()->polyfence();
+    const float fence_margin = _snapshot.fence_margin;
+
+    // inclusion polygons, if outside the fence margin is the closest distance but with negative sign
+    for (uint8_t p = 0; p < polyfence.get_inclusion_polygon_count(); p++) {
+        uint16_t num_points;
+        const Vector2f* boundary = polyfence.get_inclusion_polygon(p, num_points);
+        const float sign = Polygon_outside(start_NE, boundary, num_points) ? -1.0f : 1.0f;
+        for (uint8_t i = 0; i < num_segments; i++) {
+            const float m = (sign * Polygon_closest_distance_line(boundary, num_points, start_NE, end_NEU[i].xy()) * 0.01f) - fence_margin;
+            margins[i] = MIN(margins[i], m);
+        }
+    }
+
+    // exclusion polygons, if start is inside the polygon the margin's sign is reversed
+    for (uint8_t p = 0; p < polyfence.get_exclusion_polygon_count(); p++) {
+        uint16_t num_points;
+        const Vector2f* boundary = polyfence.get_exclusion_polygon(p, num_points);
+        const float sign = Polygon_outside(start_NE, boundary, num_points) ? 1.0f : -1.0f;
+        for (uint8_t i = 0; i < num_segments; i++) {
+            const float m = (sign * Polygon_closest_distance_line(boundary, num_points, start_NE, end_NEU[i].xy()) * 0.01f) - fence_margin;
+            margins[i] = MIN(margins[i], m);
+        }
+    }
+
+    // inclusion circles, margin is fence radius minus the longer of start or end distance
+    for (uint8_t c = 0; c < polyfence.get_inclusion_circle_count(); c++) {
+        Vector2f center_pos_cm;
+        float radius;
+        if (!polyfence.get_inclusion_circle(c, center_pos_cm, radius)) {
+            continue;
+        }
+        const float start_dist_sq = (start_NE - center_pos_cm).length_squared();
+        for (uint8_t i = 0; i < num_segments; i++) {
+            const float end_dist_sq = (end_NEU[i].xy() - center_pos_cm).length_squared();
+            const float m = (radius + fence_margin) - (sqrtf(MAX(start_dist_sq, end_dist_sq)) * 0.01f);
+            margins[i] = MIN(margins[i], m);
+        }
+    }
+
+    // exclusion circles, margin is distance to the center minus the radius
+    for (uint8_t c = 0; c < polyfence.get_exclusion_circle_count(); c++) {
+        Vector2f center_pos_cm;
+        float radius;
+        if (!polyfence.get_exclusion_circle(c, center_pos_cm, radius)) {
+            continue;
+        }
+        for (uint8_t i = 0; i < num_segments; i++) {
+            const float dist_cm = Vector2f::closest_distance_between_line_and_point(start_NE, end_NEU[i].xy(), center_pos_cm);
+            const float m = (dist_cm * 0.01f) - (radius + fence_margin);
+            margins[i] = MIN(margins[i], m);
+        }
+    }
+#endif // AP_FENCE_ENABLED
+}
+
+// calculate margins for step1 probes first to first+count-1
+// margins move by no more than the distance the probe segment's end points move, so if the obstacles are unchanged
+// and the vehicle has barely moved, the previous update's margin less this distance is a safe lower bound.  The
+// lower bound is only used if it leads to the same pass/fail decision against _margin_max as the exact margin would.
+// exact is set false for reused margins, callers must use make_xy_probe_margins_exact before using their value
+void AP_OABendyRuler::calc_xy_probe_margins(const Vector3f *end_NEU, uint8_t first, uint8_t count, float *margins, bool *exact, bool proximity_only)
+{
+    if (first == 0) {
+        // decide whether the previous update's margins can be used or whether to start again
+        const bool cache_ok = (_probe_cache.count > 0) &&
+                              (_probe_cache.proximity_only == proximity_only) &&
+                              same_obstacles(_probe_cache.snapshot, _snapshot) &&
+                              ((_snapshot.start_NEU - _probe_cache.snapshot.start_NEU).length() * 0.01f <= OA_BENDYRULER_REUSE_DIST_MAX);
+        if (!cache_ok) {
+            _probe_cache.snapshot = _snapshot;
+            _probe_cache.proximity_only = proximity_only;
+            _probe_cache.count = 0;
+        }
+        _probe_cache.filling = !cache_ok;
+    }
+
+    // start by trying to reuse margins, collecting the probes that must be calculated
+    const float start_shift = (_snapshot.start_NEU - _probe_cache.snapshot.start_NEU).length() * 0.01f;
+    uint8_t calc_index[XY_PROBE_COUNT];
+    Vector3f calc_end_NEU[XY_PROBE_COUNT];
+    uint8_t num_calc = 0;
+    for (uint8_t p = first; p < first + count; p++) {
+        if (!_probe_cache.filling && (p < _probe_cache.count)) {
+            const float shift = MAX(start_shift, (end_NEU[p] - _probe_cache.end_NEU[p]).length() * 0.01f);
+            const float cached = _probe_cache.margin[p];
+            if ((shift <= OA_BENDYRULER_REUSE_DIST_MAX) &&
+                ((cached - shift > _margin_max) || (cached + shift <= _margin_max))) {
+                margins[p] = cached - shift;
+                exact[p] = false;
+                _stats.probes_reused++;
+                continue;
+            }
+        }
+        calc_index[num_calc] = p;
+        calc_end_NEU[num_calc] = end_NEU[p];
+        num_calc++;
+    }
+
+    if (num_calc == 0) {
+        return;
+    }
+
+    // calculate remaining probes in a single pass over the obstacles
+    float calc_margin[XY_PROBE_COUNT];
+    calc_avoidance_margins(_snapshot.start_NEU, calc_end_NEU, num_calc, calc_margin, proximity_only);
+    _stats.probes_calculated += num_calc;
+
+    for (uint8_t c = 0; c < num_calc; c++) {
+        const uint8_t p = calc_index[c];
+        margins[p] = calc_margin[c];
+        exact[p] = true;
+        // only margins calculated from the cache's start position may be stored, and they must be stored in order
+        if (_probe_cache.filling && (p == _probe_cache.count)) {
+            _probe_cache.end_NEU[p] = end_NEU[p];
+            _probe_cache.margin[p] = calc_margin[c];
+            _probe_cache.count++;
+        }
+    }
+}
+
+// replace the reused margins of the num_probes step1 probes listed in probes with exact margins
+void AP_OABendyRuler::make_xy_probe_margins_exact(const Vector3f *end_NEU, const uint8_t *probes, uint8_t num_probes, float *margins, bool *exact, bool proximity_only)
+{
+    uint8_t calc_index[XY_PROBE_COUNT];
+    Vector3f calc_end_NEU[XY_PROBE_COUNT];
+    uint8_t num_calc = 0;
+    for (uint8_t k = 0; k < num_probes; k++) {
+        const uint8_t p = probes[k];
+        if (!exact[p]) {
+            calc_index[num_calc] = p;
+            calc_end_NEU[num_calc] = end_NEU[p];
+            num_calc++;
+        }
+    }
+    if (num_calc == 0) {
+        return;
+    }
+
+    float calc_margin[XY_PROBE_COUNT];
+    calc_avoidance_margins(_snapshot.start_NEU, calc_end_NEU, num_calc, calc_margin, proximity_only);
+    _stats.probes_calculated += num_calc;
+    _stats.probes_reused -= num_calc;
+
+    for (uint8_t c = 0; c < num_calc; c++) {
+        margins[calc_index[c]] = calc_margin[c];
+        exact[calc_index[c]] = true;
+    }
+}
+
 // calculate minimum distance between a path and the circular fence (centered on home)
 // on success returns true and updates margin
 bool AP_OABendyRuler::calc_margin_from_circular_fence(const Location &start, const Location &end, float &margin) const
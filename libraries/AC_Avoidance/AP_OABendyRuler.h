@@ -42,6 +42,20 @@ private:
     // calculate minimum distance between a path and any obstacle
     float calc_avoidance_margin(const Location &start, const Location &end, bool proximity_only) const;
 
+    // capture the enabled fences and object database state used by all horizontal probes during this update
+    void update_obstacle_snapshot(const Location &current_loc, bool proximity_only);
+
+    // calculate minimum distance between any obstacle in the snapshot and num_segments horizontal paths sharing the same start
+    // start_NEU and end_NEU are offsets in cm in the snapshot's frame, margins are returned in meters
+    void calc_avoidance_margins(const Vector3f &start_NEU, const Vector3f *end_NEU, uint8_t num_segments, float *margins, bool proximity_only) const;
+
+    // calculate margins for step1 probes first to first+count-1, reusing the previous update's results where the vehicle has barely moved
+    // exact[i] is set false for reused margins which are only a lower bound
+    void calc_xy_probe_margins(const Vector3f *end_NEU, uint8_t first, uint8_t count, float *margins, bool *exact, bool proximity_only);
+
+    // replace the reused margins of the listed step1 probes with exact margins
+    void make_xy_probe_margins_exact(const Vector3f *end_NEU, const uint8_t *probes, uint8_t num_probes, float *margins, bool *exact, bool proximity_only);
+
     // determine if BendyRuler should accept the new bearing or try and resist it. Returns true if bearing is not changed  
     bool resist_bearing_change(const Location &destination, const Location &current_loc, bool active, float bearing_test, float lookahead_step1_dist, float margin, Location &prev_dest, float &prev_bearing, float &final_bearing, float &final_margin, bool proximity_only) const;    
 
@@ -65,8 +79,31 @@ private:
     // on success returns true and updates margin
     bool calc_margin_from_object_database(const Location &start, const Location &end, float &margin) const;
 
-    // Logging function
+    // Logging functions
     void Write_OABendyRuler(const uint8_t type, const bool active, const float target_yaw, const float target_pitch, const bool resist_chg, const float margin, const Location &final_dest, const Location &oa_dest) const;
+    void Write_OABendyRulerTiming(const uint8_t type, const uint32_t duration_us) const;
+
+    // number of step1 bearings probed by the horizontal search (see OA_BENDYRULER_BEARING_INC_XY)
+    static const uint8_t XY_PROBE_COUNT = 1 + 2 * (170 / 5);
+
+    // snapshot of obstacles taken once per update.  Positions are offsets in cm from the EKF origin
+    // or, if the origin is unavailable, from the vehicle's position at the time of the snapshot
+    struct ObstacleSnapshot {
+        Vector3f start_NEU;             // vehicle position in cm
+        bool origin_NE_valid;           // true if horizontal offsets are from the EKF origin (required for polygons and circles)
+        bool origin_NEU_valid;          // true if 3D offsets are from the EKF origin (required for object database)
+        bool circle_fence;              // true if the circular fence (centered on home) should be checked
+        bool polygon_fence;             // true if inclusion and exclusion polygons and circles should be checked
+        Vector2f home_NE_cm;            // home position in cm
+        float circle_radius;            // circular fence radius minus fence margin in meters
+        float fence_margin;             // fence margin in meters
+        uint32_t fence_load_ms;         // system time polygon fences were last loaded
+        uint16_t db_count;              // number of object database items to check
+        uint32_t db_version;            // object database version
+    } _snapshot;
+
+    // returns true if two snapshots describe the same obstacles
+    static bool same_obstacles(const ObstacleSnapshot &a, const ObstacleSnapshot &b);
 
     // OA common parameters
     float _margin_max;              // object avoidance will ignore objects more than this many meters from vehicle
@@ -81,4 +118,20 @@ private:
     float _current_lookahead;       // distance (in meters) ahead of the vehicle we are looking for obstacles
     float _bearing_prev;            // stored bearing in degrees 
     Location _destination_prev;     // previous destination, to check if there has been a change in destination
+
+    // step1 probe margins from a previous update, reused while the vehicle and obstacles barely move
+    struct {
+        ObstacleSnapshot snapshot;      // obstacles and vehicle position when the margins were calculated
+        bool proximity_only;            // true if margins were calculated for proximity obstacles only
+        bool filling;                   // true if margins calculated during this update may be added
+        uint8_t count;                  // number of valid entries in end_NEU and margin arrays
+        Vector3f end_NEU[XY_PROBE_COUNT];
+        float margin[XY_PROBE_COUNT];
+    } _probe_cache;
+
+    // per-update statistics for logging
+    struct {
+        uint16_t probes_calculated;     // number of probe margins calculated from the snapshot
+        uint16_t probes_reused;         // number of probe margins reused from _probe_cache
+    } _stats;
 };
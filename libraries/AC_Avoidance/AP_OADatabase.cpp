@@ -280,6 +280,7 @@ void AP_OADatabase::database_item_add(const OA_DbItem &item)
     _database.items[_database.count] = item;
     _database.items[_database.count].send_to_gcs = get_send_to_gcs_flags(_database.items[_database.count].importance);
     _database.count++;
+    _database.version++;
 }
 
 void AP_OADatabase::database_item_remove(const uint16_t index)
@@ -294,6 +295,7 @@ void AP_OADatabase::database_item_remove(const uint16_t index)
     _database.items[index].send_to_gcs = get_send_to_gcs_flags(_database.items[index].importance);
 
     _database.count--;
+    _database.version++;
     if (_database.count == 0) {
         return;
     }
@@ -312,10 +314,15 @@ void AP_OADatabase::database_item_refresh(const uint16_t index, const uint32_t t
         return;
     }
 
+    const bool radius_changed = !is_equal(_database.items[index].radius, radius);
     const bool is_different =
-            (!is_equal(_database.items[index].radius, radius)) ||
+            radius_changed ||
             (timestamp_ms - _database.items[index].timestamp_ms >= 500);
 
+    if (radius_changed) {
+        _database.version++;
+    }
+
     if (is_different) {
         // update timestamp and radius on close object so it stays around longer
         // and trigger resending to GCS
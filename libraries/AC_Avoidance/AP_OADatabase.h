@@ -44,6 +44,9 @@ public:
     // get number of items in the database
     uint16_t database_count() const { return _database.count; }
 
+    // get database version.  This changes whenever an item is added, removed, moved or resized
+    uint32_t database_version() const { return _database.version; }
+
     // empty queue and try and put into database. Return true if there's more work to do
     bool process_queue();
 
@@ -100,6 +103,7 @@ private:
         OA_DbItem       *items;                             // array of objects in the database
         uint16_t        count;                              // number of objects in the items array
         uint16_t        size;                               // cached value of _database_size_param that sticks after initialized
+        uint32_t        version;                            // incremented whenever an item's position or radius changes
     } _database;
 
     uint16_t _next_index_to_send[MAVLINK_COMM_NUM_BUFFERS]; // index of next object in _database to send to GCS
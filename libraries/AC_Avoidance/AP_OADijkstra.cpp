@@ -568,11 +568,19 @@ bool AP_OADijkstra::intersects_fence(const Vector2f &seg_start, const Vector2f &
     }
 
     // determine if segment crosses any of the inclusion polygons
+    // using the faster structure of arrays copies when they are available
     uint16_t num_points = 0;
     for (uint8_t i = 0; i < fence->polyfence().get_inclusion_polygon_count(); i++) {
+        Vector2f intersection;
+        const Polygon_SoAf* boundary_soa = fence->polyfence().get_inclusion_polygon_soa(i);
+        if (boundary_soa != nullptr) {
+            if (Polygon_intersects(*boundary_soa, seg_start, seg_end, intersection)) {
+                return true;
+            }
+            continue;
+        }
         const Vector2f* boundary = fence->polyfence().get_inclusion_polygon(i, num_points);
         if (boundary != nullptr) {
-            Vector2f intersection;
             if (Polygon_intersects(boundary, num_points, seg_start, seg_end, intersection)) {
                 return true;
             }
@@ -581,9 +589,16 @@ bool AP_OADijkstra::intersects_fence(const Vector2f &seg_start, const Vector2f &
 
     // determine if segment crosses any of the exclusion polygons
     for (uint8_t i = 0; i < fence->polyfence().get_exclusion_polygon_count(); i++) {
+        Vector2f intersection;
+        const Polygon_SoAf* boundary_soa = fence->polyfence().get_exclusion_polygon_soa(i);
+        if (boundary_soa != nullptr) {
+            if (Polygon_intersects(*boundary_soa, seg_start, seg_end, intersection)) {
+                return true;
+            }
+            continue;
+        }
         const Vector2f* boundary = fence->polyfence().get_exclusion_polygon(i, num_points);
         if (boundary != nullptr) {
-            Vector2f intersection;
             if (Polygon_intersects(boundary, num_points, seg_start, seg_end, intersection)) {
                 return true;
             }
@@ -4,6 +4,7 @@
 
 #define LOG_IDS_FROM_AVOIDANCE \
     LOG_OA_BENDYRULER_MSG, \
+    LOG_OA_BENDYRULER_TIMING_MSG, \
     LOG_OA_DIJKSTRA_MSG, \
     LOG_SIMPLE_AVOID_MSG, \
     LOG_OD_VISGRAPH_MSG
@@ -42,6 +43,24 @@ struct PACKED log_OABendyRuler {
     int32_t oa_alt;
 };
 
+// @LoggerMessage: OABT
+// @Description: Object avoidance (Bendy Ruler) search timing
+// @Field: TimeUS: Time since system startup
+// @Field: Type: Type of BendyRuler currently active
+// @Field: Dur: Time taken to search for a path
+// @Field: NCalc: Number of path margins calculated from the obstacle snapshot
+// @Field: NReuse: Number of path margins reused from the previous update
+// @Field: NObj: Number of proximity obstacles checked
+struct PACKED log_OABendyRulerTiming {
+    LOG_PACKET_HEADER;
+    uint64_t time_us;
+    uint8_t type;
+    uint32_t duration_us;
+    uint16_t num_calculated;
+    uint16_t num_reused;
+    uint16_t num_objects;
+};
+
 // @LoggerMessage: OADJ
 // @Description: Object avoidance (Dijkstra) diagnostics
 // @Field: TimeUS: Time since system startup
@@ -109,6 +128,8 @@ struct PACKED log_OD_Visgraph {
 #define LOG_STRUCTURE_FROM_AVOIDANCE \
     { LOG_OA_BENDYRULER_MSG, sizeof(log_OABendyRuler), \
       "OABR","QBBHHHBfLLiLLi","TimeUS,Type,Act,DYaw,Yaw,DP,RChg,Mar,DLt,DLg,DAlt,OLt,OLg,OAlt", "s-bddd-mDUmDUm", "F-------GGBGGB" , true }, \
+    { LOG_OA_BENDYRULER_TIMING_MSG, sizeof(log_OABendyRulerTiming), \
+      "OABT","QBIHHH","TimeUS,Type,Dur,NCalc,NReuse,NObj", "s-s---", "F-F---" , true }, \
     { LOG_OA_DIJKSTRA_MSG, sizeof(log_OADijkstra), \
       "OADJ","QBBBBLLLL","TimeUS,State,Err,CurrPoint,TotPoints,DLat,DLng,OALat,OALng", "sbbbbDUDU", "F----GGGG" , true }, \
     { LOG_SIMPLE_AVOID_MSG, sizeof(log_SimpleAvoid), \
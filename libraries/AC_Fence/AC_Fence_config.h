@@ -9,3 +9,25 @@
 #ifndef AP_FENCE_ENABLED
 #define AP_FENCE_ENABLED 2
 #endif
+
+// keep structure of arrays copies of the loaded polygons for the
+// fast polygon tests. This costs 16 bytes of RAM per polygon vertex
+#ifndef AC_POLYFENCE_SOA_ENABLED
+#define AC_POLYFENCE_SOA_ENABLED (HAL_MEM_CLASS >= HAL_MEM_CLASS_1000)
+#endif
+
+// precompute polygon edge data and a grid used to speed up polygon
+// fence breach checks when the fence is loaded. This costs 12 bytes
+// of RAM per polygon vertex plus one byte per grid cell
+#ifndef AC_POLYFENCE_GRID_ENABLED
+#define AC_POLYFENCE_GRID_ENABLED AC_POLYFENCE_SOA_ENABLED
+#endif
+
+#if AC_POLYFENCE_GRID_ENABLED && !AC_POLYFENCE_SOA_ENABLED
+#error "AC_POLYFENCE_GRID_ENABLED requires AC_POLYFENCE_SOA_ENABLED"
+#endif
+
+// number of cells along each side of the breach check grid
+#ifndef AC_POLYFENCE_GRID_SIZE
+#define AC_POLYFENCE_GRID_SIZE 32
+#endif
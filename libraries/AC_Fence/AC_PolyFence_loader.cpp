@@ -189,6 +189,158 @@ bool AC_PolyFence_loader::read_latlon_from_storage(uint16_t &read_offset, Vector
     return true;
 }
 
+// returns true if pos (lat/lng) is outside any inclusion polygon or
+// inside any exclusion polygon
+bool AC_PolyFence_loader::polygons_breached(const Vector2l &pos) const
+{
+    // check we are inside each inclusion zone:
+    for (uint8_t i=0; i<_num_loaded_inclusion_boundaries; i++) {
+        const InclusionBoundary &boundary = _loaded_inclusion_boundary[i];
+        _stats.polygon_tests++;
+#if AC_POLYFENCE_SOA_ENABLED
+        if (Polygon_outside(pos, boundary.soa_lla)) {
+#else
+        if (Polygon_outside(pos, boundary.points_lla, boundary.count)) {
+#endif
+            return true;
+        }
+    }
+
+    // check we are outside each exclusion zone:
+    for (uint8_t i=0; i<_num_loaded_exclusion_boundaries; i++) {
+        const ExclusionBoundary &boundary = _loaded_exclusion_boundary[i];
+        _stats.polygon_tests++;
+#if AC_POLYFENCE_SOA_ENABLED
+        if (!Polygon_outside(pos, boundary.soa_lla)) {
+#else
+        if (!Polygon_outside(pos, boundary.points_lla, boundary.count)) {
+#endif
+            return true;
+        }
+    }
+
+    return false;
+}
+
+#if AC_POLYFENCE_GRID_ENABLED
+AC_PolyFence_loader::GridCell AC_PolyFence_loader::grid_cell(const Vector2l &pos) const
+{
+    if (_grid.cells == nullptr) {
+        return GridCell::CHECK;
+    }
+    const int64_t dlat = int64_t(pos.x) - _grid.origin.x;
+    const int64_t dlng = int64_t(pos.y) - _grid.origin.y;
+    if (dlat < 0 || dlng < 0) {
+        // outside all polygons
+        return _num_loaded_inclusion_boundaries > 0 ? GridCell::BREACHED : GridCell::CLEAR;
+    }
+    const int64_t row = dlat / _grid.cell_lat;
+    const int64_t col = dlng / _grid.cell_lng;
+    if (row >= AC_POLYFENCE_GRID_SIZE || col >= AC_POLYFENCE_GRID_SIZE) {
+        return _num_loaded_inclusion_boundaries > 0 ? GridCell::BREACHED : GridCell::CLEAR;
+    }
+    return _grid.cells[row * AC_POLYFENCE_GRID_SIZE + col];
+}
+
+/*
+  build the breach check grid. Cells are first marked CHECK where the
+  (slightly expanded) bounding box of any polygon edge touches them.
+  Every other cell lies wholly inside or outside each polygon, and two
+  such cells sharing a side must have the same breach state, so most
+  cells copy their neighbour's state and only the first cell of each
+  connected region needs an actual breach test at its centre
+ */
+void AC_PolyFence_loader::build_grid()
+{
+    delete[] _grid.cells;
+    _grid.cells = nullptr;
+
+    const uint16_t num_polygons = _num_loaded_inclusion_boundaries + _num_loaded_exclusion_boundaries;
+    if (num_polygons == 0) {
+        return;
+    }
+
+    // find the bounding box of all polygons
+    Vector2l bb_min;
+    Vector2l bb_max;
+    for (uint16_t p=0; p<num_polygons; p++) {
+        const Polygon_SoAl &soa = (p < _num_loaded_inclusion_boundaries) ?
+            _loaded_inclusion_boundary[p].soa_lla :
+            _loaded_exclusion_boundary[p - _num_loaded_inclusion_boundaries].soa_lla;
+        if (p == 0) {
+            bb_min = soa.bb_min;
+            bb_max = soa.bb_max;
+        } else {
+            bb_min.x = MIN(bb_min.x, soa.bb_min.x);
+            bb_min.y = MIN(bb_min.y, soa.bb_min.y);
+            bb_max.x = MAX(bb_max.x, soa.bb_max.x);
+            bb_max.y = MAX(bb_max.y, soa.bb_max.y);
+        }
+    }
+
+    const uint16_t num_cells = AC_POLYFENCE_GRID_SIZE * AC_POLYFENCE_GRID_SIZE;
+    _grid.cells = new GridCell[num_cells];
+    if (_grid.cells == nullptr) {
+        return;
+    }
+    _grid.origin = bb_min;
+    _grid.cell_lat = uint32_t((int64_t(bb_max.x) - bb_min.x) / AC_POLYFENCE_GRID_SIZE + 1);
+    _grid.cell_lng = uint32_t((int64_t(bb_max.y) - bb_min.y) / AC_POLYFENCE_GRID_SIZE + 1);
+    for (uint16_t i=0; i<num_cells; i++) {
+        _grid.cells[i] = GridCell::CLEAR;
+    }
+
+    // mark cells which edges pass through
+    for (uint16_t p=0; p<num_polygons; p++) {
+        const Polygon_SoAl &soa = (p < _num_loaded_inclusion_boundaries) ?
+            _loaded_inclusion_boundary[p].soa_lla :
+            _loaded_exclusion_boundary[p - _num_loaded_inclusion_boundaries].soa_lla;
+        for (uint16_t i=0; i<soa.n; i++) {
+            const uint16_t j = (i+1 < soa.n) ? i+1 : 0;
+            const int64_t lat_min = int64_t(MIN(soa.x[i], soa.x[j])) - 1 - _grid.origin.x;
+            const int64_t lat_max = int64_t(MAX(soa.x[i], soa.x[j])) + 1 - _grid.origin.x;
+            const int64_t lng_min = int64_t(MIN(soa.y[i], soa.y[j])) - 1 - _grid.origin.y;
+            const int64_t lng_max = int64_t(MAX(soa.y[i], soa.y[j])) + 1 - _grid.origin.y;
+            const int32_t row_min = constrain_int32(MAX(lat_min, 0) / _grid.cell_lat, 0, AC_POLYFENCE_GRID_SIZE-1);
+            const int32_t row_max = constrain_int32(lat_max / _grid.cell_lat, 0, AC_POLYFENCE_GRID_SIZE-1);
+            const int32_t col_min = constrain_int32(MAX(lng_min, 0) / _grid.cell_lng, 0, AC_POLYFENCE_GRID_SIZE-1);
+            const int32_t col_max = constrain_int32(lng_max / _grid.cell_lng, 0, AC_POLYFENCE_GRID_SIZE-1);
+            for (int32_t row=row_min; row<=row_max; row++) {
+                for (int32_t col=col_min; col<=col_max; col++) {
+                    _grid.cells[row * AC_POLYFENCE_GRID_SIZE + col] = GridCell::CHECK;
+                }
+            }
+        }
+    }
+
+    // classify the remaining cells
+    uint16_t breach_tests = 0;
+    for (uint16_t row=0; row<AC_POLYFENCE_GRID_SIZE; row++) {
+        for (uint16_t col=0; col<AC_POLYFENCE_GRID_SIZE; col++) {
+            GridCell &cell = _grid.cells[row * AC_POLYFENCE_GRID_SIZE + col];
+            if (cell == GridCell::CHECK) {
+                continue;
+            }
+            if (col > 0 && _grid.cells[row * AC_POLYFENCE_GRID_SIZE + col - 1] != GridCell::CHECK) {
+                cell = _grid.cells[row * AC_POLYFENCE_GRID_SIZE + col - 1];
+                continue;
+            }
+            if (row > 0 && _grid.cells[(row - 1) * AC_POLYFENCE_GRID_SIZE + col] != GridCell::CHECK) {
+                cell = _grid.cells[(row - 1) * AC_POLYFENCE_GRID_SIZE + col];
+                continue;
+            }
+            const Vector2l centre {
+                int32_t(_grid.origin.x + int64_t(_grid.cell_lat) * row + _grid.cell_lat / 2),
+                int32_t(_grid.origin.y + int64_t(_grid.cell_lng) * col + _grid.cell_lng / 2)
+            };
+            cell = polygons_breached(centre) ? GridCell::BREACHED : GridCell::CLEAR;
+            breach_tests++;
+        }
+    }
+    Debug("Fence: grid built with %u breach tests", (unsigned)breach_tests);
+}
+#endif // AC_POLYFENCE_GRID_ENABLED
+
 // load boundary point from eeprom, returns true on successful load
 // only used for converting from old storage to new storage
 bool AC_PolyFence_loader::load_point_from_eeprom(uint16_t i, Vector2l& point) const
@@ -226,21 +378,26 @@ bool AC_PolyFence_loader::breached(const Location& loc) const
     pos.x = loc.lat;
     pos.y = loc.lng;
 
-    // check we are inside each inclusion zone:
-    for (uint8_t i=0; i<_num_loaded_inclusion_boundaries; i++) {
-        const InclusionBoundary &boundary = _loaded_inclusion_boundary[i];
-        if (Polygon_outside(pos, boundary.points_lla, boundary.count)) {
+    _stats.checks++;
+#if AC_POLYFENCE_GRID_ENABLED
+    switch (grid_cell(pos)) {
+    case GridCell::CLEAR:
+        _stats.grid_resolved++;
+        break;
+    case GridCell::BREACHED:
+        _stats.grid_resolved++;
+        return true;
+    case GridCell::CHECK:
+        if (polygons_breached(pos)) {
             return true;
         }
+        break;
     }
-
-    // check we are outside each exclusion zone:
-    for (uint8_t i=0; i<_num_loaded_exclusion_boundaries; i++) {
-        const ExclusionBoundary &boundary = _loaded_exclusion_boundary[i];
-        if (!Polygon_outside(pos, boundary.points_lla, boundary.count)) {
-            return true;
-        }
+#else
+    if (polygons_breached(pos)) {
+        return true;
     }
+#endif
 
     for (uint8_t i=0; i<_num_loaded_circle_exclusion_boundaries; i++) {
         const ExclusionCircle &circle = _loaded_circle_exclusion_boundary[i];
@@ -578,6 +735,22 @@ void AC_PolyFence_loader::unload()
     delete[] _loaded_points_lla;
     _loaded_points_lla = nullptr;
 
+#if AC_POLYFENCE_SOA_ENABLED
+    delete[] _loaded_soa;
+    _loaded_soa = nullptr;
+
+    delete[] _loaded_soa_lla;
+    _loaded_soa_lla = nullptr;
+#endif
+
+#if AC_POLYFENCE_GRID_ENABLED
+    delete[] _loaded_edges;
+    _loaded_edges = nullptr;
+
+    delete[] _grid.cells;
+    _grid.cells = nullptr;
+#endif
+
     delete[] _loaded_inclusion_boundary;
     _loaded_inclusion_boundary = nullptr;
     _num_loaded_inclusion_boundaries = 0;
@@ -680,6 +853,23 @@ bool AC_PolyFence_loader::load_from_eeprom()
             get_loaded_fence_semaphore().give();
             return false;
         }
+#if AC_POLYFENCE_SOA_ENABLED
+        _loaded_soa = new float[2*count];
+        _loaded_soa_lla = new int32_t[2*count];
+        if (_loaded_soa == nullptr || _loaded_soa_lla == nullptr) {
+            unload();
+            get_loaded_fence_semaphore().give();
+            return false;
+        }
+#endif
+#if AC_POLYFENCE_GRID_ENABLED
+        _loaded_edges = new float[3*count];
+        if (_loaded_edges == nullptr) {
+            unload();
+            get_loaded_fence_semaphore().give();
+            return false;
+        }
+#endif
     }
 
     // FIXME: find some way of factoring out all of these allocation routines.
@@ -736,6 +926,13 @@ bool AC_PolyFence_loader::load_from_eeprom()
 
     Vector2f *next_storage_point = _loaded_offsets_from_origin;
     Vector2l *next_storage_point_lla = _loaded_points_lla;
+#if AC_POLYFENCE_SOA_ENABLED
+    float *next_soa = _loaded_soa;
+    int32_t *next_soa_lla = _loaded_soa_lla;
+#endif
+#if AC_POLYFENCE_GRID_ENABLED
+    float *next_edges = _loaded_edges;
+#endif
 
     // use index to load fences from eeprom
     bool storage_valid = true;
@@ -770,6 +967,18 @@ bool AC_PolyFence_loader::load_from_eeprom()
                 storage_valid = false;
                 break;
             }
+#if AC_POLYFENCE_SOA_ENABLED
+            if (!init_boundary_soa(boundary.points, boundary.points_lla, boundary.count,
+                                   boundary.soa, boundary.soa_lla,
+                                   next_soa, next_soa_lla)) {
+                gcs().send_text(MAV_SEVERITY_WARNING, "AC_Fence: invalid polygon");
+                storage_valid = false;
+                break;
+            }
+#endif
+#if AC_POLYFENCE_GRID_ENABLED
+            init_boundary_edges(boundary.soa, boundary.edges, next_edges);
+#endif
             _num_loaded_inclusion_boundaries++;
             break;
         }
@@ -789,6 +998,18 @@ bool AC_PolyFence_loader::load_from_eeprom()
                 storage_valid = false;
                 break;
             }
+#if AC_POLYFENCE_SOA_ENABLED
+            if (!init_boundary_soa(boundary.points, boundary.points_lla, boundary.count,
+                                   boundary.soa, boundary.soa_lla,
+                                   next_soa, next_soa_lla)) {
+                gcs().send_text(MAV_SEVERITY_WARNING, "AC_Fence: invalid polygon");
+                storage_valid = false;
+                break;
+            }
+#endif
+#if AC_POLYFENCE_GRID_ENABLED
+            init_boundary_edges(boundary.soa, boundary.edges, next_edges);
+#endif
             _num_loaded_exclusion_boundaries++;
             break;
         }
@@ -882,12 +1103,140 @@ bool AC_PolyFence_loader::load_from_eeprom()
         return false;
     }
 
+#if AC_POLYFENCE_GRID_ENABLED
+    build_grid();
+#endif
+
     _load_time_ms = AP_HAL::millis();
 
     get_loaded_fence_semaphore().give();
     return true;
 }
 
+#if AC_POLYFENCE_SOA_ENABLED
+bool AC_PolyFence_loader::init_boundary_soa(const Vector2f *points, const Vector2l *points_lla, uint8_t count,
+                                            Polygon_SoAf &soa, Polygon_SoAl &soa_lla,
+                                            float *&next_soa, int32_t *&next_soa_lla)
+{
+    if (!Polygon_SoA_init(soa, points, count, next_soa, &next_soa[count])) {
+        return false;
+    }
+    if (!Polygon_SoA_init(soa_lla, points_lla, count, next_soa_lla, &next_soa_lla[count])) {
+        return false;
+    }
+
+    next_soa += 2*count;
+    next_soa_lla += 2*count;
+    return true;
+}
+
+/*
+  distance from pos_cm to the bounding box of a polygon, which is a
+  lower bound on the distance to its edges. Zero inside the box
+ */
+float AC_PolyFence_loader::polygon_box_distance(const Polygon_SoAf &soa, const Vector2f &pos_cm) const
+{
+    _stats.distance_queries++;
+
+    const float box_dx = MAX(MAX(soa.bb_min.x - pos_cm.x, pos_cm.x - soa.bb_max.x), 0.0f);
+    const float box_dy = MAX(MAX(soa.bb_min.y - pos_cm.y, pos_cm.y - soa.bb_max.y), 0.0f);
+    return norm(box_dx, box_dy);
+}
+#endif // AC_POLYFENCE_SOA_ENABLED
+
+#if AC_POLYFENCE_GRID_ENABLED
+void AC_PolyFence_loader::init_boundary_edges(const Polygon_SoAf &soa, PolygonEdges &edges, float *&next_edges)
+{
+    float *normal_x = next_edges;
+    float *normal_y = &next_edges[soa.n];
+    float *length = &next_edges[2*soa.n];
+    for (uint16_t i=0; i<soa.n; i++) {
+        const uint16_t j = (i+1 < soa.n) ? i+1 : 0;
+        const Vector2f edge {soa.x[j] - soa.x[i], soa.y[j] - soa.y[i]};
+        length[i] = edge.length();
+        if (is_positive(length[i])) {
+            normal_x[i] = -edge.y / length[i];
+            normal_y[i] = edge.x / length[i];
+        } else {
+            // repeated vertex; this normal makes the distance
+            // calculation return the distance to the vertex
+            normal_x[i] = 1.0f;
+            normal_y[i] = 0.0f;
+            length[i] = 0.0f;
+        }
+    }
+    edges.normal_x = normal_x;
+    edges.normal_y = normal_y;
+    edges.length = length;
+
+    next_edges += 3*soa.n;
+}
+
+/*
+  exact distance from pos_cm to the closest edge of a polygon,
+  calculated from the edge normals without any division or square
+  root per edge
+ */
+float AC_PolyFence_loader::polygon_edge_distance(const Polygon_SoAf &soa, const PolygonEdges &edges, const Vector2f &pos_cm) const
+{
+    float dist_sq = FLT_MAX;
+    for (uint16_t i=0; i<soa.n; i++) {
+        const float vx = pos_cm.x - soa.x[i];
+        const float vy = pos_cm.y - soa.y[i];
+        // distance from the line through the edge, and position along it
+        const float across = vx * edges.normal_x[i] + vy * edges.normal_y[i];
+        const float along = vx * edges.normal_y[i] - vy * edges.normal_x[i];
+        const float beyond = MAX(MAX(-along, along - edges.length[i]), 0.0f);
+        dist_sq = MIN(dist_sq, sq(across) + sq(beyond));
+    }
+    return sqrtf(dist_sq);
+}
+#endif // AC_POLYFENCE_GRID_ENABLED
+
+/*
+  lower bound on the distance from pos_cm to the edges of a polygon.
+  Outside the bounding box the distance to the box is returned,
+  otherwise the exact distance to the closest edge if edge data is
+  kept, or zero. Always zero without the structure of arrays copies
+ */
+float AC_PolyFence_loader::get_exclusion_polygon_boundary_distance(uint16_t index, const Vector2f &pos_cm) const
+{
+    if (index >= _num_loaded_exclusion_boundaries) {
+        return FLT_MAX;
+    }
+#if AC_POLYFENCE_SOA_ENABLED
+    const ExclusionBoundary &boundary = _loaded_exclusion_boundary[index];
+    const float box_dist = polygon_box_distance(boundary.soa, pos_cm);
+#if AC_POLYFENCE_GRID_ENABLED
+    if (!is_positive(box_dist)) {
+        return polygon_edge_distance(boundary.soa, boundary.edges, pos_cm);
+    }
+#endif
+    return box_dist;
+#else
+    return 0.0f;
+#endif
+}
+
+float AC_PolyFence_loader::get_inclusion_polygon_boundary_distance(uint16_t index, const Vector2f &pos_cm) const
+{
+    if (index >= _num_loaded_inclusion_boundaries) {
+        return FLT_MAX;
+    }
+#if AC_POLYFENCE_SOA_ENABLED
+    const InclusionBoundary &boundary = _loaded_inclusion_boundary[index];
+    const float box_dist = polygon_box_distance(boundary.soa, pos_cm);
+#if AC_POLYFENCE_GRID_ENABLED
+    if (!is_positive(box_dist)) {
+        return polygon_edge_distance(boundary.soa, boundary.edges, pos_cm);
+    }
+#endif
+    return box_dist;
+#else
+    return 0.0f;
+#endif
+}
+
 /// returns pointer to array of exclusion polygon points and num_points is filled in with the number of points in the polygon
 /// points are offsets in cm from EKF origin in NE frame
 Vector2f* AC_PolyFence_loader::get_exclusion_polygon(uint16_t index, uint16_t &num_points) const
@@ -916,6 +1265,30 @@ Vector2f* AC_PolyFence_loader::get_inclusion_polygon(uint16_t index, uint16_t &n
     return boundary.points;
 }
 
+const Polygon_SoAf* AC_PolyFence_loader::get_exclusion_polygon_soa(uint16_t index) const
+{
+#if AC_POLYFENCE_SOA_ENABLED
+    if (index >= _num_loaded_exclusion_boundaries) {
+        return nullptr;
+    }
+    return &_loaded_exclusion_boundary[index].soa;
+#else
+    return nullptr;
+#endif
+}
+
+const Polygon_SoAf* AC_PolyFence_loader::get_inclusion_polygon_soa(uint16_t index) const
+{
+#if AC_POLYFENCE_SOA_ENABLED
+    if (index >= _num_loaded_inclusion_boundaries) {
+        return nullptr;
+    }
+    return &_loaded_inclusion_boundary[index].soa;
+#else
+    return nullptr;
+#endif
+}
+
 /// returns the specified exclusion circle
 /// circle center offsets in cm from EKF origin in NE frame, radius is in meters
 bool AC_PolyFence_loader::get_exclusion_circle(uint8_t index, Vector2f &center_pos_cm, float &radius) const
@@ -1675,6 +2048,47 @@ void AC_PolyFence_loader::update()
     if (!load_from_eeprom()) {
         return;
     }
+
+    log_stats();
+}
+
+// log breach check statistics once a second
+void AC_PolyFence_loader::log_stats()
+{
+#if HAL_LOGGER_FENCE_ENABLED
+    const uint32_t now_ms = AP_HAL::millis();
+    if (now_ms - _stats.last_log_ms < 1000) {
+        return;
+    }
+    _stats.last_log_ms = now_ms;
+    if (_stats.checks == 0 && _stats.distance_queries == 0) {
+        return;
+    }
+
+    uint16_t check_cells = 0;
+#if AC_POLYFENCE_GRID_ENABLED
+    if (_grid.cells != nullptr) {
+        for (uint16_t i=0; i<AC_POLYFENCE_GRID_SIZE*AC_POLYFENCE_GRID_SIZE; i++) {
+            if (_grid.cells[i] == GridCell::CHECK) {
+                check_cells++;
+            }
+        }
+    }
+#endif
+
+    // counters may be incremented by other threads while logging,
+    // so read and clear each in one operation
+    const struct log_FenceStats pkt{
+        LOG_PACKET_HEADER_INIT(LOG_FENCE_STATS_MSG),
+        time_us          : AP_HAL::micros64(),
+        checks           : _stats.checks.exchange(0),
+        grid_resolved    : _stats.grid_resolved.exchange(0),
+        polygon_tests    : _stats.polygon_tests.exchange(0),
+        distance_queries : _stats.distance_queries.exchange(0),
+        check_cells      : check_cells,
+    };
+    AP::logger().WriteBlock(&pkt, sizeof(pkt));
+#endif
 }
 
 #else  // build type is not appropriate; provide a dummy implementation:
@@ -1685,6 +2099,10 @@ bool AC_PolyFence_loader::get_item(const uint16_t seq, AC_PolyFenceItem &item) {
 
 Vector2f* AC_PolyFence_loader::get_exclusion_polygon(uint16_t index, uint16_t &num_points) const { return nullptr; }
 Vector2f* AC_PolyFence_loader::get_inclusion_polygon(uint16_t index, uint16_t &num_points) const { return nullptr; }
+const Polygon_SoAf* AC_PolyFence_loader::get_exclusion_polygon_soa(uint16_t index) const { return nullptr; }
+const Polygon_SoAf* AC_PolyFence_loader::get_inclusion_polygon_soa(uint16_t index) const { return nullptr; }
+float AC_PolyFence_loader::get_exclusion_polygon_boundary_distance(uint16_t index, const Vector2f &pos_cm) const { return FLT_MAX; }
+float AC_PolyFence_loader::get_inclusion_polygon_boundary_distance(uint16_t index, const Vector2f &pos_cm) const { return FLT_MAX; }
 
 bool AC_PolyFence_loader::get_exclusion_circle(uint8_t index, Vector2f &center_pos_cm, float &radius) const { return false; }
 bool AC_PolyFence_loader::get_inclusion_circle(uint8_t index, Vector2f &center_pos_cm, float &radius) const { return false; }
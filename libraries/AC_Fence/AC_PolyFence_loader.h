@@ -35,6 +35,8 @@ public:
 
 #if AP_FENCE_ENABLED
 
+#include <atomic>
+
 #include <AP_Common/AP_Common.h>
 #include <AP_Common/Location.h>
 #include <GCS_MAVLink/GCS_MAVLink.h>
@@ -71,6 +73,16 @@ public:
     /// points are offsets in cm from EKF origin in NE frame
     Vector2f* get_exclusion_polygon(uint16_t index, uint16_t &num_points) const;
 
+    /// returns the exclusion polygon as a structure of arrays with its
+    /// bounding box, or nullptr if index is out of range or the
+    /// structure of arrays copies are not kept (AC_POLYFENCE_SOA_ENABLED)
+    const Polygon_SoAf* get_exclusion_polygon_soa(uint16_t index) const;
+
+    /// returns a lower bound on the distance in cm from pos_cm (offset
+    /// from EKF origin in NE frame) to the edges of the exclusion
+    /// polygon, or FLT_MAX if index is out of range
+    float get_exclusion_polygon_boundary_distance(uint16_t index, const Vector2f &pos_cm) const;
+
     /// return system time of last update to the exclusion polygon points
     uint32_t get_exclusion_polygon_update_ms() const {
         return _load_time_ms;
@@ -88,6 +100,16 @@ public:
     /// points are offsets in cm from EKF origin in NE frame
     Vector2f* get_inclusion_polygon(uint16_t index, uint16_t &num_points) const;
 
+    /// returns the inclusion polygon as a structure of arrays with its
+    /// bounding box, or nullptr if index is out of range or the
+    /// structure of arrays copies are not kept (AC_POLYFENCE_SOA_ENABLED)
+    const Polygon_SoAf* get_inclusion_polygon_soa(uint16_t index) const;
+
+    /// returns a lower bound on the distance in cm from pos_cm (offset
+    /// from EKF origin in NE frame) to the edges of the inclusion
+    /// polygon, or FLT_MAX if index is out of range
+    float get_inclusion_polygon_boundary_distance(uint16_t index, const Vector2f &pos_cm) const;
+
     /// return system time of last update to the inclusion polygon points
     uint32_t get_inclusion_polygon_update_ms() const {
         return _load_time_ms;
@@ -280,11 +302,31 @@ private:
     // can be found:
     Vector2l *_loaded_return_point_lla;
 
+#if AC_POLYFENCE_GRID_ENABLED
+    // edge data precomputed when the fence is loaded, as separate
+    // arrays indexed like the polygon's soa points. Edge k runs from
+    // vertex k to vertex k+1 (wrapping); normal is its unit left hand
+    // normal and length its length in cm
+    class PolygonEdges {
+    public:
+        const float *normal_x;
+        const float *normal_y;
+        const float *length;
+    };
+#endif
+
     class InclusionBoundary {
     public:
         Vector2f *points; // pointer into the _loaded_offsets_from_origin array
         Vector2l *points_lla; // pointer into the _loaded_points_lla array
         uint8_t count; // count of points in the boundary
+#if AC_POLYFENCE_SOA_ENABLED
+        Polygon_SoAf soa; // points, as arrays in _loaded_soa
+        Polygon_SoAl soa_lla; // points_lla, as arrays in _loaded_soa_lla
+#endif
+#if AC_POLYFENCE_GRID_ENABLED
+        PolygonEdges edges; // edges of soa, in _loaded_edges
+#endif
     };
     InclusionBoundary *_loaded_inclusion_boundary;
 
@@ -295,6 +337,13 @@ private:
         Vector2f *points; // pointer into the _loaded_offsets_from_origin array
         Vector2l *points_lla; // pointer into the _loaded_points_lla_lla array
         uint8_t count; // count of points in the boundary
+#if AC_POLYFENCE_SOA_ENABLED
+        Polygon_SoAf soa; // points, as arrays in _loaded_soa
+        Polygon_SoAl soa_lla; // points_lla, as arrays in _loaded_soa_lla
+#endif
+#if AC_POLYFENCE_GRID_ENABLED
+        PolygonEdges edges; // edges of soa, in _loaded_edges
+#endif
     };
     ExclusionBoundary *_loaded_exclusion_boundary;
 
@@ -307,6 +356,74 @@ private:
     Vector2f *_loaded_offsets_from_origin;
     Vector2l *_loaded_points_lla;
 
+#if AC_POLYFENCE_SOA_ENABLED
+    // _loaded_soa and _loaded_soa_lla hold the polygon boundary
+    // points again as separate x and y arrays for the fast polygon
+    // tests. Each boundary uses 2*count consecutive elements.
+    float *_loaded_soa;
+    int32_t *_loaded_soa_lla;
+
+    // fill in the structure of arrays copies of a just-loaded
+    // boundary, advancing next_soa and next_soa_lla past the storage
+    // used
+    bool init_boundary_soa(const Vector2f *points, const Vector2l *points_lla, uint8_t count,
+                           Polygon_SoAf &soa, Polygon_SoAl &soa_lla,
+                           float *&next_soa, int32_t *&next_soa_lla) WARN_IF_UNUSED;
+
+    // distance from pos_cm to the bounding box of a polygon
+    float polygon_box_distance(const Polygon_SoAf &soa, const Vector2f &pos_cm) const;
+#endif // AC_POLYFENCE_SOA_ENABLED
+
+    // returns true if pos (lat/lng) is outside any inclusion polygon
+    // or inside any exclusion polygon
+    bool polygons_breached(const Vector2l &pos) const;
+
+#if AC_POLYFENCE_GRID_ENABLED
+    // 3*count elements per boundary of PolygonEdges data
+    float *_loaded_edges;
+
+    // fill in the edge data of a just-loaded boundary, advancing
+    // next_edges past the storage used
+    void init_boundary_edges(const Polygon_SoAf &soa, PolygonEdges &edges, float *&next_edges);
+
+    // exact distance from pos_cm to the edges of a polygon
+    float polygon_edge_distance(const Polygon_SoAf &soa, const PolygonEdges &edges, const Vector2f &pos_cm) const;
+
+    // coarse grid over the bounding box of all loaded polygons in
+    // lat/lng. Cells that no polygon edge passes through are entirely
+    // inside or outside each polygon, so breach checks in them need
+    // no polygon tests at all
+    enum class GridCell : uint8_t {
+        CLEAR    = 0, // not breached anywhere in the cell
+        BREACHED = 1, // breached everywhere in the cell
+        CHECK    = 2, // crossed by an edge, polygons must be tested
+    };
+    struct {
+        GridCell *cells;    // AC_POLYFENCE_GRID_SIZE^2 cells, row per latitude band
+        Vector2l origin;    // lat/lng of the lowest corner
+        uint32_t cell_lat;  // cell size in latitude
+        uint32_t cell_lng;  // cell size in longitude
+    } _grid;
+
+    // build _grid from the loaded polygons. Failure to allocate the
+    // grid is not an error; breach checks then always test polygons
+    void build_grid();
+
+    // return the grid classification of lat/lng position pos
+    GridCell grid_cell(const Vector2l &pos) const;
+#endif // AC_POLYFENCE_GRID_ENABLED
+
+    // statistics on breach checks, logged once a second.  Checks may
+    // be made from more than one thread so the counters are atomic
+    mutable struct {
+        std::atomic<uint32_t> checks;            // polygon breach checks
+        std::atomic<uint32_t> grid_resolved;     // checks resolved by the grid alone
+        std::atomic<uint32_t> polygon_tests;     // point in polygon tests
+        std::atomic<uint32_t> distance_queries;  // polygon boundary distance queries
+        uint32_t last_log_ms;
+    } _stats;
+    void log_stats();
+
     class ExclusionCircle {
     public:
         Vector2f pos_cm; // vector offset from home in cm
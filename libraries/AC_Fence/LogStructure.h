@@ -4,7 +4,8 @@
 #include "AC_Fence_config.h"
 
 #define LOG_IDS_FROM_FENCE \
-    LOG_FENCE_MSG
+    LOG_FENCE_MSG, \
+    LOG_FENCE_STATS_MSG
 
 // @LoggerMessage: FNCE
 // @Description: currently loaded Geo Fence points
@@ -29,10 +30,31 @@ struct PACKED log_Fence {
     float radius;
 };
 
+// @LoggerMessage: FNCS
+// @Description: polygon fence check statistics, written once a second while checks are being made
+// @Field: TimeUS: Time since system startup
+// @Field: NChk: number of polygon fence breach checks
+// @Field: NGrid: number of breach checks resolved by the grid alone
+// @Field: NPoly: number of point in polygon tests
+// @Field: NDist: number of polygon boundary distance queries
+// @Field: NCell: number of grid cells crossed by polygon edges
+
+struct PACKED log_FenceStats {
+    LOG_PACKET_HEADER;
+    uint64_t time_us;
+    uint32_t checks;
+    uint32_t grid_resolved;
+    uint32_t polygon_tests;
+    uint32_t distance_queries;
+    uint16_t check_cells;
+};
+
 #if !AP_FENCE_ENABLED
 #define LOG_STRUCTURE_FROM_FENCE
 #else
 #define LOG_STRUCTURE_FROM_FENCE \
     { LOG_FENCE_MSG, sizeof(log_Fence), \
-      "FNCE", "QBBBLLBf", "TimeUS,Tot,Seq,Type,Lat,Lng,Count,Radius", "s---DU-m", "F---GG--" },
+      "FNCE", "QBBBLLBf", "TimeUS,Tot,Seq,Type,Lat,Lng,Count,Radius", "s---DU-m", "F---GG--" }, \
+    { LOG_FENCE_STATS_MSG, sizeof(log_FenceStats), \
+      "FNCS", "QIIIIH", "TimeUS,NChk,NGrid,NPoly,NDist,NCell", "s-----", "F-----" },
 #endif
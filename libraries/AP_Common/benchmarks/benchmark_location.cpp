@@ -0,0 +1,81 @@
+#include <AP_gbenchmark.h>
+
+#include <AP_Common/Location.h>
+#include <AP_Math/AP_Math.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+/*
+  Location maths uses ftype, so the precision under test follows the
+  --ekf-single / --ekf-double configure choice
+ */
+static const char *ftype_label = sizeof(ftype) == 8 ? "double" : "float";
+
+static const Location loc1{-353632620, 1491652373, 58400, Location::AltFrame::ABSOLUTE};
+static const Location loc2{-353610000, 1491700000, 60000, Location::AltFrame::ABSOLUTE};
+
+static void BM_LocationGetDistance(benchmark::State& state)
+{
+    state.SetLabel(ftype_label);
+    Location loc = loc1;
+
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&loc);
+        ftype dist = loc.get_distance(loc2);
+        gbenchmark_escape(&dist);
+    }
+}
+
+static void BM_LocationGetDistanceNE(benchmark::State& state)
+{
+    state.SetLabel(ftype_label);
+    Location loc = loc1;
+
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&loc);
+        Vector2F dist = loc.get_distance_NE_ftype(loc2);
+        gbenchmark_escape(&dist);
+    }
+}
+
+static void BM_LocationGetBearing(benchmark::State& state)
+{
+    state.SetLabel(ftype_label);
+    Location loc = loc1;
+
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&loc);
+        ftype bearing = loc.get_bearing(loc2);
+        gbenchmark_escape(&bearing);
+    }
+}
+
+static void BM_LocationOffset(benchmark::State& state)
+{
+    state.SetLabel(ftype_label);
+    Location loc = loc1;
+
+    while (state.KeepRunning()) {
+        loc.offset(1.5, -2.5);
+        gbenchmark_escape(&loc);
+    }
+}
+
+static void BM_LocationOffsetBearing(benchmark::State& state)
+{
+    state.SetLabel(ftype_label);
+    Location loc = loc1;
+
+    while (state.KeepRunning()) {
+        loc.offset_bearing(45.0, 3.0);
+        gbenchmark_escape(&loc);
+    }
+}
+
+BENCHMARK(BM_LocationGetDistance);
+BENCHMARK(BM_LocationGetDistanceNE);
+BENCHMARK(BM_LocationGetBearing);
+BENCHMARK(BM_LocationOffset);
+BENCHMARK(BM_LocationOffsetBearing);
+
+BENCHMARK_MAIN();
@@ -18,6 +18,11 @@ AP_DAL *AP_DAL::_singleton = nullptr;
 
 bool AP_DAL::force_write;
 bool AP_DAL::logging_started;
+AP_DAL_DeltaBases AP_DAL::_delta_bases;
+#if AP_DAL_WRITE_STATS_ENABLED
+AP_DAL::write_stats AP_DAL::_write_stats[LOG_RDLT_MSG - LOG_RFRH_MSG];
+uint32_t AP_DAL::_last_write_stats_ms;
+#endif
 
 void AP_DAL::start_frame(AP_DAL::FrameType frametype)
 {
@@ -40,6 +45,7 @@ void AP_DAL::start_frame(AP_DAL::FrameType frametype)
     bool logging = AP::logger().logging_started() && AP::logger().allow_start_ekf();
     if (logging && !logging_started) {
         force_write = true;
+        _delta_bases.clear();
     }
     logging_started = logging;
 
@@ -99,6 +105,10 @@ void AP_DAL::start_frame(AP_DAL::FrameType frametype)
     _millis = _RFRH.time_us / 1000UL;
 
     force_write = false;
+
+#if AP_DAL_WRITE_STATS_ENABLED
+    Log_Write_Stats();
+#endif
 #endif
 }
 
@@ -270,6 +280,27 @@ uint8_t AP_DAL::logging_core(uint8_t c) const
 #endif
 }
 
+/*
+  messages with one copy per sensor end in the sensor instance, which
+  Replay uses to find the copy a delta applies to
+ */
+static bool has_instance(enum LogMessages msg_type)
+{
+    switch (msg_type) {
+    case LOG_RISI_MSG:
+    case LOG_RASI_MSG:
+    case LOG_RBRI_MSG:
+    case LOG_RRNI_MSG:
+    case LOG_RGPI_MSG:
+    case LOG_RGPJ_MSG:
+    case LOG_RMGI_MSG:
+    case LOG_RBCI_MSG:
+        return true;
+    default:
+        return false;
+    }
+}
+
 // write out a DAL log message. If old_msg is non-null, then
 // only write if the content has changed
 void AP_DAL::WriteLogMessage(enum LogMessages msg_type, void *msg, const void *old_msg, uint8_t msg_size)
@@ -284,7 +315,28 @@ void AP_DAL::WriteLogMessage(enum LogMessages msg_type, void *msg, const void *o
         // no change, skip this block write
         return;
     }
-    if (!AP::logger().WriteReplayBlock(msg_type, msg, msg_size)) {
+    bool ok;
+    log_RDLT delta;
+    if (old_msg && !force_write && _end == 0 &&
+        AP::logger().log_replay() == 2 &&
+        make_delta(msg_type, (const uint8_t *)msg, (const uint8_t *)old_msg, msg_size, delta) &&
+        _delta_bases.written(msg_type, delta.instance)) {
+        // a full copy has been written since logging started and
+        // the previous write of this message succeeded, so Replay
+        // has old_msg to apply the delta to
+        ok = AP::logger().WriteReplayBlock(LOG_RDLT_MSG, &delta, offsetof(log_RDLT, _end));
+#if AP_DAL_WRITE_STATS_ENABLED
+        update_write_stats(msg_type, offsetof(log_RDLT, _end), msg_size - offsetof(log_RDLT, _end));
+#endif
+    } else {
+        ok = AP::logger().WriteReplayBlock(msg_type, msg, msg_size);
+        const uint8_t instance = has_instance(msg_type) ? ((const uint8_t *)msg)[msg_size-1] : 0;
+        _delta_bases.set_written(msg_type, instance, ok);
+#if AP_DAL_WRITE_STATS_ENABLED
+        update_write_stats(msg_type, msg_size, 0);
+#endif
+    }
+    if (!ok) {
         // mark for forced write next time
         _end = 1;
     } else {
@@ -292,6 +344,81 @@ void AP_DAL::WriteLogMessage(enum LogMessages msg_type, void *msg, const void *o
     }
 }
 
+bool AP_DAL::make_delta(enum LogMessages msg_type, const uint8_t *msg, const uint8_t *old_msg, uint8_t msg_size, log_RDLT &delta)
+{
+    if (msg_size <= offsetof(log_RDLT, _end) || msg_size > 32*4) {
+        // too small to gain from a delta, or too large for the mask
+        return false;
+    }
+    delta = {};
+    uint8_t count = 0;
+    for (uint8_t ofs=0; ofs<msg_size; ofs+=4) {
+        const uint8_t len = MIN(4, msg_size - ofs);
+        if (memcmp(&msg[ofs], &old_msg[ofs], len) == 0) {
+            continue;
+        }
+        if (count == RDLT_MAX_WORDS) {
+            return false;
+        }
+        memcpy(&delta.data[count++], &msg[ofs], len);
+        delta.mask |= 1UL<<(ofs/4);
+    }
+    delta.id = msg_type;
+    delta.instance = has_instance(msg_type) ? msg[msg_size-1] : 0;
+    return true;
+}
+
+#if AP_DAL_WRITE_STATS_ENABLED
+void AP_DAL::update_write_stats(enum LogMessages msg_type, uint16_t bytes, uint16_t saved)
+{
+    if (msg_type < LOG_RFRH_MSG || msg_type >= LOG_RDLT_MSG) {
+        return;
+    }
+    write_stats &st = _write_stats[msg_type - LOG_RFRH_MSG];
+    st.count++;
+    // include the message header
+    st.bytes += bytes + 3;
+    st.saved += saved;
+}
+
+/*
+  log the replay logging bandwidth of each message type every 10
+  seconds
+ */
+void AP_DAL::Log_Write_Stats(void)
+{
+    const uint32_t now_ms = AP_HAL::millis();
+    if (now_ms - _last_write_stats_ms < 10000) {
+        return;
+    }
+    _last_write_stats_ms = now_ms;
+    if (!logging_started) {
+        return;
+    }
+    for (uint8_t i=0; i<ARRAY_SIZE(_write_stats); i++) {
+        write_stats &st = _write_stats[i];
+        if (st.count == 0) {
+            continue;
+        }
+// @LoggerMessage: DALS
+// @Description: Replay logging bandwidth of one DAL message type over the last 10 seconds
+// @Field: TimeUS: Time since system startup
+// @Field: Id: message type
+// @Field: N: number of messages written, including deltas
+// @Field: Bytes: bytes written
+// @Field: Saved: bytes saved by writing deltas
+        AP::logger().Write("DALS", "TimeUS,Id,N,Bytes,Saved",
+                           "s--bb", "F----", "QBIII",
+                           AP_HAL::micros64(),
+                           uint8_t(LOG_RFRH_MSG + i),
+                           st.count,
+                           st.bytes,
+                           st.saved);
+        st = {};
+    }
+}
+#endif // AP_DAL_WRITE_STATS_ENABLED
+
 /*
   check if we are low on CPU for this core. This needs to capture the
   timing of running the cores
@@ -8,6 +8,7 @@
 #include "AP_DAL_Airspeed.h"
 #include "AP_DAL_Beacon.h"
 #include "AP_DAL_VisualOdom.h"
+#include "AP_DAL_DeltaBases.h"
 
 #include "LogStructure.h"
 
@@ -18,6 +19,10 @@
 
 #define DAL_CORE(c) AP::dal().logging_core(c)
 
+#ifndef AP_DAL_WRITE_STATS_ENABLED
+#define AP_DAL_WRITE_STATS_ENABLED (HAL_MEM_CLASS >= HAL_MEM_CLASS_300)
+#endif
+
 class NavEKF2;
 class NavEKF3;
 
@@ -316,13 +321,32 @@ public:
     uint8_t logging_core(uint8_t c) const;
 
     // write out a DAL log message. If old_msg is non-null, then
-    // only write if the content has changed
+    // only write if the content has changed, and with LOG_REPLAY=2
+    // write only the changed words where that is smaller
     static void WriteLogMessage(enum LogMessages msg_type, void *msg, const void *old_msg, uint8_t msg_size);
 
+    // fill in delta with the words of msg that differ from
+    // old_msg. Returns false if writing the delta would not be
+    // smaller than writing msg
+    static bool make_delta(enum LogMessages msg_type, const uint8_t *msg, const uint8_t *old_msg, uint8_t msg_size, log_RDLT &delta);
+
 private:
 
     static AP_DAL *_singleton;
 
+#if AP_DAL_WRITE_STATS_ENABLED
+    // bytes written for each DAL message type since last logged
+    struct write_stats {
+        uint32_t count;     // messages written, including deltas
+        uint32_t bytes;     // bytes written
+        uint32_t saved;     // bytes saved by writing deltas
+    };
+    static write_stats _write_stats[LOG_RDLT_MSG - LOG_RFRH_MSG];
+    static uint32_t _last_write_stats_ms;
+    static void update_write_stats(enum LogMessages msg_type, uint16_t bytes, uint16_t saved);
+    void Log_Write_Stats(void);
+#endif
+
     // framing structures
     struct log_RFRH _RFRH;
     struct log_RFRF _RFRF;
@@ -356,6 +380,7 @@ private:
 
     static bool logging_started;
     static bool force_write;
+    static AP_DAL_DeltaBases _delta_bases;
 
     bool ekf2_init_done;
     bool ekf3_init_done;
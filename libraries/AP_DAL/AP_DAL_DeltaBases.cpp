@@ -0,0 +1,24 @@
+#include "AP_DAL_DeltaBases.h"
+
+bool AP_DAL_DeltaBases::get_index(enum LogMessages msg_type, uint8_t instance, uint16_t &idx)
+{
+    if (msg_type < LOG_RFRH_MSG || msg_type >= LOG_RDLT_MSG || instance >= max_instances) {
+        return false;
+    }
+    idx = (msg_type - LOG_RFRH_MSG) * max_instances + instance;
+    return true;
+}
+
+bool AP_DAL_DeltaBases::written(enum LogMessages msg_type, uint8_t instance) const
+{
+    uint16_t idx;
+    return get_index(msg_type, instance, idx) && _written.get(idx);
+}
+
+void AP_DAL_DeltaBases::set_written(enum LogMessages msg_type, uint8_t instance, bool written)
+{
+    uint16_t idx;
+    if (get_index(msg_type, instance, idx)) {
+        _written.setonoff(idx, written);
+    }
+}
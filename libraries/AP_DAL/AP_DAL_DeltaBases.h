@@ -0,0 +1,34 @@
+#pragma once
+
+#include <AP_Common/Bitmask.h>
+#include <AP_Logger/LogStructure.h>
+
+/*
+  track which replay messages have been written in full since logging
+  started. Replay can only apply a RDLT delta to a message it already
+  has a full copy of, so a delta may only follow a full write
+ */
+class AP_DAL_DeltaBases {
+public:
+
+    // highest message instance a delta can be written for, matching
+    // the number of copies Replay keeps
+    static const uint8_t max_instances = 16;
+
+    // forget all messages, for the start of a new log
+    void clear(void) {
+        _written.clearall();
+    }
+
+    // true if a full copy of the message has been written
+    bool written(enum LogMessages msg_type, uint8_t instance) const;
+
+    // record whether a full copy of the message was written
+    void set_written(enum LogMessages msg_type, uint8_t instance, bool written);
+
+private:
+
+    static bool get_index(enum LogMessages msg_type, uint8_t instance, uint16_t &idx);
+
+    Bitmask<(LOG_RDLT_MSG - LOG_RFRH_MSG) * max_instances> _written;
+};
@@ -37,7 +37,8 @@
     LOG_REPH_MSG, \
     LOG_REVH_MSG, \
     LOG_RWOH_MSG, \
-    LOG_RBOH_MSG
+    LOG_RBOH_MSG, \
+    LOG_RDLT_MSG
 
 // Replay Data Structures
 struct log_RFRH {
@@ -357,6 +358,19 @@ struct log_RBOH {
     uint8_t _end;
 };
 
+// number of changed words a RDLT message can carry
+#define RDLT_MAX_WORDS 6
+
+// @LoggerMessage: RDLT
+// @Description: Replay Data delta, the 4 byte words of a replay message which have changed since that message was last written, used when LOG_REPLAY is 2
+struct log_RDLT {
+    uint32_t mask;                  // bit n set if word n of the message is in data
+    uint32_t data[RDLT_MAX_WORDS];  // changed words, in order
+    uint8_t id;                     // type of the message being updated
+    uint8_t instance;               // sensor instance of the message, zero if not per-instance
+    uint8_t _end;
+};
+
 #define RLOG_SIZE(sname) 3+offsetof(struct log_ ##sname,_end)
 
 #define LOG_STRUCTURE_FROM_DAL        \
@@ -421,4 +435,6 @@ struct log_RBOH {
     { LOG_RWOH_MSG, RLOG_SIZE(RWOH),                                   \
       "RWOH", "ffIffff", "DA,DT,TS,PX,PY,PZ,R", "-------", "-------" }, \
     { LOG_RBOH_MSG, RLOG_SIZE(RBOH),                                   \
-      "RBOH", "ffffffffIfffH", "Q,DPX,DPY,DPZ,DAX,DAY,DAZ,DT,TS,OX,OY,OZ,D", "-------------", "-------------" },
+      "RBOH", "ffffffffIfffH", "Q,DPX,DPY,DPZ,DAX,DAY,DAZ,DT,TS,OX,OY,OZ,D", "-------------", "-------------" }, \
+    { LOG_RDLT_MSG, RLOG_SIZE(RDLT),                                   \
+      "RDLT", "IIIIIIIBB", "Mask,D0,D1,D2,D3,D4,D5,Id,Inst", "---------", "---------" },
@@ -0,0 +1,192 @@
+#include <AP_gtest.h>
+
+/*
+  tests for the RDLT delta encoding of replay messages, checking that
+  a log reader can rebuild every message written, including the first
+  messages after logging starts
+ */
+
+#include <AP_DAL/AP_DAL.h>
+#include <string.h>
+
+const AP_HAL::HAL &hal = AP_HAL::get_HAL();
+
+static const uint8_t num_types = LOG_RDLT_MSG - LOG_RFRH_MSG;
+static const uint8_t max_size = 128;
+
+/*
+  the message copies kept by Replay, starting empty for each log
+ */
+class TestReader {
+public:
+    void new_log(void) {
+        memset(have_base, 0, sizeof(have_base));
+    }
+
+    void full(enum LogMessages msg_type, uint8_t instance, const uint8_t *msg, uint8_t size) {
+        memcpy(base[msg_type - LOG_RFRH_MSG][instance], msg, size);
+        have_base[msg_type - LOG_RFRH_MSG][instance] = true;
+        processed = base[msg_type - LOG_RFRH_MSG][instance];
+    }
+
+    void delta(const log_RDLT &d, uint8_t size) {
+        if (!have_base[d.id - LOG_RFRH_MSG][d.instance]) {
+            num_dropped++;
+            processed = nullptr;
+            return;
+        }
+        uint8_t *msg = base[d.id - LOG_RFRH_MSG][d.instance];
+        uint8_t count = 0;
+        for (uint8_t ofs=0; ofs<size && count<RDLT_MAX_WORDS; ofs+=4) {
+            if ((d.mask & (1UL<<(ofs/4))) == 0) {
+                continue;
+            }
+            memcpy(&msg[ofs], &d.data[count++], MIN(4, size - ofs));
+        }
+        processed = msg;
+    }
+
+    // the message most recently passed to the EKF
+    const uint8_t *processed;
+    uint32_t num_dropped;
+
+private:
+    uint8_t base[num_types][AP_DAL_DeltaBases::max_instances][max_size];
+    bool have_base[num_types][AP_DAL_DeltaBases::max_instances];
+};
+
+/*
+  writes messages the way AP_DAL::WriteLogMessage does with
+  LOG_REPLAY=2, passing what reaches the log to the reader
+ */
+class TestWriter {
+public:
+    TestWriter(TestReader &_reader) : reader(_reader) {}
+
+    void start_logging(void) {
+        logging = true;
+        bases.clear();
+        reader.new_log();
+    }
+
+    void stop_logging(void) {
+        logging = false;
+    }
+
+    // returns true if the reader was given msg
+    bool write(enum LogMessages msg_type, uint8_t instance, uint8_t *msg, const uint8_t *old_msg, uint8_t size, bool force, bool write_ok) {
+        if (!logging) {
+            return false;
+        }
+        uint8_t &_end = msg[size];
+        if (!force && _end == 0 && memcmp(msg, old_msg, size) == 0) {
+            return false;
+        }
+        log_RDLT d;
+        if (!force && _end == 0 &&
+            AP_DAL::make_delta(msg_type, msg, old_msg, size, d) &&
+            bases.written(msg_type, d.instance)) {
+            num_deltas++;
+            if (write_ok) {
+                reader.delta(d, size);
+            }
+        } else {
+            if (write_ok) {
+                reader.full(msg_type, instance, msg, size);
+            }
+            bases.set_written(msg_type, instance, write_ok);
+        }
+        _end = write_ok ? 0 : 1;
+        return write_ok;
+    }
+
+    uint32_t num_deltas;
+
+private:
+    TestReader &reader;
+    AP_DAL_DeltaBases bases;
+    bool logging;
+};
+
+static TestReader reader;
+
+static uint32_t rand_seed = 1;
+static uint32_t rand_next(void)
+{
+    rand_seed = rand_seed * 1664525U + 1013904223U;
+    return rand_seed >> 8;
+}
+
+// change a few bytes of a message, leaving the instance alone
+static void mutate(uint8_t *msg, uint8_t size, bool has_instance)
+{
+    const uint8_t nchange = 1 + rand_next() % 3;
+    const uint8_t nbytes = has_instance ? size-1 : size;
+    for (uint8_t i=0; i<nchange; i++) {
+        msg[rand_next() % nbytes] = rand_next();
+    }
+}
+
+// a push-based message first written part way through a frame after
+// logging starts must be written in full
+TEST(AP_DAL_ReplayDelta, log_start)
+{
+    TestWriter writer(reader);
+    const uint8_t size = offsetof(log_ROFH, _end);
+    log_ROFH msg {};
+    for (uint8_t log=0; log<3; log++) {
+        // messages before logging starts are not written, but
+        // are the old copy the first logged message is compared to
+        for (uint8_t i=0; i<10; i++) {
+            const log_ROFH old = msg;
+            mutate((uint8_t *)&msg, size, false);
+            EXPECT_FALSE(writer.write(LOG_ROFH_MSG, 0, (uint8_t *)&msg, (const uint8_t *)&old, size, false, true));
+        }
+        writer.start_logging();
+        for (uint8_t i=0; i<50; i++) {
+            const log_ROFH old = msg;
+            mutate((uint8_t *)&msg, size, false);
+            if (writer.write(LOG_ROFH_MSG, 0, (uint8_t *)&msg, (const uint8_t *)&old, size, false, true)) {
+                ASSERT_NE(reader.processed, nullptr);
+                EXPECT_EQ(memcmp(reader.processed, &msg, size), 0);
+            }
+        }
+        writer.stop_logging();
+    }
+    EXPECT_EQ(reader.num_dropped, 0U);
+    EXPECT_GT(writer.num_deltas, 0U);
+}
+
+// per-instance messages, with failed writes and forced frames
+TEST(AP_DAL_ReplayDelta, instances)
+{
+    TestWriter writer(reader);
+    const uint8_t size = offsetof(log_RMGI, _end);
+    const uint8_t num_instances = 3;
+    log_RMGI msg[num_instances] {};
+    for (uint8_t i=0; i<num_instances; i++) {
+        msg[i].instance = i;
+    }
+    for (uint16_t n=0; n<2000; n++) {
+        if (n % 500 == 0) {
+            writer.stop_logging();
+            writer.start_logging();
+        }
+        const bool force = n % 500 == 1;
+        // an instance that only appears once logging has started
+        const uint8_t instances = n % 500 < 200 ? num_instances-1 : num_instances;
+        for (uint8_t i=0; i<instances; i++) {
+            const log_RMGI old = msg[i];
+            mutate((uint8_t *)&msg[i], size, true);
+            const bool write_ok = rand_next() % 10 != 0;
+            if (writer.write(LOG_RMGI_MSG, i, (uint8_t *)&msg[i], (const uint8_t *)&old, size, force, write_ok)) {
+                ASSERT_NE(reader.processed, nullptr);
+                EXPECT_EQ(memcmp(reader.processed, &msg[i], size), 0) << int(n) << " " << int(i);
+            }
+        }
+    }
+    EXPECT_EQ(reader.num_dropped, 0U);
+    EXPECT_GT(writer.num_deltas, 0U);
+}
+
+AP_GTEST_MAIN()
@@ -27,6 +27,7 @@
 #include <ctype.h>
 
 #define PACKED_NAME "param.pck"
+#define HASH_NAME "param.hsh"
 
 extern const AP_HAL::HAL& hal;
 extern int errno;
@@ -38,6 +39,11 @@ int AP_Filesystem_Param::open(const char *fname, int flags, bool allow_absolute_
         return -1;
     }
     bool read_only = ((flags & O_ACCMODE) == O_RDONLY);
+    const bool hash_file = is_hash_file(fname);
+    if (hash_file && !read_only) {
+        errno = EROFS;
+        return -1;
+    }
     uint8_t idx;
     for (idx=0; idx<max_open_file; idx++) {
         if (!file[idx].open) {
@@ -49,7 +55,8 @@ int AP_Filesystem_Param::open(const char *fname, int flags, bool allow_absolute_
         return -1;
     }
     struct rfile &r = file[idx];
-    if (read_only) {
+    r.cursors = nullptr;
+    if (read_only && !hash_file) {
         r.cursors = new cursor[num_cursors];
         if (r.cursors == nullptr) {
             errno = ENOMEM;
@@ -63,7 +70,10 @@ int AP_Filesystem_Param::open(const char *fname, int flags, bool allow_absolute_
     r.count = 0;
     r.read_size = 0;
     r.file_size = 0;
+    r.block_size = default_hash_block_size;
     r.writebuf = nullptr;
+    r.hashbuf = nullptr;
+    r.hashbuf_len = 0;
     if (!read_only) {
         // setup for upload
         r.writebuf = new ExpandingString();
@@ -100,6 +110,16 @@ int AP_Filesystem_Param::open(const char *fname, int flags, bool allow_absolute_
             c = strchr(c, '&');
             continue;
         }
+        if (strncmp(c, "blocksize=", 10) == 0) {
+            uint32_t v = strtoul(c+10, nullptr, 10);
+            if (v == 0 || v >= UINT16_MAX) {
+                goto failed;
+            }
+            r.block_size = v;
+            c += 10;
+            c = strchr(c, '&');
+            continue;
+        }
 #if AP_PARAM_DEFAULTS_ENABLED
         if (strncmp(c, "withdefaults=", 13) == 0) {
             uint32_t v = strtoul(c+13, nullptr, 10);
@@ -114,6 +134,12 @@ int AP_Filesystem_Param::open(const char *fname, int flags, bool allow_absolute_
 #endif
     }
 
+    if (hash_file && !build_hashes(r)) {
+        close(idx);
+        errno = ENOMEM;
+        return -1;
+    }
+
     return idx;
 
 failed:
@@ -140,9 +166,35 @@ int AP_Filesystem_Param::close(int fd)
     r.cursors = nullptr;
     delete r.writebuf;
     r.writebuf = nullptr;
+    delete [] r.hashbuf;
+    r.hashbuf = nullptr;
     return ret;
 }
 
+/*
+  build the contents of the hash file. The hashes are computed once
+  when the file is opened so that all reads see the same snapshot
+ */
+bool AP_Filesystem_Param::build_hashes(struct rfile &r)
+{
+    const uint16_t total_params = AP_Param::count_parameters();
+    const uint16_t num_blocks = (total_params + r.block_size - 1) / r.block_size;
+    const uint32_t len = sizeof(struct hash_header) + num_blocks * sizeof(uint32_t);
+    r.hashbuf = new uint8_t[len];
+    if (r.hashbuf == nullptr) {
+        return false;
+    }
+    uint32_t *block_hashes = (uint32_t *)&r.hashbuf[sizeof(struct hash_header)];
+    struct hash_header hdr;
+    hdr.total_params = total_params;
+    hdr.block_size = r.block_size;
+    hdr.num_blocks = num_blocks;
+    hdr.hash = AP_Param::hash_parameters(block_hashes, num_blocks, r.block_size);
+    memcpy(r.hashbuf, &hdr, sizeof(hdr));
+    r.hashbuf_len = len;
+    return true;
+}
+
 /*
   packed format:
     file header:
@@ -324,6 +376,15 @@ int32_t AP_Filesystem_Param::read(int fd, void *buf, uint32_t count)
         errno = EINVAL;
         return -1;
     }
+    if (r.hashbuf != nullptr) {
+        if (r.file_ofs >= r.hashbuf_len) {
+            return 0;
+        }
+        count = MIN(count, r.hashbuf_len - r.file_ofs);
+        memcpy(buf, &r.hashbuf[r.file_ofs], count);
+        r.file_ofs += count;
+        return count;
+    }
     size_t header_total = 0;
 
     /*
@@ -469,6 +530,12 @@ int AP_Filesystem_Param::stat(const char *name, struct stat *stbuf)
         return -1;
     }
     memset(stbuf, 0, sizeof(*stbuf));
+    if (is_hash_file(name)) {
+        // size with the default block size
+        const uint16_t num_blocks = (AP_Param::count_parameters() + default_hash_block_size - 1) / default_hash_block_size;
+        stbuf->st_size = sizeof(struct hash_header) + num_blocks * sizeof(uint32_t);
+        return 0;
+    }
     // give size estimation to avoid needing to scan entire file
     stbuf->st_size = AP_Param::count_parameters() * 12;
     return 0;
@@ -484,7 +551,17 @@ bool AP_Filesystem_Param::check_file_name(const char *name)
         (name[packed_len] == 0 || name[packed_len] == '?')) {
         return true;
     }
-    return false;
+    return is_hash_file(name);
+}
+
+/*
+  check for the hash file name
+ */
+bool AP_Filesystem_Param::is_hash_file(const char *name) const
+{
+    const uint8_t hash_len = strlen(HASH_NAME);
+    return strncmp(name, HASH_NAME, hash_len) == 0 &&
+        (name[hash_len] == 0 || name[hash_len] == '?');
 }
 
 /*
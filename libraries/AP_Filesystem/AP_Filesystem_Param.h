@@ -50,6 +50,12 @@ private:
     static constexpr uint16_t pmagic = 0x671b;
     static constexpr uint16_t pmagic_with_default = 0x671c;
 
+    // magic for the parameter hash file
+    static constexpr uint16_t hmagic = 0x671d;
+
+    // default number of parameters covered by each block hash
+    static constexpr uint16_t default_hash_block_size = 32;
+
     // header at front of the file
     struct header {
         uint16_t magic = pmagic;
@@ -57,6 +63,16 @@ private:
         uint16_t total_params; // for upload this is total file length
     };
 
+    // header at front of the hash file, followed by num_blocks
+    // uint32_t block hashes
+    struct PACKED hash_header {
+        uint16_t magic = hmagic;
+        uint16_t total_params;
+        uint16_t block_size;
+        uint16_t num_blocks;
+        uint32_t hash;
+    };
+
     struct cursor {
         AP_Param::ParamToken token;
         uint32_t token_ofs;
@@ -72,15 +88,22 @@ private:
         uint16_t read_size;
         uint16_t start;
         uint16_t count;
+        uint16_t block_size;
         uint32_t file_ofs;
         uint32_t file_size;
         struct cursor *cursors;
         ExpandingString *writebuf; // for upload
+        uint8_t *hashbuf; // contents of the hash file
+        uint32_t hashbuf_len;
     } file[max_open_file];
 
     bool token_seek(const struct rfile &r, const uint32_t data_ofs, struct cursor &c);
     uint8_t pack_param(const struct rfile &r, struct cursor &c, uint8_t *buf);
     bool check_file_name(const char *fname);
+    bool is_hash_file(const char *fname) const;
+
+    // fill in the hash file for an open file
+    bool build_hashes(struct rfile &r);
 
     // finish uploading parameters
     bool finish_upload(const rfile &r);
@@ -37,6 +37,7 @@
 #include "AP_GPS_MSP.h"
 #include "AP_GPS_ExternalAHRS.h"
 #include "GPS_Backend.h"
+#include "RTCM3_Parser.h"
 #if HAL_SIM_GPS_ENABLED
 #include "AP_GPS_SITL.h"
 #endif
@@ -311,7 +312,7 @@ const AP_Param::GroupInfo AP_GPS::var_info[] = {
     // @Param: _DRV_OPTIONS
     // @DisplayName: driver options
     // @Description: Additional backend specific options
-    // @Bitmask: 0:Use UART2 for moving baseline on ublox,1:Use base station for GPS yaw on SBF,2:Use baudrate 115200,3:Use dedicated CAN port b/w GPSes for moving baseline,4:Use ellipsoid height instead of AMSL for uBlox driver
+    // @Bitmask: 0:Use UART2 for moving baseline on ublox,1:Use base station for GPS yaw on SBF,2:Use baudrate 115200,3:Use dedicated CAN port b/w GPSes for moving baseline,4:Use ellipsoid height instead of AMSL for uBlox driver,5:Only inject complete RTCMv3 frames
     // @User: Advanced
     AP_GROUPINFO("_DRV_OPTIONS", 22, AP_GPS, _driver_options, 0),
 
@@ -1084,6 +1085,12 @@ void AP_GPS::update(void)
 #endif  // HAL_LOGING_ENABLED
 #endif  // GPS_MAX_RECEIVERS > 1
 
+#if AP_GPS_RTCM_INJECT_FRAMES_ENABLED
+    if (rtcm_inject != nullptr) {
+        Write_RTCM_Inject();
+    }
+#endif
+
 #ifndef HAL_BUILD_AP_PERIPH
     // update notify with gps status. We always base this on the primary_instance
     AP_Notify::flags.gps_status = state[primary_instance].status;
@@ -1117,8 +1124,19 @@ void AP_GPS::update_primary(void)
     }
 
     if (_output_is_blended) {
-        // Use the weighting to calculate blended GPS states
-        calc_blended_state();
+        // Use the weighting to calculate blended GPS states as soon
+        // as any receiver has new data. Nothing blended changes
+        // between receiver messages
+        bool new_data = primary_instance != GPS_BLENDED_INSTANCE;
+        for (uint8_t i=0; i<GPS_MAX_RECEIVERS; i++) {
+            if (timing[i].last_message_time_ms != _blend_message_time_ms[i]) {
+                _blend_message_time_ms[i] = timing[i].last_message_time_ms;
+                new_data = true;
+            }
+        }
+        if (new_data) {
+            calc_blended_state();
+        }
         // set primary to the virtual instance
         primary_instance = GPS_BLENDED_INSTANCE;
         return;
@@ -1324,27 +1342,123 @@ void AP_GPS::lock_port(uint8_t instance, bool lock)
 // Inject a packet of raw binary to a GPS
 void AP_GPS::inject_data(const uint8_t *data, uint16_t len)
 {
-    //Support broadcasting to all GPSes.
-    if (_inject_to == GPS_RTK_INJECT_TO_ALL) {
-        for (uint8_t i=0; i<GPS_MAX_RECEIVERS; i++) {
+#if AP_GPS_RTCM_INJECT_FRAMES_ENABLED
+    if (option_set(DriverOptions::InjectRTCMFrames) && inject_rtcm_frames(data, len)) {
+        return;
+    }
+#endif
+    send_injected_data(data, len);
+}
+
+// send injected data to the GPSes selected by GPS_INJECT_TO
+void AP_GPS::send_injected_data(const uint8_t *data, uint16_t len)
+{
+    for (uint8_t i=0; i<GPS_MAX_RECEIVERS; i++) {
+        //Support broadcasting to all GPSes.
+        if (_inject_to == GPS_RTK_INJECT_TO_ALL) {
             if ((_type[i] == GPS_TYPE_UBLOX_RTK_ROVER) || (_type[i] == GPS_TYPE_UAVCAN_RTK_ROVER)) {
                 // we don't externally inject to moving baseline rover
                 continue;
             }
-            inject_data(i, data, len);
+        } else if (i != _inject_to) {
+            continue;
+        }
+        if (!inject_data(i, data, len)) {
+#if AP_GPS_RTCM_INJECT_FRAMES_ENABLED
+            if (rtcm_inject != nullptr) {
+                rtcm_inject->dropped += len;
+            }
+#endif
         }
-    } else {
-        inject_data(_inject_to, data, len);
     }
 }
 
-void AP_GPS::inject_data(uint8_t instance, const uint8_t *data, uint16_t len)
+bool AP_GPS::inject_data(uint8_t instance, const uint8_t *data, uint16_t len)
 {
     if (instance < GPS_MAX_RECEIVERS && drivers[instance] != nullptr) {
-        drivers[instance]->inject_data(data, len);
+        return drivers[instance]->inject_data(data, len);
+    }
+    return true;
+}
+
+#if AP_GPS_RTCM_INJECT_FRAMES_ENABLED
+/*
+  pass injected data through RTCMv3 framing, sending only complete
+  frames. Frames split across MAVLink messages are held until the rest
+  arrives, and all the frames completed by a block of data are sent
+  in one write. Returns false if the framing buffer can't be allocated
+ */
+bool AP_GPS::inject_rtcm_frames(const uint8_t *data, uint16_t len)
+{
+    if (rtcm_inject == nullptr) {
+        rtcm_inject = (struct rtcm_inject *)calloc(1, sizeof(*rtcm_inject));
+        if (rtcm_inject == nullptr) {
+            return false;
+        }
+    }
+    struct rtcm_inject &ri = *rtcm_inject;
+
+    while (len > 0) {
+        // what is left from the last block is always shorter than a
+        // maximum length frame, so there is room for more
+        const uint16_t n = MIN(len, uint16_t(sizeof(ri.buffer) - ri.len));
+        memcpy(&ri.buffer[ri.len], data, n);
+        ri.len += n;
+        data += n;
+        len -= n;
+
+        uint16_t used, nframes;
+        const uint16_t frames_len = RTCM3_Parser::extract_packets(ri.buffer, ri.len, used, nframes);
+        if (frames_len > 0) {
+            send_injected_data(ri.buffer, frames_len);
+        }
+        ri.frames += nframes;
+        ri.frame_bytes += frames_len;
+        ri.discarded += used - frames_len;
+
+        // keep any partial frame for next time
+        memmove(&ri.buffer[0], &ri.buffer[used], ri.len - used);
+        ri.len -= used;
     }
+    return true;
 }
 
+/*
+  log RTCMv3 injection stats once a second
+ */
+void AP_GPS::Write_RTCM_Inject(void)
+{
+    const uint32_t now_ms = AP_HAL::millis();
+    const uint32_t dt_ms = now_ms - rtcm_inject->last_log_ms;
+    if (dt_ms < 1000) {
+        return;
+    }
+    rtcm_inject->last_log_ms = now_ms;
+#if HAL_LOGGING_ENABLED
+    if (should_log()) {
+// @LoggerMessage: GRTC
+// @Description: RTCMv3 data injected to GPSes, when only complete frames are injected
+// @Field: TimeUS: Time since system startup
+// @Field: FPS: frames injected per second
+// @Field: Bytes: bytes of frames injected
+// @Field: Disc: bytes discarded as not part of a valid frame
+// @Field: Drop: bytes dropped by GPSes without room to send them
+        AP::logger().Write("GRTC", "TimeUS,FPS,Bytes,Disc,Drop",
+                           "szbbb", "F----", "QfIII",
+                           AP_HAL::micros64(),
+                           rtcm_inject->frames * 1000.0f / dt_ms,
+                           rtcm_inject->frame_bytes,
+                           rtcm_inject->discarded,
+                           rtcm_inject->dropped);
+    }
+#endif
+    rtcm_inject->frames = 0;
+    rtcm_inject->frame_bytes = 0;
+    rtcm_inject->discarded = 0;
+    rtcm_inject->dropped = 0;
+}
+#endif // AP_GPS_RTCM_INJECT_FRAMES_ENABLED
+
 /*
   get GPS yaw following mavlink GPS_RAW_INT and GPS2_RAW
   convention. We return 0 if the GPS is not configured to provide
@@ -1716,8 +1830,10 @@ bool AP_GPS::calc_blend_weights(void)
         }
     }
     if ((max_ms - min_ms) < (2 * max_rate_ms)) {
-        // data is not too delayed so use the oldest time_stamp to give a chance for data from that receiver to be updated
-        state[GPS_BLENDED_INSTANCE].last_gps_time_ms = min_ms;
+        // data is not too delayed. The older data is propagated
+        // forward to the time of the newest when blending, so use
+        // the newest time stamp
+        state[GPS_BLENDED_INSTANCE].last_gps_time_ms = max_ms;
     } else {
         // receiver data has timed out so fail out of blending
         return false;
@@ -1953,6 +2069,44 @@ void AP_GPS::calc_blended_state(void)
         }
     }
 
+    /*
+     * Time align the receivers. Each receiver's data is valid at its
+     * message time less its lag. Data from receivers older than the
+     * newest message is propagated forward to that time using its
+     * velocity, so a fresh fix from the fastest receiver is output
+     * without waiting for, or being averaged with the delay of, the
+     * others.
+     */
+    uint8_t newest_index = 0;
+    for (uint8_t i=0; i<GPS_MAX_RECEIVERS; i++) {
+        if (_blend_weights[i] > 0.0f &&
+            (_blend_weights[newest_index] <= 0.0f ||
+             int32_t(timing[i].last_message_time_ms - timing[newest_index].last_message_time_ms) > 0)) {
+            newest_index = i;
+        }
+    }
+    float newest_lag_sec = 0;
+    get_lag(newest_index, newest_lag_sec);
+    const uint32_t newest_valid_ms = timing[newest_index].last_message_time_ms - uint32_t(newest_lag_sec * 1000.0f);
+    Location aligned_location[GPS_MAX_RECEIVERS];
+    uint32_t max_align_ms = 0;
+    for (uint8_t i=0; i<GPS_MAX_RECEIVERS; i++) {
+        aligned_location[i] = state[i].location;
+        if (_blend_weights[i] <= 0.0f || i == newest_index) {
+            continue;
+        }
+        float gps_lag_sec = 0;
+        get_lag(i, gps_lag_sec);
+        const uint32_t valid_ms = timing[i].last_message_time_ms - uint32_t(gps_lag_sec * 1000.0f);
+        const int32_t align_ms = int32_t(newest_valid_ms - valid_ms);
+        const float dt = align_ms * 0.001f;
+        aligned_location[i].offset(state[i].velocity.x * dt, state[i].velocity.y * dt);
+        if (state[i].have_vertical_velocity) {
+            aligned_location[i].alt -= int32_t(state[i].velocity.z * dt * 100.0f);
+        }
+        max_align_ms = MAX(max_align_ms, uint32_t(align_ms < 0 ? -align_ms : align_ms));
+    }
+
     /*
      * Calculate an instantaneous weighted/blended average location from the available GPS instances and store in the _output_state.
      * This will be statistically the most likely location, but will be not stable enough for direct use by the autopilot.
@@ -1965,7 +2119,7 @@ void AP_GPS::calc_blended_state(void)
         if (_blend_weights[i] > best_weight) {
             best_weight = _blend_weights[i];
             best_index = i;
-            state[GPS_BLENDED_INSTANCE].location = state[i].location;
+            state[GPS_BLENDED_INSTANCE].location = aligned_location[i];
         }
     }
 
@@ -1975,8 +2129,8 @@ void AP_GPS::calc_blended_state(void)
     blended_NE_offset_m.zero();
     for (uint8_t i=0; i<GPS_MAX_RECEIVERS; i++) {
         if (_blend_weights[i] > 0.0f && i != best_index) {
-            blended_NE_offset_m += state[GPS_BLENDED_INSTANCE].location.get_distance_NE(state[i].location) * _blend_weights[i];
-            blended_alt_offset_cm += (float)(state[i].location.alt - state[GPS_BLENDED_INSTANCE].location.alt) * _blend_weights[i];
+            blended_NE_offset_m += state[GPS_BLENDED_INSTANCE].location.get_distance_NE(aligned_location[i]) * _blend_weights[i];
+            blended_alt_offset_cm += (float)(aligned_location[i].alt - state[GPS_BLENDED_INSTANCE].location.alt) * _blend_weights[i];
         }
     }
 
@@ -1988,57 +2142,37 @@ void AP_GPS::calc_blended_state(void)
     state[GPS_BLENDED_INSTANCE].ground_speed = state[GPS_BLENDED_INSTANCE].velocity.xy().length();
     state[GPS_BLENDED_INSTANCE].ground_course = wrap_360(degrees(atan2f(state[GPS_BLENDED_INSTANCE].velocity.y, state[GPS_BLENDED_INSTANCE].velocity.x)));
 
-    // If the GPS week is the same then use a blended time_week_ms
-    // If week is different, then use time stamp from GPS with largest weighting
-    // detect inconsistent week data
-    uint8_t last_week_instance = 0;
-    bool weeks_consistent = true;
-    for (uint8_t i=0; i<GPS_MAX_RECEIVERS; i++) {
-        if (last_week_instance == 0 && _blend_weights[i] > 0) {
-            // this is our first valid sensor week data
-            last_week_instance = state[i].time_week;
-        } else if (last_week_instance != 0 && _blend_weights[i] > 0 && last_week_instance != state[i].time_week) {
-            // there is valid sensor week data that is inconsistent
-            weeks_consistent = false;
-        }
-    }
-    // calculate output
-    if (!weeks_consistent) {
-        // use data from highest weighted sensor
-        state[GPS_BLENDED_INSTANCE].time_week = state[best_index].time_week;
-        state[GPS_BLENDED_INSTANCE].time_week_ms = state[best_index].time_week_ms;
-    } else {
-        // use week number from highest weighting GPS (they should all have the same week number)
-        state[GPS_BLENDED_INSTANCE].time_week = state[best_index].time_week;
-        // calculate a blended value for the number of ms lapsed in the week
-        double temp_time_0 = 0.0;
-        for (uint8_t i=0; i<GPS_MAX_RECEIVERS; i++) {
-            if (_blend_weights[i] > 0.0f) {
-                temp_time_0 += (double)state[i].time_week_ms * (double)_blend_weights[i];
-            }
-        }
-        state[GPS_BLENDED_INSTANCE].time_week_ms = (uint32_t)temp_time_0;
-    }
+    // the blended solution is aligned to the newest receiver data,
+    // so use its GPS time
+    state[GPS_BLENDED_INSTANCE].time_week = state[newest_index].time_week;
+    state[GPS_BLENDED_INSTANCE].time_week_ms = state[newest_index].time_week_ms;
 
-    // calculate a blended value for the timing data and lag
-    double temp_time_1 = 0.0;
-    double temp_time_2 = 0.0;
-    for (uint8_t i=0; i<GPS_MAX_RECEIVERS; i++) {
-        if (_blend_weights[i] > 0.0f) {
-            temp_time_1 += (double)timing[i].last_fix_time_ms * (double) _blend_weights[i];
-            temp_time_2 += (double)timing[i].last_message_time_ms * (double)_blend_weights[i];
-            float gps_lag_sec = 0;
-            get_lag(i, gps_lag_sec);
-            _blended_lag_sec += gps_lag_sec * _blend_weights[i];
-        }
-    }
-    timing[GPS_BLENDED_INSTANCE].last_fix_time_ms = (uint32_t)temp_time_1;
-    timing[GPS_BLENDED_INSTANCE].last_message_time_ms = (uint32_t)temp_time_2;
+    // the blended position is valid at the time of the newest
+    // receiver data, so take its timing and lag
+    timing[GPS_BLENDED_INSTANCE].last_fix_time_ms = timing[newest_index].last_fix_time_ms;
+    timing[GPS_BLENDED_INSTANCE].last_message_time_ms = timing[newest_index].last_message_time_ms;
+    _blended_lag_sec = newest_lag_sec;
 
 #if HAL_LOGGING_ENABLED
     if (timing[GPS_BLENDED_INSTANCE].last_message_time_ms > last_blended_message_time_ms &&
         should_log()) {
         Write_GPS(GPS_BLENDED_INSTANCE);
+// @LoggerMessage: GBLD
+// @Description: GPS blending timing
+// @Field: TimeUS: Time since system startup
+// @Field: Ref: receiver whose newest data the blend is aligned to
+// @Field: Lat: time from the newest receiver data arriving to the blended output
+// @Field: Align: time older receiver data was propagated by to align it
+// @Field: W0: blend weight of first receiver
+// @Field: W1: blend weight of second receiver
+        AP::logger().Write("GBLD", "TimeUS,Ref,Lat,Align,W0,W1",
+                           "s#ss--", "F-CC00", "QBHHff",
+                           AP_HAL::micros64(),
+                           newest_index,
+                           uint16_t(MIN(AP_HAL::millis() - timing[newest_index].last_message_time_ms, UINT16_MAX)),
+                           uint16_t(MIN(max_align_ms, UINT16_MAX)),
+                           _blend_weights[0],
+                           _blend_weights[1]);
     }
 #endif
 }
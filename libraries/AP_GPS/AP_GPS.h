@@ -62,6 +62,13 @@
 #define HAL_MSP_GPS_ENABLED HAL_MSP_SENSORS_ENABLED
 #endif
 
+#ifndef AP_GPS_RTCM_INJECT_FRAMES_ENABLED
+#define AP_GPS_RTCM_INJECT_FRAMES_ENABLED (HAL_MEM_CLASS >= HAL_MEM_CLASS_300)
+#endif
+
+// room for a block of injected data plus a partial RTCMv3 frame
+#define GPS_RTCM_INJECT_BUFFER_LEN 2048
+
 #if GPS_MOVING_BASELINE
 #include "MovingBase.h"
 #endif // GPS_MOVING_BASELINE
@@ -606,6 +613,7 @@ protected:
         UBX_Use115200     = (1U << 2U),
         UAVCAN_MBUseDedicatedBus  = (1 << 3U),
         HeightEllipsoid   = (1U << 4),
+        InjectRTCMFrames  = (1U << 5),
     };
 
     // check if an option is set
@@ -709,7 +717,31 @@ private:
 
     //Inject a packet of raw binary to a GPS
     void inject_data(const uint8_t *data, uint16_t len);
-    void inject_data(uint8_t instance, const uint8_t *data, uint16_t len);
+    void send_injected_data(const uint8_t *data, uint16_t len);
+    // returns false if the GPS dropped the data
+    bool inject_data(uint8_t instance, const uint8_t *data, uint16_t len);
+
+#if AP_GPS_RTCM_INJECT_FRAMES_ENABLED
+    /*
+      RTCMv3 framing of injected data, allocated on first use when the
+      InjectRTCMFrames driver option is set. Injected bytes are held
+      until they make up complete frames, which are then sent to each
+      GPS in one write. Anything that isn't part of a valid frame is
+      discarded
+     */
+    struct rtcm_inject {
+        uint8_t buffer[GPS_RTCM_INJECT_BUFFER_LEN];
+        uint16_t len;
+        uint32_t last_log_ms;
+        // counts since last logged
+        uint32_t frames;
+        uint32_t frame_bytes;
+        uint32_t discarded;
+        uint32_t dropped;
+    } *rtcm_inject;
+    bool inject_rtcm_frames(const uint8_t *data, uint16_t len);
+    void Write_RTCM_Inject(void);
+#endif
 
     // GPS blending and switching
     Vector3f _blended_antenna_offset; // blended antenna offset
@@ -718,6 +750,7 @@ private:
     float _omega_lpf; // cutoff frequency in rad/sec of LPF applied to position offsets
     bool _output_is_blended; // true when a blended GPS solution being output
     uint8_t _blend_health_counter;  // 0 = perfectly health, 100 = very unhealthy
+    uint32_t _blend_message_time_ms[GPS_MAX_RECEIVERS]; // receiver message times used by the last blended state
 
     // calculate the blend weight.  Returns true if blend could be calculated, false if not
     bool calc_blend_weights(void);
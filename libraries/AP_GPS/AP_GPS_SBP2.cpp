@@ -83,15 +83,16 @@ AP_GPS_SBP2::read(void)
     return _attempt_state_update();
 }
 
-void
+bool
 AP_GPS_SBP2::inject_data(const uint8_t *data, uint16_t len)
 {
     if (port->txspace() > len) {
         last_injected_data_ms = AP_HAL::millis();
         port->write(data, len);
-    } else {
-        Debug("PIKSI: Not enough TXSPACE");
+        return true;
     }
+    Debug("PIKSI: Not enough TXSPACE");
+    return false;
 }
 
 //This attempts to reads all SBP messages from the incoming port.
@@ -586,8 +586,10 @@ void AP_GPS_UAVCAN::handle_moving_baseline_msg(const MovingBaselineDataCb &cb, u
     if (rtcm3_parser == nullptr) {
         return;
     }
-    for (const auto &c : cb.msg->data) {
-        rtcm3_parser->read(c);
+    const uint16_t len = cb.msg->data.size();
+    uint16_t used = 0;
+    while (used < len) {
+        used += rtcm3_parser->read(&cb.msg->data[used], len - used);
     }
 }
 
@@ -802,7 +804,7 @@ bool AP_GPS_UAVCAN::is_configured(void) const
 /*
   handle RTCM data from MAVLink GPS_RTCM_DATA, forwarding it over MAVLink
  */
-void AP_GPS_UAVCAN::inject_data(const uint8_t *data, uint16_t len)
+bool AP_GPS_UAVCAN::inject_data(const uint8_t *data, uint16_t len)
 {
     // we only handle this if we are the first UAVCAN GPS, as we send
     // the data as broadcast on all UAVCAN devive ports and we don't
@@ -810,6 +812,7 @@ void AP_GPS_UAVCAN::inject_data(const uint8_t *data, uint16_t len)
     if (_detected_module == 0) {
         _detected_modules[0].ap_uavcan->send_RTCMStream(data, len);
     }
+    return true;
 }
 
 /*
@@ -62,7 +62,7 @@ public:
     static void handle_relposheading_msg_trampoline(AP_UAVCAN* ap_uavcan, uint8_t node_id, const RelPosHeadingCb &cb);
 #endif
     static bool backends_healthy(char failure_msg[], uint16_t failure_msg_len);
-    void inject_data(const uint8_t *data, uint16_t len) override;
+    bool inject_data(const uint8_t *data, uint16_t len) override;
 
     bool get_error_codes(uint32_t &error_codes) const override { error_codes = error_code; return seen_status; };
 
@@ -559,18 +559,67 @@ AP_GPS_UBLOX::read(void)
         }
     }
 
-    const uint16_t numc = MIN(port->available(), 8192U);
-    for (uint16_t i = 0; i < numc; i++) {        // Process bytes received
+#if GPS_MOVING_BASELINE
+    // every byte has to be offered to the RTCMv3 parser
+    const bool bytewise = rtcm3_parser != nullptr;
+#else
+    const bool bytewise = false;
+#endif
 
-        // read the next byte
-        const int16_t rdata = port->read();
-        if (rdata < 0) {
-            break;
-        }
-        const uint8_t data = rdata;
+    uint16_t numc = MIN(port->available(), 8192U);
+    while (true) {
+        // read from the port in blocks. Bytes left over when we stop
+        // for an RTCMv3 packet are parsed on the next call
+        if (_rx_ofs >= _rx_len) {
+            if (numc == 0) {
+                break;
+            }
+            const ssize_t nread = port->read(_rx_buf, MIN(numc, sizeof(_rx_buf)));
+            if (nread <= 0) {
+                break;
+            }
 #if AP_GPS_DEBUG_LOGGING_ENABLED
-        log_data(&data, 1);
+            log_data(_rx_buf, nread);
 #endif
+            numc -= nread;
+            _rx_len = nread;
+            _rx_ofs = 0;
+        }
+
+        if (!bytewise) {
+            const uint8_t *rx = &_rx_buf[_rx_ofs];
+            const uint16_t rx_len = _rx_len - _rx_ofs;
+            if (_step == 0) {
+                // skip straight to the next preamble
+                const uint8_t *p = (const uint8_t *)memchr(rx, PREAMBLE1, rx_len);
+                if (p == nullptr) {
+                    _rx_ofs = _rx_len;
+                    continue;
+                }
+                _rx_ofs += p - rx;
+            } else if (_step == 6) {
+                // take as much of the payload as has been read,
+                // checksumming it in one pass
+                const uint16_t n = MIN(uint16_t(_payload_length - _payload_counter), rx_len);
+                uint8_t ck_a = _ck_a;
+                uint8_t ck_b = _ck_b;
+                for (uint16_t i = 0; i < n; i++) {
+                    ck_b += (ck_a += rx[i]);
+                }
+                _ck_a = ck_a;
+                _ck_b = ck_b;
+                // _payload_length was checked against the buffer size
+                memcpy(((uint8_t *)&_buffer) + _payload_counter, rx, n);
+                _payload_counter += n;
+                _rx_ofs += n;
+                if (_payload_counter == _payload_length) {
+                    _step++;
+                }
+                continue;
+            }
+        }
+
+        const uint8_t data = _rx_buf[_rx_ofs++];
 
 #if GPS_MOVING_BASELINE
         if (rtcm3_parser) {
@@ -67,6 +67,11 @@
 
 #define UBLOX_MAX_PORTS 6
 
+// bytes read from the port at a time
+#ifndef UBLOX_READ_CHUNK
+#define UBLOX_READ_CHUNK 128
+#endif
+
 #define RATE_POSLLH 1
 #define RATE_STATUS 1
 #define RATE_SOL 1
@@ -119,6 +124,8 @@ class RTCM3_Parser;
 
 class AP_GPS_UBLOX : public AP_GPS_Backend
 {
+    friend class AP_GPS_UBLOX_Test;
+
 public:
     AP_GPS_UBLOX(AP_GPS &_gps, AP_GPS::GPS_State &_state, AP_HAL::UARTDriver *_port, AP_GPS::GPS_Role role);
     ~AP_GPS_UBLOX() override;
@@ -701,6 +708,11 @@ private:
     uint8_t         _class;
     bool            _cfg_saved;
 
+    // bytes read from the port and not yet parsed
+    uint8_t         _rx_buf[UBLOX_READ_CHUNK];
+    uint16_t        _rx_len;
+    uint16_t        _rx_ofs;
+
     uint32_t        _last_vel_time;
     uint32_t        _last_pos_time;
     uint32_t        _last_cfg_sent_time;
@@ -122,7 +122,7 @@ void AP_GPS_Backend::fill_3d_velocity(void)
     state.have_vertical_velocity = false;
 }
 
-void
+bool
 AP_GPS_Backend::inject_data(const uint8_t *data, uint16_t len)
 {
     // not all backends have valid ports
@@ -131,8 +131,10 @@ AP_GPS_Backend::inject_data(const uint8_t *data, uint16_t len)
             port->write(data, len);
         } else {
             Debug("GPS %d: Not enough TXSPACE", state.instance + 1);
+            return false;
         }
     }
+    return true;
 }
 
 void AP_GPS_Backend::_detection_message(char *buffer, const uint8_t buflen) const
@@ -53,7 +53,9 @@ public:
 
     virtual bool is_configured(void) const { return true; }
 
-    virtual void inject_data(const uint8_t *data, uint16_t len);
+    // send correction data to the GPS, returning false if it was
+    // dropped
+    virtual bool inject_data(const uint8_t *data, uint16_t len);
 
     //MAVLink methods
     virtual bool supports_mavlink_gps_rtk_message() const { return false; }
@@ -121,9 +121,10 @@ bool RTCM3_Parser::read(uint8_t byte)
 
     if (pkt_len == 0 && pkt_bytes >= 3) {
         pkt_len = (pkt[1]<<8 | pkt[2]) & 0x3ff;
-        if (pkt_len == 0) {
-            resync();
-        }
+    }
+    while (pkt_bytes >= 3 && (pkt_len == 0 || pkt_len + 6U > sizeof(pkt))) {
+        // empty or too long to buffer, resync
+        resync();
     }
 
     if (pkt_len != 0 && pkt_bytes >= pkt_len + 6) {
@@ -135,6 +136,102 @@ bool RTCM3_Parser::read(uint8_t byte)
     return false;
 }
 
+// read in a block of bytes, stopping after the first full packet
+uint16_t RTCM3_Parser::read(const uint8_t *bytes, uint16_t len)
+{
+    clear_packet();
+
+    uint16_t used = 0;
+    while (true) {
+        if (pkt_bytes > 0 && pkt[0] != RTCMv3_PREAMBLE) {
+            resync();
+            continue;
+        }
+        if (pkt_len == 0 && pkt_bytes >= 3) {
+            pkt_len = (pkt[1]<<8 | pkt[2]) & 0x3ff;
+            if (pkt_len == 0) {
+                resync();
+                continue;
+            }
+        }
+        if (pkt_len != 0 && pkt_len + 6U > sizeof(pkt)) {
+            // too long, resync
+            resync();
+            continue;
+        }
+        if (pkt_len != 0 && pkt_bytes >= pkt_len + 6) {
+            // got header, packet body and parity
+            if (parse()) {
+                return used;
+            }
+            continue;
+        }
+        if (used >= len) {
+            // need more bytes
+            return used;
+        }
+        if (pkt_bytes == 0) {
+            // discard up to the next preamble
+            const uint8_t *p = (const uint8_t *)memchr(&bytes[used], RTCMv3_PREAMBLE, len-used);
+            if (p == nullptr) {
+                return len;
+            }
+            used = p - bytes;
+        }
+        // take what we need to complete the header or the packet
+        const uint16_t need = (pkt_len == 0 ? 3 : pkt_len + 6) - pkt_bytes;
+        const uint16_t n = MIN(need, uint16_t(len - used));
+        memcpy(&pkt[pkt_bytes], &bytes[used], n);
+        pkt_bytes += n;
+        used += n;
+    }
+}
+
+// find complete packets in a block, packing them at the start
+uint16_t RTCM3_Parser::extract_packets(uint8_t *bytes, uint16_t len, uint16_t &used, uint16_t &npackets)
+{
+    uint16_t out = 0;
+    uint16_t ofs = 0;
+    npackets = 0;
+    while (ofs < len) {
+        if (bytes[ofs] != RTCMv3_PREAMBLE) {
+            const uint8_t *p = (const uint8_t *)memchr(&bytes[ofs], RTCMv3_PREAMBLE, len-ofs);
+            if (p == nullptr) {
+                ofs = len;
+                break;
+            }
+            ofs = p - bytes;
+        }
+        if (len - ofs < 3) {
+            break;
+        }
+        const uint16_t pkt_len = (bytes[ofs+1]<<8 | bytes[ofs+2]) & 0x3ff;
+        if (pkt_len == 0) {
+            ofs++;
+            continue;
+        }
+        if (len - ofs < pkt_len + 6) {
+            // wait for the rest of the packet
+            break;
+        }
+        const uint8_t *parity = &bytes[ofs+pkt_len+3];
+        const uint32_t crc1 = (parity[0] << 16) | (parity[1] << 8) | parity[2];
+        const uint32_t crc2 = crc_crc24(&bytes[ofs], pkt_len+3);
+        if (crc1 != crc2) {
+            ofs++;
+            continue;
+        }
+        if (out != ofs) {
+            memmove(&bytes[out], &bytes[ofs], pkt_len+6);
+        }
+        out += pkt_len+6;
+        ofs += pkt_len+6;
+        npackets++;
+    }
+    used = ofs;
+    return out;
+}
+
 #ifdef RTCM_MAIN_TEST
 /*
   parsing test, taking a raw file captured from UART to u-blox F9
@@ -155,11 +252,16 @@ int main(int argc, const char *argv[])
         ::exit(1);
     }
     RTCM3_Parser parser {};
-    uint8_t b;
-    while (::read(fd, &b, 1) == 1) {
-        if (parser.read(b)) {
+    uint8_t buf[256];
+    ssize_t n;
+    while ((n = ::read(fd, buf, sizeof(buf))) > 0) {
+        uint16_t used = 0;
+        while (used < n) {
+            used += parser.read(&buf[used], n - used);
             const uint8_t *bytes;
-            printf("packet len %u ID %u\n", parser.get_len(bytes), parser.get_id());
+            if (parser.get_len(bytes) > 0) {
+                printf("packet len %u ID %u\n", parser.get_len(bytes), parser.get_id());
+            }
         }
     }
     return 0;
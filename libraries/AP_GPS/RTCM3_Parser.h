@@ -25,6 +25,20 @@ public:
     // process one byte, return true if packet found
     bool read(uint8_t b);
 
+    // process a block of bytes, stopping after the first packet
+    // found. Returns the number of bytes used, with get_len()
+    // returning non-zero if a packet was found
+    uint16_t read(const uint8_t *bytes, uint16_t len);
+
+    // find the complete packets in a block of bytes without copying
+    // them into a parser, moving them to the start of the block and
+    // discarding anything between them. Returns the total length of
+    // the packets, sets used to the number of bytes consumed and
+    // npackets to the number of packets found. Bytes from used onwards
+    // may be the start of a packet and should be passed in again once
+    // more bytes have arrived
+    static uint16_t extract_packets(uint8_t *bytes, uint16_t len, uint16_t &used, uint16_t &npackets);
+
     // reset internal state
     void reset(void);
 
@@ -38,7 +52,7 @@ public:
     uint16_t get_id(void) const;
     
 private:
-    const uint8_t RTCMv3_PREAMBLE = 0xD3;
+    static const uint8_t RTCMv3_PREAMBLE = 0xD3;
 
     // raw packet, we shouldn't need over 300 bytes for the MB configs we use
     uint8_t pkt[RTCM3_MAX_PACKET_LEN];
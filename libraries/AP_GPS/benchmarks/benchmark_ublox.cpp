@@ -0,0 +1,136 @@
+#include <AP_gbenchmark.h>
+
+#include <AP_HAL/UARTDriver.h>
+#include <AP_GPS/AP_GPS.h>
+#include <AP_GPS/AP_GPS_UBLOX.h>
+#include <AP_GPS/RTCM3_Parser.h>
+#include <string.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+#if AP_GPS_UBLOX_ENABLED && GPS_MOVING_BASELINE
+
+// a port which returns the same bytes each time it is rewound
+class StreamUart: public AP_HAL::UARTDriver {
+public:
+    void begin(uint32_t baud) override {  };
+    void begin(uint32_t baud, uint16_t rxSpace, uint16_t txSpace) override {  };
+    void end() override {  };
+    void flush() override {  };
+    bool is_initialized() override { return true; };
+    void set_blocking_writes(bool blocking) override {  };
+    bool tx_pending() override { return false; };
+    uint32_t available() override { return _len - _ofs; };
+    uint32_t txspace() override { return 1024; };
+    int16_t read() override { return _ofs < _len ? _data[_ofs++] : -1; };
+    ssize_t read(uint8_t *buffer, uint16_t count) override {
+        const uint32_t n = MIN(uint32_t(count), available());
+        memcpy(buffer, &_data[_ofs], n);
+        _ofs += n;
+        return n;
+    }
+
+    bool discard_input() override { _ofs = _len; return true; };
+    size_t write(uint8_t c) override { return 1; };
+    size_t write(const uint8_t *buffer, size_t size) override { return size; };
+
+    void set_data(const uint8_t *data, uint32_t len) {
+        _data = data;
+        _len = len;
+        _ofs = 0;
+    }
+
+private:
+    const uint8_t *_data;
+    uint32_t _len;
+    uint32_t _ofs;
+};
+
+class AP_GPS_UBLOX_Test
+{
+public:
+    // parse a byte at a time, as for a moving baseline base
+    static void set_bytewise(AP_GPS_UBLOX &driver) {
+        driver.rtcm3_parser = new RTCM3_Parser;
+    }
+};
+
+static uint16_t add_frame(uint8_t *buf, uint8_t msg_class, uint8_t msg_id, const uint8_t *payload, uint16_t len)
+{
+    buf[0] = 0xB5;
+    buf[1] = 0x62;
+    buf[2] = msg_class;
+    buf[3] = msg_id;
+    buf[4] = len & 0xFF;
+    buf[5] = len >> 8;
+    memcpy(&buf[6], payload, len);
+    uint8_t ck_a = 0, ck_b = 0;
+    for (uint16_t i=2; i<6+len; i++) {
+        ck_b += (ck_a += buf[i]);
+    }
+    buf[6+len] = ck_a;
+    buf[7+len] = ck_b;
+    return len + 8;
+}
+
+/*
+  one second of output from a receiver logging raw data at 5Hz: a
+  NAV-PVT and a RXM-RAWX with 24 measurements per epoch
+ */
+static uint8_t stream[5*(100+16+32*24+8)];
+static uint32_t stream_len;
+
+static void make_stream(void)
+{
+    if (stream_len != 0) {
+        return;
+    }
+    uint8_t payload[16+32*24];
+    for (uint8_t i=0; i<5; i++) {
+        for (uint16_t j=0; j<sizeof(payload); j++) {
+            payload[j] = i + j * 7;
+        }
+        stream_len += add_frame(&stream[stream_len], 0x01, 0x07, payload, 92);
+        payload[11] = 24;
+        stream_len += add_frame(&stream[stream_len], 0x02, 0x15, payload, sizeof(payload));
+    }
+}
+
+static void bm_read(benchmark::State& state, bool bytewise)
+{
+    static AP_GPS gps;
+    StreamUart uart;
+    AP_GPS::GPS_State gps_state {};
+    AP_GPS_UBLOX driver(gps, gps_state, &uart, AP_GPS::GPS_ROLE_NORMAL);
+    if (bytewise) {
+        AP_GPS_UBLOX_Test::set_bytewise(driver);
+    }
+    make_stream();
+
+    while (state.KeepRunning()) {
+        uart.set_data(stream, stream_len);
+        bool parsed = driver.read();
+        gbenchmark_escape(&parsed);
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * stream_len);
+}
+
+// reading the port in blocks
+static void BM_UBXReadBlock(benchmark::State& state)
+{
+    bm_read(state, false);
+}
+
+// parsing a byte at a time, including offering each byte to the
+// RTCMv3 parser
+static void BM_UBXReadBytewise(benchmark::State& state)
+{
+    bm_read(state, true);
+}
+
+BENCHMARK(BM_UBXReadBlock);
+BENCHMARK(BM_UBXReadBytewise);
+
+#endif // AP_GPS_UBLOX_ENABLED && GPS_MOVING_BASELINE
+
+BENCHMARK_MAIN();
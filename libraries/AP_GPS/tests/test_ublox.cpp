@@ -0,0 +1,223 @@
+#include <AP_gtest.h>
+
+/*
+  check that the u-blox driver parses a UBX stream the same when it
+  reads the port in blocks as when it parses a byte at a time, which
+  it does when it also has to look for RTCMv3 packets
+ */
+
+#include <AP_HAL/UARTDriver.h>
+#include <AP_GPS/AP_GPS.h>
+#include <AP_GPS/AP_GPS_UBLOX.h>
+#include <AP_GPS/RTCM3_Parser.h>
+#include <string.h>
+
+const AP_HAL::HAL &hal = AP_HAL::get_HAL();
+
+#if AP_GPS_UBLOX_ENABLED && GPS_MOVING_BASELINE
+
+// a port which returns bytes the test has made available
+class StreamUart: public AP_HAL::UARTDriver {
+public:
+    void begin(uint32_t baud) override {  };
+    void begin(uint32_t baud, uint16_t rxSpace, uint16_t txSpace) override {  };
+    void end() override {  };
+    void flush() override {  };
+    bool is_initialized() override { return true; };
+    void set_blocking_writes(bool blocking) override {  };
+    bool tx_pending() override { return false; };
+    uint32_t available() override { return _len - _ofs; };
+    uint32_t txspace() override { return 1024; };
+    int16_t read() override { return _ofs < _len ? _data[_ofs++] : -1; };
+    ssize_t read(uint8_t *buffer, uint16_t count) override {
+        const uint32_t n = MIN(uint32_t(count), available());
+        memcpy(buffer, &_data[_ofs], n);
+        _ofs += n;
+        return n;
+    }
+
+    bool discard_input() override { _ofs = _len; return true; };
+    size_t write(uint8_t c) override { return 1; };
+    size_t write(const uint8_t *buffer, size_t size) override { return size; };
+
+    // make the first len bytes of data available to read
+    void set_data(const uint8_t *data, uint32_t len) {
+        _data = data;
+        _len = len;
+    }
+
+private:
+    const uint8_t *_data;
+    uint32_t _len;
+    uint32_t _ofs;
+};
+
+class AP_GPS_UBLOX_Test
+{
+public:
+    // parse a byte at a time, as for a moving baseline base
+    static void set_bytewise(AP_GPS_UBLOX &driver) {
+        driver.rtcm3_parser = new RTCM3_Parser;
+    }
+    static uint8_t step(const AP_GPS_UBLOX &driver) {
+        return driver._step;
+    }
+    static uint16_t payload_counter(const AP_GPS_UBLOX &driver) {
+        return driver._payload_counter;
+    }
+};
+
+static uint32_t rand_seed = 1;
+static uint32_t rand_next(void)
+{
+    rand_seed = rand_seed * 1664525U + 1013904223U;
+    return rand_seed >> 8;
+}
+
+static void put_u32(uint8_t *buf, uint32_t v)
+{
+    memcpy(buf, &v, sizeof(v));
+}
+
+// add a UBX frame to buf, returning its length
+static uint16_t add_frame(uint8_t *buf, uint8_t msg_class, uint8_t msg_id, const uint8_t *payload, uint16_t len)
+{
+    buf[0] = 0xB5;
+    buf[1] = 0x62;
+    buf[2] = msg_class;
+    buf[3] = msg_id;
+    buf[4] = len & 0xFF;
+    buf[5] = len >> 8;
+    memcpy(&buf[6], payload, len);
+    uint8_t ck_a = 0, ck_b = 0;
+    for (uint16_t i=2; i<6+len; i++) {
+        ck_b += (ck_a += buf[i]);
+    }
+    buf[6+len] = ck_a;
+    buf[7+len] = ck_b;
+    return len + 8;
+}
+
+static uint8_t stream[65536];
+static uint32_t stream_len;
+
+// end of each valid NAV-PVT frame in the stream, and its time of week
+static struct {
+    uint32_t end;
+    uint32_t itow;
+} pvts[1024];
+static uint16_t num_pvts;
+
+/*
+  synthesise NAV-PVT and RXM-RAWX frames, with junk, false preambles,
+  corrupted checksums and oversize lengths between them
+ */
+static void make_stream(void)
+{
+    uint8_t payload[16+32*32];
+    uint32_t itow = 1000;
+    stream_len = 0;
+    num_pvts = 0;
+    while (stream_len + 8 + sizeof(payload) < sizeof(stream) && num_pvts < ARRAY_SIZE(pvts)) {
+        const uint8_t type = rand_next() % 10;
+        if (type < 4) {
+            // NAV-PVT, with fields at their offsets in the u-blox
+            // interface description
+            memset(payload, 0, 92);
+            put_u32(&payload[0], itow);
+            payload[20] = 3;                    // fix_type
+            payload[23] = 5 + rand_next() % 20; // num_sv
+            put_u32(&payload[24], rand_next()); // lon
+            put_u32(&payload[28], rand_next()); // lat
+            put_u32(&payload[36], rand_next()); // h_msl
+            put_u32(&payload[48], rand_next()); // velN
+            stream_len += add_frame(&stream[stream_len], 0x01, 0x07, payload, 92);
+            pvts[num_pvts].end = stream_len;
+            pvts[num_pvts].itow = itow;
+            num_pvts++;
+            itow += 200;
+        } else if (type < 7) {
+            // RXM-RAWX with a varying number of measurements
+            const uint8_t num_meas = rand_next() % 33;
+            const uint16_t len = 16 + 32 * num_meas;
+            for (uint16_t i=0; i<len; i++) {
+                payload[i] = rand_next();
+            }
+            payload[11] = num_meas;
+            stream_len += add_frame(&stream[stream_len], 0x02, 0x15, payload, len);
+        } else if (type == 7) {
+            // junk, including preamble bytes. A full preamble would
+            // start a false frame which could swallow the next real
+            // one, so 0x62 never follows 0xB5
+            const uint8_t len = rand_next() % 64;
+            for (uint8_t i=0; i<len; i++) {
+                const uint8_t r = rand_next() % 8;
+                uint8_t c = r == 0 ? 0xB5 : r == 1 ? 0x62 : rand_next();
+                if (c == 0x62 && stream_len > 0 && stream[stream_len-1] == 0xB5) {
+                    c = 0;
+                }
+                stream[stream_len++] = c;
+            }
+        } else if (type == 8) {
+            // a frame with a bad checksum
+            for (uint8_t i=0; i<40; i++) {
+                payload[i] = rand_next();
+            }
+            const uint16_t len = add_frame(&stream[stream_len], 0x01, 0x07, payload, 40);
+            stream[stream_len + len - 1 - rand_next() % 2] ^= 0x55;
+            stream_len += len;
+        } else {
+            // a header with a length too large for the driver
+            const uint8_t hdr[] { 0xB5, 0x62, 0x02, 0x15, 0xFF, 0xFF };
+            memcpy(&stream[stream_len], hdr, sizeof(hdr));
+            stream_len += sizeof(hdr);
+        }
+    }
+}
+
+TEST(AP_GPS_UBLOX, block_matches_bytewise)
+{
+    AP_GPS gps;
+    StreamUart uart_block, uart_byte;
+    AP_GPS::GPS_State state_block {}, state_byte {};
+    AP_GPS_UBLOX block(gps, state_block, &uart_block, AP_GPS::GPS_ROLE_NORMAL);
+    AP_GPS_UBLOX byte(gps, state_byte, &uart_byte, AP_GPS::GPS_ROLE_NORMAL);
+    AP_GPS_UBLOX_Test::set_bytewise(byte);
+
+    make_stream();
+    ASSERT_GT(num_pvts, 100);
+
+    // make the stream available in bursts of varying size, so frames
+    // and read blocks are split at every point
+    uint32_t len = 0;
+    uint16_t pvt = 0;
+    uint32_t expected_itow = 0;
+    while (len < stream_len) {
+        len = MIN(len + 1 + rand_next() % 300, stream_len);
+        uart_block.set_data(stream, len);
+        uart_byte.set_data(stream, len);
+        EXPECT_EQ(block.read(), byte.read());
+        EXPECT_EQ(uart_block.available(), 0U);
+        EXPECT_EQ(uart_byte.available(), 0U);
+
+        EXPECT_EQ(AP_GPS_UBLOX_Test::step(block), AP_GPS_UBLOX_Test::step(byte));
+        EXPECT_EQ(AP_GPS_UBLOX_Test::payload_counter(block), AP_GPS_UBLOX_Test::payload_counter(byte));
+
+        while (pvt < num_pvts && pvts[pvt].end <= len) {
+            expected_itow = pvts[pvt++].itow;
+        }
+        EXPECT_EQ(state_block.time_week_ms, expected_itow);
+        EXPECT_EQ(state_byte.time_week_ms, expected_itow);
+        EXPECT_EQ(state_block.status, state_byte.status);
+        EXPECT_EQ(state_block.num_sats, state_byte.num_sats);
+        EXPECT_EQ(state_block.location.lat, state_byte.location.lat);
+        EXPECT_EQ(state_block.location.lng, state_byte.location.lng);
+        EXPECT_EQ(state_block.location.alt, state_byte.location.alt);
+        EXPECT_EQ(state_block.velocity.x, state_byte.velocity.x);
+    }
+    EXPECT_EQ(pvt, num_pvts);
+}
+
+#endif // AP_GPS_UBLOX_ENABLED && GPS_MOVING_BASELINE
+
+AP_GTEST_MAIN()
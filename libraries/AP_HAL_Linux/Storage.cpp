@@ -9,6 +9,7 @@
 #include <unistd.h>
 
 #include <AP_HAL/AP_HAL.h>
+#include <AP_Common/ExpandingString.h>
 #include <AP_Vehicle/AP_Vehicle_Type.h>
 
 using namespace Linux;
@@ -212,37 +213,42 @@ void Storage::write_block(uint16_t loc, const void *src, size_t n)
         init();
         memcpy(&_buffer[loc], src, n);
         _mark_dirty(loc, n);
+        _stats.requested += n;
     }
 }
 
 void Storage::_timer_tick(void)
 {
-    if (!_initialised || _dirty_mask == 0 || _fd == -1) {
+    if (!_initialised || _fd == -1) {
         return;
     }
-
-    // write out the first dirty set of lines. We don't write more
-    // than one to keep the latency of this call to a minimum
-    uint8_t i, n;
-    for (i=0; i<LINUX_STORAGE_NUM_LINES; i++) {
-        if (_dirty_mask & (1<<i)) {
-            break;
+    const uint32_t dirty = _dirty_mask;
+    if (dirty == 0) {
+        // one fsync covers all the writes of a burst of updates
+        if (_fsync_pending &&
+            AP_HAL::millis() - _last_write_ms >= LINUX_STORAGE_FSYNC_DELAY_MS) {
+            _fsync_pending = false;
+            _stats.fsyncs++;
+            if (fsync(_fd) != 0) {
+                close(_fd);
+                _fd = -1;
+            }
         }
-    }
-    if (i == LINUX_STORAGE_NUM_LINES) {
-        // this shouldn't be possible
         return;
     }
-    uint32_t write_mask = (1U<<i);
-    // see how many lines to write
-    for (n=1; (i+n) < LINUX_STORAGE_NUM_LINES &&
-             n < (LINUX_STORAGE_MAX_WRITE>>LINUX_STORAGE_LINE_SHIFT); n++) {
-        if (!(_dirty_mask & (1<<(n+i)))) {
-            break;
+
+    // write the first dirty line through the last dirty line that
+    // fits in LINUX_STORAGE_MAX_WRITE in a single pwrite()
+    const uint8_t i = __builtin_ctz(dirty);
+    uint8_t n = 32 - __builtin_clz(dirty) - i;
+    if (n > (LINUX_STORAGE_MAX_WRITE>>LINUX_STORAGE_LINE_SHIFT)) {
+        n = LINUX_STORAGE_MAX_WRITE>>LINUX_STORAGE_LINE_SHIFT;
+        // end the write on a dirty line
+        while (!(dirty & (1U<<(i+n-1)))) {
+            n--;
         }
-        // mark that line clean
-        write_mask |= (1<<(n+i));
     }
+    const uint32_t write_mask = (n == 32) ? 0xFFFFFFFFU : ((1U<<n)-1) << i;
 
     /*
       write the lines. This also updates _dirty_mask. Note that
@@ -250,20 +256,33 @@ void Storage::_timer_tick(void)
       by the main task except during blocking calls. This means we
       don't need a semaphore around the _dirty_mask updates.
      */
-    if (lseek(_fd, i<<LINUX_STORAGE_LINE_SHIFT, SEEK_SET) == (i<<LINUX_STORAGE_LINE_SHIFT)) {
-        _dirty_mask &= ~write_mask;
-        if (write(_fd, &_buffer[i<<LINUX_STORAGE_LINE_SHIFT], n<<LINUX_STORAGE_LINE_SHIFT) != n<<LINUX_STORAGE_LINE_SHIFT) {
-            // write error - likely EINTR
-            _dirty_mask |= write_mask;
-            close(_fd);
-            _fd = -1;
-        }
-        if (_dirty_mask == 0) {
-            if (fsync(_fd) != 0) {
-                close(_fd);
-                _fd = -1;
-            }
-        }
+    _dirty_mask &= ~write_mask;
+    const ssize_t len = n<<LINUX_STORAGE_LINE_SHIFT;
+    _stats.writes++;
+    if (pwrite(_fd, &_buffer[i<<LINUX_STORAGE_LINE_SHIFT], len, i<<LINUX_STORAGE_LINE_SHIFT) != len) {
+        // write error - likely EINTR
+        _dirty_mask |= (write_mask & dirty);
+        close(_fd);
+        _fd = -1;
+        return;
+    }
+    _stats.written += len;
+    _fsync_pending = true;
+    _last_write_ms = AP_HAL::millis();
+}
+
+/*
+  report write amplification: bytes written to the file for each byte
+  changed by callers
+ */
+void Storage::storage_info(ExpandingString &str)
+{
+    str.printf("requested: %u\n", unsigned(_stats.requested));
+    str.printf("written: %u\n", unsigned(_stats.written));
+    str.printf("writes: %u\n", unsigned(_stats.writes));
+    str.printf("fsyncs: %u\n", unsigned(_stats.fsyncs));
+    if (_stats.requested != 0) {
+        str.printf("amplification: %.2f\n", double(_stats.written) / _stats.requested);
     }
 }
 
@@ -3,7 +3,17 @@
 #include <AP_HAL/AP_HAL.h>
 
 #define LINUX_STORAGE_SIZE HAL_STORAGE_SIZE
-#define LINUX_STORAGE_MAX_WRITE 512
+// most bytes written in one _timer_tick(); dirty lines within this
+// span of the first dirty line are written together, along with any
+// clean lines between them
+#ifndef LINUX_STORAGE_MAX_WRITE
+#define LINUX_STORAGE_MAX_WRITE 4096
+#endif
+// fsync once storage has had nothing to write for this long, rather
+// than each time the last dirty line is written
+#ifndef LINUX_STORAGE_FSYNC_DELAY_MS
+#define LINUX_STORAGE_FSYNC_DELAY_MS 500
+#endif
 #define LINUX_STORAGE_LINE_SHIFT 9
 #define LINUX_STORAGE_LINE_SIZE (1<<LINUX_STORAGE_LINE_SHIFT)
 #define LINUX_STORAGE_NUM_LINES (LINUX_STORAGE_SIZE/LINUX_STORAGE_LINE_SIZE)
@@ -36,6 +46,8 @@ public:
 
     virtual void _timer_tick(void) override;
 
+    void storage_info(ExpandingString &str) override;
+
 protected:
     void _mark_dirty(uint16_t loc, uint16_t length);
     int _storage_create(const char *dpath);
@@ -43,6 +55,16 @@ protected:
     int _fd;
     volatile bool _initialised;
     volatile uint32_t _dirty_mask;
+    bool _fsync_pending;
+    uint32_t _last_write_ms;
+
+    // write amplification counters
+    struct {
+        uint32_t requested;     // bytes changed by write_block()
+        uint32_t written;       // bytes written to the file
+        uint32_t writes;        // pwrite() calls
+        uint32_t fsyncs;
+    } _stats;
     uint8_t _buffer[LINUX_STORAGE_SIZE];
 };
 
@@ -2,6 +2,7 @@
 
 #include <AP_Vehicle/AP_Vehicle_Type.h>
 #include <AP_HAL/AP_HAL.h>
+#include <AP_Common/ExpandingString.h>
 #include "AP_HAL_SITL.h"
 
 #include <assert.h>
@@ -10,6 +11,9 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include <stdio.h>
+#if STORAGE_USE_MMAP
+#include <sys/mman.h>
+#endif
 
 #ifndef HAL_STORAGE_FILE
 #if APM_BUILD_TYPE(APM_BUILD_Replay)
@@ -111,6 +115,14 @@ void Storage::_storage_open(void)
             log_fd = -1;
             return;
         }
+#if STORAGE_USE_MMAP
+        // flushes become a memcpy into the page cache; fall back to
+        // pwrite() if the file can't be mapped
+        void *p = mmap(nullptr, HAL_STORAGE_SIZE, PROT_READ|PROT_WRITE, MAP_SHARED, log_fd, 0);
+        if (p != MAP_FAILED) {
+            _mmap_ptr = (uint8_t *)p;
+        }
+#endif
         _initialisedType = StorageBackend::SDCard;  // AKA POSIX
         return;
     }
@@ -157,62 +169,127 @@ void Storage::write_block(uint16_t loc, const void *src, size_t n)
         _storage_open();
         memcpy(&_buffer[loc], src, n);
         _mark_dirty(loc, n);
+        _stats.requested += n;
     }
 }
 
-void Storage::_timer_tick(void)
+/*
+  find the first dirty extent: the first dirty line, extended over
+  following dirty lines and runs of at most max_gap clean lines, up
+  to max_lines lines. Writing a few clean lines costs less than a
+  separate backend write per dirty run.
+ */
+bool Storage::_dirty_extent(uint16_t &first, uint16_t &count, uint16_t max_lines, uint16_t max_gap) const
 {
-    if (_initialisedType == StorageBackend::None) {
-        return;
-    }
-    if (_dirty_mask.empty()) {
-        _last_empty_ms = AP_HAL::millis();
-        return;
+    const int16_t start = _dirty_mask.first_set();
+    if (start < 0) {
+        return false;
     }
-
-    // write out the first dirty line. We don't write more
-    // than one to keep the latency of this call to a minimum
-    uint16_t i;
-    for (i=0; i<STORAGE_NUM_LINES; i++) {
+    uint16_t end = start + 1;
+    uint16_t gap = 0;
+    for (uint16_t i=end; i<STORAGE_NUM_LINES && i-start < max_lines; i++) {
         if (_dirty_mask.get(i)) {
+            end = i + 1;
+            gap = 0;
+        } else if (++gap > max_gap) {
             break;
         }
     }
-    if (i == STORAGE_NUM_LINES) {
-        // this shouldn't be possible
-        return;
+    first = start;
+    count = end - start;
+    return true;
+}
+
+void Storage::_set_extent(uint16_t first, uint16_t count, bool dirty)
+{
+    for (uint16_t i=first; i<first+count; i++) {
+        _dirty_mask.setonoff(i, dirty);
     }
+}
+
+/*
+  write one extent of lines to the backend
+ */
+bool Storage::_write_extent(uint16_t first, uint16_t count)
+{
+    const uint16_t ofs = first * STORAGE_LINE_SIZE;
+    const uint16_t len = count * STORAGE_LINE_SIZE;
 
 #if STORAGE_USE_FRAM
-        if (fram.write(STORAGE_LINE_SIZE*i, &_buffer[STORAGE_LINE_SIZE*i], STORAGE_LINE_SIZE)) {
-            _dirty_mask.clear(i);
-            return;
-        }
+    if (_initialisedType == StorageBackend::FRAM) {
+        return fram.write(ofs, &_buffer[ofs], len);
+    }
 #endif
 
 #if STORAGE_USE_POSIX
-    if (hal.get_storage_posix_enabled()) {
-        if (log_fd != -1) {
-            const off_t offset = STORAGE_LINE_SIZE*i;
-            if (lseek(log_fd, offset, SEEK_SET) != offset) {
-                return;
-            }
-            if (write(log_fd, &_buffer[offset], STORAGE_LINE_SIZE) != STORAGE_LINE_SIZE) {
-                return;
-            }
-            _dirty_mask.clear(i);
-            return;
+    if (_initialisedType == StorageBackend::SDCard) {
+        if (log_fd == -1) {
+            return false;
+        }
+#if STORAGE_USE_MMAP
+        if (_mmap_ptr != nullptr) {
+            memcpy(&_mmap_ptr[ofs], &_buffer[ofs], len);
+            return true;
         }
+#endif
+        return pwrite(log_fd, &_buffer[ofs], len, ofs) == len;
     }
 #endif
 
 #if STORAGE_USE_FLASH
-    if (hal.get_storage_flash_enabled()) {
-        // save to storage backend
-        _flash_write(i);
+    if (_initialisedType == StorageBackend::Flash) {
+        return _flash.write(ofs, len);
+    }
+#endif
+
+    return false;
+}
+
+void Storage::_timer_tick(void)
+{
+    if (_initialisedType == StorageBackend::None) {
+        return;
+    }
+    if (_dirty_mask.empty()) {
+        _last_empty_ms = AP_HAL::millis();
         return;
     }
+
+    /*
+      write out the first dirty extent in one backend write. Flash
+      storage appends every byte written to its log, so for flash
+      only contiguous dirty lines are joined. A memcpy into a mapped
+      file is cheap enough to flush everything at once
+     */
+    uint16_t max_lines = STORAGE_MAX_WRITE / STORAGE_LINE_SIZE;
+    uint16_t max_gap = STORAGE_MAX_GAP_LINES;
+#if STORAGE_USE_FLASH
+    if (_initialisedType == StorageBackend::Flash) {
+        max_gap = 0;
+    }
+#endif
+#if STORAGE_USE_POSIX && STORAGE_USE_MMAP
+    if (_initialisedType == StorageBackend::SDCard && _mmap_ptr != nullptr) {
+        max_lines = STORAGE_NUM_LINES;
+        max_gap = STORAGE_NUM_LINES;
+    }
 #endif
+    uint16_t first, count;
+    if (!_dirty_extent(first, count, max_lines, max_gap)) {
+        // this shouldn't be possible
+        return;
+    }
+
+    // mark the extent clean before writing so that a write_block()
+    // racing with the backend write re-marks its lines
+    _set_extent(first, count, false);
+    _stats.writes++;
+    if (!_write_extent(first, count)) {
+        _set_extent(first, count, true);
+        _stats.failed++;
+        return;
+    }
+    _stats.written += count * STORAGE_LINE_SIZE;
 }
 
 #if STORAGE_USE_FLASH
@@ -227,17 +304,6 @@ void Storage::_flash_load(void)
     }
 }
 
-/*
-  write one storage line. This also updates _dirty_mask. 
-*/
-void Storage::_flash_write(uint16_t line)
-{
-    if (_flash.write(line*STORAGE_LINE_SIZE, STORAGE_LINE_SIZE)) {
-        // mark the line clean
-        _dirty_mask.clear(line);
-    }
-}
-
 
 /*
   emulate writing to flash
@@ -400,3 +466,19 @@ bool Storage::get_storage_ptr(void *&ptr, size_t &size)
     size = sizeof(_buffer);
     return true;
 }
+
+/*
+  report write amplification: bytes written to the backend for each
+  byte changed by callers
+ */
+void Storage::storage_info(ExpandingString &str)
+{
+    str.printf("requested: %u\n", unsigned(_stats.requested));
+    str.printf("written: %u\n", unsigned(_stats.written));
+    str.printf("writes: %u\n", unsigned(_stats.writes));
+    str.printf("failed: %u\n", unsigned(_stats.failed));
+    str.printf("dirty lines: %u\n", unsigned(_dirty_mask.count()));
+    if (_stats.requested != 0) {
+        str.printf("amplification: %.2f\n", double(_stats.written) / _stats.requested);
+    }
+}
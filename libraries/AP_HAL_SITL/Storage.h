@@ -18,11 +18,25 @@
 #define STORAGE_USE_FRAM HAL_WITH_RAMTRON
 #endif
 
+#ifndef STORAGE_USE_MMAP
+#define STORAGE_USE_MMAP 0
+#endif
+
 #define STORAGE_LINE_SHIFT 3
 
 #define STORAGE_LINE_SIZE (1<<STORAGE_LINE_SHIFT)
 #define STORAGE_NUM_LINES (HAL_STORAGE_SIZE/STORAGE_LINE_SIZE)
 
+// most bytes written to the backend in one _timer_tick()
+#ifndef STORAGE_MAX_WRITE
+#define STORAGE_MAX_WRITE 1024
+#endif
+
+// most clean lines rewritten to join two dirty extents into one write
+#ifndef STORAGE_MAX_GAP_LINES
+#define STORAGE_MAX_GAP_LINES 8
+#endif
+
 class HALSITL::Storage : public AP_HAL::Storage {
 public:
     void init() override {}
@@ -32,6 +46,7 @@ public:
 
     void _timer_tick(void) override;
     bool healthy(void) override;
+    void storage_info(ExpandingString &str) override;
 
 private:
     enum class StorageBackend: uint8_t {
@@ -46,11 +61,22 @@ private:
     void _storage_open(void);
     void _save_backup(void);
     void _mark_dirty(uint16_t loc, uint16_t length);
+    bool _dirty_extent(uint16_t &first, uint16_t &count, uint16_t max_lines, uint16_t max_gap) const;
+    void _set_extent(uint16_t first, uint16_t count, bool dirty);
+    bool _write_extent(uint16_t first, uint16_t count);
     uint8_t _buffer[HAL_STORAGE_SIZE] __attribute__((aligned(4)));
     Bitmask<STORAGE_NUM_LINES> _dirty_mask;
 
     uint32_t _last_empty_ms;
 
+    // write amplification counters
+    struct {
+        uint32_t requested;     // bytes changed by write_block()
+        uint32_t written;       // bytes written to the backend
+        uint32_t writes;        // backend write calls
+        uint32_t failed;        // failed backend write calls
+    } _stats;
+
 #if STORAGE_USE_FLASH
     bool _flash_write_data(uint8_t sector, uint32_t offset, const uint8_t *data, uint16_t length);
     bool _flash_read_data(uint8_t sector, uint32_t offset, uint8_t *data, uint16_t length);
@@ -68,11 +94,14 @@ private:
             FUNCTOR_BIND_MEMBER(&Storage::_flash_erase_ok, bool)};
 
     void _flash_load(void);
-    void _flash_write(uint16_t line);
 #endif
 
 #if STORAGE_USE_POSIX
     int log_fd;
+#if STORAGE_USE_MMAP
+    // shared mapping of HAL_STORAGE_FILE, nullptr if not mapped
+    uint8_t *_mmap_ptr = nullptr;
+#endif
 #endif
 
 #if STORAGE_USE_FRAM
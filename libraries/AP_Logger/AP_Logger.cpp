@@ -101,8 +101,8 @@ const AP_Param::GroupInfo AP_Logger::var_info[] = {
 
     // @Param: _REPLAY
     // @DisplayName: Enable logging of information needed for Replay
-    // @Description: If LOG_REPLAY is set to 1 then the EKF2 state estimator will log detailed information needed for diagnosing problems with the Kalman filter. It is suggested that you also raise LOG_FILE_BUFSIZE to give more buffer space for logging and use a high quality microSD card to ensure no sensor data is lost
-    // @Values: 0:Disabled,1:Enabled
+    // @Description: If LOG_REPLAY is set to 1 then the EKF2 state estimator will log detailed information needed for diagnosing problems with the Kalman filter. It is suggested that you also raise LOG_FILE_BUFSIZE to give more buffer space for logging and use a high quality microSD card to ensure no sensor data is lost. If set to 2 then sensor data which has only partly changed since it was last logged is written as the changed part only, reducing the logging bandwidth needed. Logs written with 2 need a version of Replay which understands the RDLT message
+    // @Values: 0:Disabled,1:Enabled,2:Enabled with delta encoded sensor data
     // @User: Standard
     AP_GROUPINFO("_REPLAY",  3, AP_Logger, _params.log_replay,       0),
 
@@ -167,6 +167,15 @@ const AP_Param::GroupInfo AP_Logger::var_info[] = {
     // @User: Standard
     AP_GROUPINFO("_BLK_RATEMAX", 10, AP_Logger, _params.blk_ratemax, 0),
 #endif
+
+#if HAL_LOGGER_FILE_COMPRESSION_ENABLED
+    // @Param: _FILE_CMPRS
+    // @DisplayName: Compress file logs
+    // @Description: If enabled, logs written to the file backend are block compressed, reducing write bandwidth and log size. Compressed logs are decompressed when downloaded over MAVLink and can be read directly by Replay. Takes effect when the next log is started.
+    // @Values: 0:Disabled,1:Enabled
+    // @User: Advanced
+    AP_GROUPINFO("_FILE_CMPRS", 11, AP_Logger, _params.file_compress, 0),
+#endif
     
     AP_GROUPEND
 };
@@ -985,18 +994,49 @@ void AP_Logger::WriteCritical(const char *name, const char *labels, const char *
 void AP_Logger::WriteV(const char *name, const char *labels, const char *units, const char *mults, const char *fmt, va_list arg_list,
                        bool is_critical, bool is_streaming)
 {
-    // WriteV is not safe in replay as we can re-use IDs
+    // a failure to map name to a messagetype is reported by
+    // find_msg_handle; WriteHV ignores the resulting nullptr
+    WriteHV(find_msg_handle(name, labels, units, mults, fmt), arg_list, is_critical, is_streaming);
+}
+
+AP_Logger::log_write_fmt *AP_Logger::find_msg_handle(const char *name, const char *labels, const char *units, const char *mults, const char *fmt)
+{
+    // name pointer comparison is not safe in replay as we can re-use IDs
     const bool direct_comp = APM_BUILD_TYPE(APM_BUILD_Replay);
     struct log_write_fmt *f = msg_fmt_for_name(name, labels, units, mults, fmt, direct_comp);
+#if !APM_BUILD_TYPE(APM_BUILD_Replay)
     if (f == nullptr) {
         // unable to map name to a messagetype; could be out of
         // msgtypes, could be out of slots, ...
-#if !APM_BUILD_TYPE(APM_BUILD_Replay)
         INTERNAL_ERROR(AP_InternalError::error_t::logger_mapfailure);
+    }
 #endif
+    return f;
+}
+
+void AP_Logger::WriteH(log_write_fmt *f, ...)
+{
+    va_list arg_list;
+
+    va_start(arg_list, f);
+    WriteHV(f, arg_list);
+    va_end(arg_list);
+}
+
+void AP_Logger::WriteCriticalH(log_write_fmt *f, ...)
+{
+    va_list arg_list;
+
+    va_start(arg_list, f);
+    WriteHV(f, arg_list, true);
+    va_end(arg_list);
+}
+
+void AP_Logger::WriteHV(log_write_fmt *f, va_list arg_list, bool is_critical, bool is_streaming)
+{
+    if (f == nullptr) {
         return;
     }
-
     for (uint8_t i=0; i<_next_backend; i++) {
         if (!(f->sent_mask & (1U<<i))) {
             if (!backends[i]->Write_Emit_FMT(f->msg_type)) {
@@ -1006,11 +1046,24 @@ void AP_Logger::WriteV(const char *name, const char *labels, const char *units,
         }
         va_list arg_copy;
         va_copy(arg_copy, arg_list);
-        backends[i]->Write(f->msg_type, arg_copy, is_critical, is_streaming);
+        backends[i]->Write(f, arg_copy, is_critical, is_streaming);
         va_end(arg_copy);
     }
 }
 
+void AP_Logger::WriteBlockH(log_write_fmt *f, const void *pBuffer, uint16_t size, bool is_critical)
+{
+    for (uint8_t i=0; i<_next_backend; i++) {
+        if (!(f->sent_mask & (1U<<i))) {
+            if (!backends[i]->Write_Emit_FMT(f->msg_type)) {
+                continue;
+            }
+            f->sent_mask |= (1U<<i);
+        }
+        backends[i]->WritePrioritisedBlock(pBuffer, size, is_critical);
+    }
+}
+
 /*
   when we are doing replay logging we want to delay start of the EKF
   until after the headers are out so that on replay all parameter
@@ -1277,6 +1330,34 @@ bool AP_Logger::fill_log_write_logstructure(struct LogStructure &logstruct, cons
     return true;
 }
 
+// size in bytes of a single log field of type c, or 0 if unknown
+uint8_t AP_Logger::fmt_field_size(const char c)
+{
+    switch(c) {
+    case 'a' : return sizeof(int16_t[32]);
+    case 'b' : return sizeof(int8_t);
+    case 'c' : return sizeof(int16_t);
+    case 'd' : return sizeof(double);
+    case 'e' : return sizeof(int32_t);
+    case 'f' : return sizeof(float);
+    case 'h' : return sizeof(int16_t);
+    case 'i' : return sizeof(int32_t);
+    case 'n' : return sizeof(char[4]);
+    case 'B' : return sizeof(uint8_t);
+    case 'C' : return sizeof(uint16_t);
+    case 'E' : return sizeof(uint32_t);
+    case 'H' : return sizeof(uint16_t);
+    case 'I' : return sizeof(uint32_t);
+    case 'L' : return sizeof(int32_t);
+    case 'M' : return sizeof(uint8_t);
+    case 'N' : return sizeof(char[16]);
+    case 'Z' : return sizeof(char[64]);
+    case 'q' : return sizeof(int64_t);
+    case 'Q' : return sizeof(uint64_t);
+    }
+    return 0;
+}
+
 /* calculate the length of output of a format string.  Note that this
  * returns an int16_t; if it returns -1 then an error has occurred.
  * This was mechanically converted from init_field_types in
@@ -1284,34 +1365,15 @@ bool AP_Logger::fill_log_write_logstructure(struct LogStructure &logstruct, cons
 int16_t AP_Logger::Write_calc_msg_len(const char *fmt) const
 {
     uint8_t len =  LOG_PACKET_HEADER_LEN;
-    for (uint8_t i=0; i<strlen(fmt); i++) {
-        switch(fmt[i]) {
-        case 'a' : len += sizeof(int16_t[32]); break;
-        case 'b' : len += sizeof(int8_t); break;
-        case 'c' : len += sizeof(int16_t); break;
-        case 'd' : len += sizeof(double); break;
-        case 'e' : len += sizeof(int32_t); break;
-        case 'f' : len += sizeof(float); break;
-        case 'h' : len += sizeof(int16_t); break;
-        case 'i' : len += sizeof(int32_t); break;
-        case 'n' : len += sizeof(char[4]); break;
-        case 'B' : len += sizeof(uint8_t); break;
-        case 'C' : len += sizeof(uint16_t); break;
-        case 'E' : len += sizeof(uint32_t); break;
-        case 'H' : len += sizeof(uint16_t); break;
-        case 'I' : len += sizeof(uint32_t); break;
-        case 'L' : len += sizeof(int32_t); break;
-        case 'M' : len += sizeof(uint8_t); break;
-        case 'N' : len += sizeof(char[16]); break;
-        case 'Z' : len += sizeof(char[64]); break;
-        case 'q' : len += sizeof(int64_t); break;
-        case 'Q' : len += sizeof(uint64_t); break;
-        default:
+    for (uint8_t i=0; fmt[i] != 0; i++) {
+        const uint8_t field_len = fmt_field_size(fmt[i]);
+        if (field_len == 0) {
 #if CONFIG_HAL_BOARD == HAL_BOARD_SITL
             AP_HAL::panic("Unknown format specifier (%c)", fmt[i]);
 #endif
             return -1;
         }
+        len += field_len;
     }
     return len;
 }
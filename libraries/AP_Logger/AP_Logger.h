@@ -48,6 +48,16 @@
 #define HAL_LOGGER_FILE_CONTENTS_ENABLED HAL_LOGGING_FILESYSTEM_ENABLED
 #endif
 
+#ifndef HAL_LOGGER_FILE_COMPRESSION_ENABLED
+#define HAL_LOGGER_FILE_COMPRESSION_ENABLED (HAL_LOGGING_FILESYSTEM_ENABLED && (CONFIG_HAL_BOARD == HAL_BOARD_SITL || CONFIG_HAL_BOARD == HAL_BOARD_LINUX))
+#endif
+
+// number of LOG_REQUEST_DATA requests for the log being sent that can
+// be queued while a request is in progress
+#ifndef HAL_LOGGER_LOG_REQUEST_QUEUE_LEN
+#define HAL_LOGGER_LOG_REQUEST_QUEUE_LEN 8
+#endif
+
 // range of IDs to allow for new messages during replay. It is very
 // useful to be able to add new messages during a replay, but we need
 // to avoid colliding with existing messages
@@ -56,6 +66,7 @@
 
 #include <AP_HAL/AP_HAL.h>
 #include <AP_Common/AP_Common.h>
+#include <AP_InternalError/AP_InternalError.h>
 #include <AP_Param/AP_Param.h>
 #include <AP_Mission/AP_Mission.h>
 #include <AP_Logger/LogStructure.h>
@@ -381,6 +392,7 @@ public:
         AP_Float file_ratemax;
         AP_Float mav_ratemax;
         AP_Float blk_ratemax;
+        AP_Int8 file_compress;
     } _params;
 
     const struct LogStructure *structure(uint16_t num) const;
@@ -419,6 +431,9 @@ public:
     // fmt; includes the message header
     int16_t Write_calc_msg_len(const char *fmt) const;
 
+    // size in bytes of a single field of type c, or 0 if unknown
+    static uint8_t fmt_field_size(char c);
+
     // this structure looks much like struct LogStructure in
     // LogStructure.h, however we need to remember a pointer value for
     // efficiency of finding message types
@@ -440,6 +455,62 @@ public:
     // output a FMT message for each backend if not already done so
     void Safe_Write_Emit_FMT(log_write_fmt *f);
 
+    /*
+      handle based interface for dynamic messages. A caller logging
+      the same message repeatedly resolves it once with
+      find_msg_handle() and then writes through the handle, avoiding
+      the semaphore and name lookup on every call:
+
+        static AP_Logger::log_write_fmt *h = logger.find_msg_handle("XYZ", "TimeUS,V", "Qf");
+        logger.WriteH(h, AP_HAL::micros64(), (double)v);
+        logger.WritePacked(h, AP_HAL::micros64(), v);
+
+      handles stay valid for the lifetime of the AP_Logger object.
+     */
+    log_write_fmt *find_msg_handle(const char *name, const char *labels, const char *fmt) {
+        return find_msg_handle(name, labels, nullptr, nullptr, fmt);
+    }
+    log_write_fmt *find_msg_handle(const char *name, const char *labels, const char *units, const char *mults, const char *fmt);
+
+    // write a message through a handle, values packed according to
+    // the handle's format string as for Write()
+    void WriteH(log_write_fmt *f, ...);
+    void WriteCriticalH(log_write_fmt *f, ...);
+    void WriteHV(log_write_fmt *f, va_list arg_list, bool is_critical=false, bool is_streaming=false);
+
+    /*
+      write a message through a handle, with the packed layout
+      determined at compile time from the argument types rather than
+      by parsing the format string. Each argument must have exactly
+      the size of its format field, e.g. uint64_t for 'Q', float for
+      'f', uint8_t for 'B' and char[16] for 'N'.
+     */
+    template <typename... Args>
+    void WritePacked(log_write_fmt *f, const Args&... args) {
+        uint8_t buffer[LOG_PACKET_HEADER_LEN + packed_size<Args...>()];
+        if (f == nullptr) {
+            return;
+        }
+        if (f->msg_len != sizeof(buffer)) {
+            INTERNAL_ERROR(AP_InternalError::error_t::logger_logwrite_missingfmt);
+            return;
+        }
+#if CONFIG_HAL_BOARD == HAL_BOARD_SITL
+        if (!packed_sizes_match(f->fmt, args...)) {
+            AP_HAL::panic("WritePacked argument types do not match format (%s) for %s", f->fmt, f->name);
+        }
+#endif
+        buffer[0] = HEAD_BYTE1;
+        buffer[1] = HEAD_BYTE2;
+        buffer[2] = f->msg_type;
+        pack_fields(&buffer[LOG_PACKET_HEADER_LEN], args...);
+        WriteBlockH(f, buffer, sizeof(buffer), false);
+    }
+
+    // write an already-packed message (including header) through a
+    // handle, emitting the FMT message first where required
+    void WriteBlockH(log_write_fmt *f, const void *pBuffer, uint16_t size, bool is_critical);
+
     // get count of number of times we have started logging
     uint8_t get_log_start_count(void) const {
         return _log_start_count;
@@ -490,6 +561,25 @@ private:
     // return a msg_type which is not currently in use (or -1 if none available)
     int16_t find_free_msg_type() const;
 
+    // compile-time helpers for WritePacked
+    template <typename T>
+    static constexpr uint16_t packed_size() { return sizeof(T); }
+    template <typename T, typename U, typename... Rest>
+    static constexpr uint16_t packed_size() { return sizeof(T) + packed_size<U, Rest...>(); }
+    static void pack_fields(uint8_t *) {}
+    template <typename T, typename... Rest>
+    static void pack_fields(uint8_t *buf, const T &v, const Rest&... rest) {
+        memcpy(buf, &v, sizeof(T));
+        pack_fields(buf + sizeof(T), rest...);
+    }
+#if CONFIG_HAL_BOARD == HAL_BOARD_SITL
+    static bool packed_sizes_match(const char *fmt) { return *fmt == 0; }
+    template <typename T, typename... Rest>
+    static bool packed_sizes_match(const char *fmt, const T &, const Rest&... rest) {
+        return *fmt != 0 && fmt_field_size(*fmt) == sizeof(T) && packed_sizes_match(fmt+1, rest...);
+    }
+#endif
+
     // fill LogStructure with information about msg_type
     bool fill_log_write_logstructure(struct LogStructure &logstruct, const uint8_t msg_type) const;
 
@@ -600,6 +690,13 @@ private:
     // start page of log data
     uint32_t _log_data_page;
 
+    // further requests for the log being sent, e.g. a GCS filling gaps
+    struct log_data_request {
+        uint32_t ofs;
+        uint32_t count;
+    } _log_data_queue[HAL_LOGGER_LOG_REQUEST_QUEUE_LEN];
+    uint8_t _log_data_queue_len;
+
     GCS_MAVLINK *_log_sending_link;
     HAL_Semaphore _log_send_sem;
 
@@ -619,6 +716,8 @@ private:
     void handle_log_send_listing(); // handle LISTING state
     void handle_log_sending(); // handle SENDING state
     bool handle_log_send_data(); // send data chunk to client
+    void log_data_request_start(uint32_t ofs, uint32_t count);
+    void log_data_request_queue(uint32_t ofs, uint32_t count);
 
     void get_log_info(uint16_t log_num, uint32_t &size, uint32_t &time_utc);
 
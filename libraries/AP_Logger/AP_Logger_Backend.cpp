@@ -213,25 +213,18 @@ bool AP_Logger_Backend::Write_Emit_FMT(uint8_t msg_type)
     return true;
 }
 
-bool AP_Logger_Backend::Write(const uint8_t msg_type, va_list arg_list, bool is_critical, bool is_streaming)
+bool AP_Logger_Backend::Write(const AP_Logger::log_write_fmt *f, va_list arg_list, bool is_critical, bool is_streaming)
 {
     // stack-allocate a buffer so we can WriteBlock(); this could be
     // 255 bytes!  If we were willing to lose the WriteBlock
     // abstraction we could do WriteBytes() here instead?
-    const char *fmt  = nullptr;
-    uint8_t msg_len;
-    AP_Logger::log_write_fmt *f;
-    for (f = _front.log_write_fmts; f; f=f->next) {
-        if (f->msg_type == msg_type) {
-            fmt = f->fmt;
-            msg_len = f->msg_len;
-            break;
-        }
-    }
-    if (fmt == nullptr) {
+    if (f == nullptr || f->fmt == nullptr) {
         INTERNAL_ERROR(AP_InternalError::error_t::logger_logwrite_missingfmt);
         return false;
     }
+    const char *fmt = f->fmt;
+    const uint8_t msg_type = f->msg_type;
+    const uint8_t msg_len = f->msg_len;
     if (bufferspace_available() < msg_len) {
         return false;
     }
@@ -241,7 +234,7 @@ bool AP_Logger_Backend::Write(const uint8_t msg_type, va_list arg_list, bool is_
     buffer[offset++] = HEAD_BYTE1;
     buffer[offset++] = HEAD_BYTE2;
     buffer[offset++] = msg_type;
-    for (uint8_t i=0; i<strlen(fmt); i++) {
+    for (uint8_t i=0; fmt[i] != 0; i++) {
         uint8_t charlen = 0;
         switch(fmt[i]) {
         case 'b': {
@@ -635,6 +628,8 @@ bool AP_Logger_Backend::logging_enabled() const
 
 void AP_Logger_Backend::Write_AP_Logger_Stats_File(const struct df_stats &_stats)
 {
+    const uint32_t compress_raw_bytes = compress_stats.raw_bytes.exchange(0);
+    const uint32_t compress_out_bytes = compress_stats.out_bytes.exchange(0);
     const struct log_DSF pkt {
         LOG_PACKET_HEADER_INIT(LOG_DF_FILE_STATS),
         time_us         : AP_HAL::micros64(),
@@ -644,6 +639,11 @@ void AP_Logger_Backend::Write_AP_Logger_Stats_File(const struct df_stats &_stats
         buf_space_min   : _stats.buf_space_min,
         buf_space_max   : _stats.buf_space_max,
         buf_space_avg   : (_stats.blocks) ? (_stats.buf_space_sigma / _stats.blocks) : 0,
+        staged          : _ingest.num_staged(),
+        staged_dropped  : _ingest.num_drops(),
+        staged_max      : _ingest.take_max_depth(),
+        compress_ratio  : (compress_out_bytes) ? (float(compress_raw_bytes) / compress_out_bytes) : 0,
+        compress_us     : compress_stats.time_us.exchange(0),
     };
     WriteBlock(&pkt, sizeof(pkt));
 }
@@ -662,6 +662,13 @@ void AP_Logger_Backend::df_stats_gather(const uint16_t bytes_written, uint32_t s
     stats.blocks++;
 }
 
+void AP_Logger_Backend::df_stats_compress(const uint16_t raw_bytes, const uint16_t compressed_bytes, const uint32_t time_us)
+{
+    compress_stats.raw_bytes += raw_bytes;
+    compress_stats.out_bytes += compressed_bytes;
+    compress_stats.time_us += time_us;
+}
+
 void AP_Logger_Backend::df_stats_clear() {
     memset(&stats, '\0', sizeof(stats));
     stats.buf_space_min = -1;
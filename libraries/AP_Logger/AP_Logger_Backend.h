@@ -1,9 +1,12 @@
 #pragma once
 
 #include "AP_Logger.h"
+#include "AP_Logger_IngestQueue.h"
 
 #include <AP_Common/Bitmask.h>
 
+#include <atomic>
+
 class LoggerMessageWriter_DFLogStart;
 
 #define MAX_LOG_FILES 500
@@ -150,9 +153,9 @@ public:
     // Returns true if the FMT message has ever been written.
     bool Write_Emit_FMT(uint8_t msg_type);
 
-    // write a log message out to the log of msg_type type, with
-    // values contained in arg_list:
-    bool Write(uint8_t msg_type, va_list arg_list, bool is_critical=false, bool is_streaming=false);
+    // write a log message out to the log using the already-resolved
+    // format f, with values contained in arg_list:
+    bool Write(const AP_Logger::log_write_fmt *f, va_list arg_list, bool is_critical=false, bool is_streaming=false);
 
     // these methods are used when reporting system status over mavlink
     virtual bool logging_enabled() const;
@@ -201,13 +204,17 @@ protected:
 
     uint32_t _dropped;
     uint32_t _log_file_size_bytes;
+
+    // lock-free staging for writes made while another thread holds
+    // the ring buffer lock; only allocated by backends which use it
+    AP_Logger_IngestQueue _ingest;
     // should we rotate when we next stop logging
     bool _rotate_pending;
 
     // must be called when a new log is being started:
     virtual void start_new_log_reset_variables();
     // convert between log numbering in storage and normalized numbering
-    uint16_t log_num_from_list_entry(const uint16_t list_entry);
+    virtual uint16_t log_num_from_list_entry(const uint16_t list_entry);
 
     uint32_t critical_message_reserved_space(uint32_t bufsize) const {
         // possibly make this a proportional to buffer size?
@@ -235,6 +242,7 @@ protected:
     bool _initialised;
 
     void df_stats_gather(uint16_t bytes_written, uint32_t space_remaining);
+    void df_stats_compress(uint16_t raw_bytes, uint16_t compressed_bytes, uint32_t time_us);
     void df_stats_log();
     void df_stats_clear();
 
@@ -251,6 +259,13 @@ private:
     };
     struct df_stats stats;
 
+    // compression statistics are gathered by the IO thread
+    struct {
+        std::atomic<uint32_t> raw_bytes{0};
+        std::atomic<uint32_t> out_bytes{0};
+        std::atomic<uint32_t> time_us{0};
+    } compress_stats;
+
     uint32_t _last_periodic_1Hz;
     uint32_t _last_periodic_10Hz;
     bool have_logged_armed;
@@ -40,6 +40,15 @@ void AP_Logger_Block::Init(void)
         // reserve space for version in last sector
         df_NumPages -= df_PagePerBlock;
 
+#if HAL_LOGGER_BLOCK_ERASE_COUNTS_ENABLED
+        // one counter per block including the reserved one
+        erase_counts_len = df_NumPages / df_PagePerBlock + 1;
+        erase_counts = new uint16_t[erase_counts_len];
+        if (erase_counts == nullptr) {
+            erase_counts_len = 0;
+        }
+#endif
+
         // determine and limit file backend buffersize
         uint32_t bufsize = _front._params.file_bufsize;
         if (bufsize > 64) {
@@ -88,6 +97,10 @@ void AP_Logger_Block::FinishWrite(void)
 {
     // Write Buffer to flash
     BufferToPage(df_PageAdr);
+    block_stats.pages++;
+    if (get_block(df_PageAdr) == erased_block) {
+        erased_block = NO_BLOCK;
+    }
     df_PageAdr++;
 
     // If we reach the end of the memory, start from the beginning
@@ -97,6 +110,10 @@ void AP_Logger_Block::FinishWrite(void)
 
     // when starting a new sector, erase it
     if ((df_PageAdr-1) % df_PagePerBlock == 0) {
+        // already erased by erase_ahead() or a chip erase
+        if (get_block(df_PageAdr) == erased_block) {
+            return;
+        }
         // if we have wrapped over an existing log, force the oldest to be recalculated
         if (_cached_oldest_log > 0) {
             uint16_t log_num = StartRead(df_PageAdr);
@@ -109,8 +126,63 @@ void AP_Logger_Block::FinishWrite(void)
             chip_full = true;
             return;
         }
-        SectorErase(get_block(df_PageAdr));
+        erase_block(get_block(df_PageAdr));
+    }
+}
+
+void AP_Logger_Block::erase_block(uint32_t block)
+{
+    SectorErase(block);
+    note_erase(block);
+}
+
+// record an erase of all or part of a block
+void AP_Logger_Block::note_erase(uint32_t block)
+{
+    block_stats.erases++;
+#if HAL_LOGGER_BLOCK_ERASE_COUNTS_ENABLED
+    if (block < erase_counts_len && erase_counts[block] < UINT16_MAX) {
+        erase_counts[block]++;
+    }
+#endif
+}
+
+/*
+  erase the block after the current one while the writer is idle, so
+  that crossing into it does not stall with log data queued behind a
+  block erase. Only done in the last quarter of the current block to
+  avoid discarding the oldest log data earlier than needed
+ */
+void AP_Logger_Block::erase_ahead(void)
+{
+    if (erased_block != NO_BLOCK || chip_full || df_PageAdr == 0) {
+        return;
+    }
+    const uint32_t pages_left = df_PagePerBlock - ((df_PageAdr - 1) % df_PagePerBlock);
+    if (pages_left > df_PagePerBlock / 4) {
+        return;
+    }
+    // as in FinishWrite(), never erase a block with our own headers in it
+    if (df_Write_FilePage + pages_left - 1 > df_NumPages - df_PagePerBlock) {
+        return;
+    }
+    if (Busy()) {
+        return;
+    }
+    uint32_t next_page = df_PageAdr + pages_left;
+    if (next_page > df_NumPages) {
+        next_page = 1;
+    }
+    // if we are wrapping over an existing log, force the oldest to be recalculated
+    if (_cached_oldest_log > 0) {
+        uint16_t log_num = StartRead(next_page);
+        if (log_num != 0xFFFF && log_num >= _cached_oldest_log) {
+            _cached_oldest_log = 0;
+        }
     }
+    erase_block(get_block(next_page));
+    erased_block = get_block(next_page);
+    block_stats.erases_ahead++;
 }
 
 bool AP_Logger_Block::WritesOK() const
@@ -299,14 +371,28 @@ void AP_Logger_Block::EraseAll()
 
     // reset the format version and wrapped status so that any incomplete erase will be caught
     Sector4kErase(get_sector(df_NumPages));
+    note_erase(get_block(df_NumPages));
 
     StartErase();
+    erased_block = NO_BLOCK;
+#if HAL_LOGGER_BLOCK_ERASE_COUNTS_ENABLED
+    for (uint32_t i=0; i<erase_counts_len; i++) {
+        if (erase_counts[i] < UINT16_MAX) {
+            erase_counts[i]++;
+        }
+    }
+#endif
+    block_stats.erases += df_NumPages / df_PagePerBlock + 1;
 }
 
 void AP_Logger_Block::periodic_1Hz()
 {
     AP_Logger_Backend::periodic_1Hz();
 
+    if (_initialised) {
+        Write_Block_Stats();
+    }
+
     if (rate_limiter == nullptr && (_front._params.blk_ratemax > 0 || _front._log_pause)) {
         // setup rate limiting if log rate max > 0Hz or log pause of streaming entries is requested
         rate_limiter = new AP_Logger_RateLimiter(_front, _front._params.blk_ratemax);
@@ -332,6 +418,40 @@ void AP_Logger_Block::periodic_1Hz()
     }
 }
 
+// log the block writer statistics for the last period
+void AP_Logger_Block::Write_Block_Stats(void)
+{
+    const uint32_t now_us = AP_HAL::micros();
+    const uint32_t dt_us = now_us - block_stats_last_us;
+    const uint32_t pages = block_stats.pages - block_stats_last.pages;
+
+    uint16_t erase_min = 0;
+    uint16_t erase_max = 0;
+#if HAL_LOGGER_BLOCK_ERASE_COUNTS_ENABLED
+    for (uint32_t i=0; i<erase_counts_len; i++) {
+        if (i == 0 || erase_counts[i] < erase_min) {
+            erase_min = erase_counts[i];
+        }
+        erase_max = MAX(erase_max, erase_counts[i]);
+    }
+#endif
+
+    const struct log_DSB pkt {
+        LOG_PACKET_HEADER_INIT(LOG_DF_BLOCK_STATS),
+        time_us         : AP_HAL::micros64(),
+        page_rate       : (block_stats_last_us != 0 && dt_us > 0) ? (pages * 1.0e6f / dt_us) : 0,
+        stall_us        : block_stats.stall_us - block_stats_last.stall_us,
+        erases          : uint16_t(block_stats.erases - block_stats_last.erases),
+        erases_ahead    : uint16_t(block_stats.erases_ahead - block_stats_last.erases_ahead),
+        erase_min       : erase_min,
+        erase_max       : erase_max,
+    };
+    WriteBlock(&pkt, sizeof(pkt));
+
+    block_stats_last = block_stats;
+    block_stats_last_us = now_us;
+}
+
 // EraseAll is asynchronous, but we must not start a new
 // log in a child thread so this task picks up the hint from the io timer
 // keeping locking to a minimum
@@ -834,7 +954,8 @@ bool AP_Logger_Block::io_thread_alive() const
   The IO timer runs every 1ms or at 1Khz. The standard flash chip can write roughly 130Kb/s
   so there is little point in trying to write more than 130 bytes - or 1 page (256 bytes).
   The W25Q128FV datasheet gives tpp as typically 0.7ms yielding an absolute maximum rate of
-  365Kb/s or just over a page per cycle.
+  365Kb/s or just over a page per cycle. Pages are only programmed while the chip is ready, so a
+  program or erase in progress never blocks this thread.
  */
 void AP_Logger_Block::io_timer(void)
 {
@@ -852,6 +973,10 @@ void AP_Logger_Block::io_timer(void)
         if (InErase()) {
             return;
         }
+        // the whole chip is now erased, so don't erase the first
+        // block again when the format page write wraps to it
+        erased_block = 0;
+
         // write the logging format in the last page
         StartWrite(df_NumPages+1);
         uint32_t version = DF_LOGGING_FORMAT;
@@ -874,13 +999,14 @@ void AP_Logger_Block::io_timer(void)
         const uint32_t aligned_sector = sectors - (((df_NumPages - df_EraseFrom + 1) / df_PagePerSector) / sectors_in_block) * sectors_in_block;
         while (next_sector < aligned_sector) {
             Sector4kErase(next_sector);
+            note_erase(next_sector / sectors_in_block);
             io_timer_heartbeat = AP_HAL::millis();
             next_sector++;
         }
         uint16_t blocks_erased = 0;
         while (next_sector < sectors) {
             blocks_erased++;
-            SectorErase(next_sector / sectors_in_block);
+            erase_block(next_sector / sectors_in_block);
             io_timer_heartbeat = AP_HAL::millis();
             next_sector += sectors_in_block;
         }
@@ -900,16 +1026,49 @@ void AP_Logger_Block::io_timer(void)
 
         // complete writing any previous log, a page at a time to avoid holding the lock for too long
         if (writebuf.available()) {
-            write_log_page();
+            if (!Busy()) {
+                write_log_page();
+            }
         } else {
             writebuf.clear();
             stop_log_pending = false;
         }
 
-    // write at most one page
     } else if (writebuf.available() >= df_PageSize - sizeof(struct PageHeader)) {
         WITH_SEMAPHORE(sem);
 
+        write_log_pages();
+
+    // nothing to write, get the next block ready
+    } else if (log_write_started) {
+        WITH_SEMAPHORE(sem);
+
+        erase_ahead();
+    }
+}
+
+/*
+  write full pages for as long as the chip is ready for them, never
+  waiting on a program or erase in progress. Ticks where data was
+  queued behind a busy chip are accumulated as stall time
+ */
+void AP_Logger_Block::write_log_pages()
+{
+    const uint32_t pagesize = df_PageSize - sizeof(struct PageHeader);
+    for (uint8_t i=0; i<HAL_LOGGER_BLOCK_MAX_PAGES_PER_TICK; i++) {
+        if (chip_full || writebuf.available() < pagesize) {
+            break;
+        }
+        if (Busy()) {
+            if (i == 0 && stall_start_us == 0) {
+                stall_start_us = AP_HAL::micros();
+            }
+            break;
+        }
+        if (stall_start_us != 0) {
+            block_stats.stall_us += AP_HAL::micros() - stall_start_us;
+            stall_start_us = 0;
+        }
         write_log_page();
     }
 }
@@ -9,6 +9,18 @@
 
 #define BLOCK_LOG_VALIDATE 0
 
+// maximum number of pages programmed in a single io_timer call. Pages are
+// only programmed while the chip reports ready, so this just bounds the time
+// spent catching up after an erase
+#ifndef HAL_LOGGER_BLOCK_MAX_PAGES_PER_TICK
+#define HAL_LOGGER_BLOCK_MAX_PAGES_PER_TICK 4
+#endif
+
+// per-block erase counters, costs 2 bytes per erase block
+#ifndef HAL_LOGGER_BLOCK_ERASE_COUNTS_ENABLED
+#define HAL_LOGGER_BLOCK_ERASE_COUNTS_ENABLED (HAL_MEM_CLASS >= HAL_MEM_CLASS_500)
+#endif
+
 class AP_Logger_Block : public AP_Logger_Backend {
 public:
     AP_Logger_Block(AP_Logger &front, LoggerMessageWriter_DFLogStart *writer);
@@ -74,6 +86,8 @@ private:
     virtual void Sector4kErase(uint32_t SectorAdr) = 0;
     virtual void StartErase() = 0;
     virtual bool InErase() = 0;
+    // true while a program or erase is in progress, must not block
+    virtual bool Busy() = 0;
     void         flash_test(void);
 
     struct PACKED PageHeader {
@@ -122,6 +136,24 @@ private:
     volatile uint32_t io_timer_heartbeat;
     uint8_t warning_decimation_counter;
 
+    // block already erased ahead of the write pointer, or NO_BLOCK
+    static const uint32_t NO_BLOCK = UINT32_MAX;
+    uint32_t erased_block = NO_BLOCK;
+
+    // writer statistics, updated on the IO thread and only read elsewhere
+    struct {
+        uint32_t pages;
+        uint32_t stall_us;
+        uint32_t erases;
+        uint32_t erases_ahead;
+    } block_stats, block_stats_last;
+    uint32_t block_stats_last_us;
+    uint32_t stall_start_us;
+#if HAL_LOGGER_BLOCK_ERASE_COUNTS_ENABLED
+    uint16_t *erase_counts = nullptr;
+    uint32_t erase_counts_len;
+#endif
+
     volatile enum class StatusMessage {
         NONE,
         ERASE_COMPLETE,
@@ -148,6 +180,11 @@ private:
     bool is_wrapped(void);
     void StartWrite(uint32_t PageAdr);
     void FinishWrite(void);
+    // erase one block on behalf of the writer, recording wear
+    void erase_block(uint32_t block);
+    void note_erase(uint32_t block);
+    void erase_ahead(void);
+    void Write_Block_Stats(void);
 
     // Read methods
     bool ReadBlock(void *pBuffer, uint16_t size);
@@ -161,6 +198,7 @@ private:
     // callback on IO thread
     bool io_thread_alive() const;
     void write_log_page();
+    void write_log_pages();
 };
 
 #endif  // HAL_LOGGING_BLOCK_ENABLED
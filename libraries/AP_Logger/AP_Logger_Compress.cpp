@@ -0,0 +1,385 @@
+#include "AP_Logger_Compress.h"
+
+#if HAL_LOGGER_FILE_COMPRESSION_ENABLED
+
+#include <AP_Filesystem/AP_Filesystem.h>
+#include <AP_Math/crc.h>
+#include <string.h>
+
+// LZ4 block format limits: the last match must start at least
+// MFLIMIT bytes before the end and the last LASTLITERALS bytes are
+// always literals
+#define LZ_MINMATCH 4
+#define LZ_MFLIMIT 12
+#define LZ_LASTLITERALS 5
+#define LZ_MAX_OFFSET 65535
+
+static inline uint32_t read32(const uint8_t *p)
+{
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline uint16_t lz_hash(uint32_t v)
+{
+    return (v * 2654435761U) >> (32 - LOG_COMPRESS_HASH_BITS);
+}
+
+// write an LZ4 length extension; returns false if out of space
+static inline bool put_length(uint8_t *&op, const uint8_t *oend, uint32_t len)
+{
+    while (len >= 255) {
+        if (op >= oend) {
+            return false;
+        }
+        *op++ = 255;
+        len -= 255;
+    }
+    if (op >= oend) {
+        return false;
+    }
+    *op++ = len;
+    return true;
+}
+
+// emit literals from anchor and (optionally) a match; returns false if out of space
+static bool put_sequence(uint8_t *&op, const uint8_t *oend,
+                         const uint8_t *anchor, uint32_t lit_len,
+                         uint16_t offset, uint32_t match_len)
+{
+    if (op >= oend) {
+        return false;
+    }
+    uint8_t *token = op++;
+    *token = MIN(lit_len, 15U) << 4;
+    if (lit_len >= 15 && !put_length(op, oend, lit_len - 15)) {
+        return false;
+    }
+    if (op + lit_len > oend) {
+        return false;
+    }
+    memcpy(op, anchor, lit_len);
+    op += lit_len;
+    if (match_len == 0) {
+        // final literals
+        return true;
+    }
+    if (op + 2 > oend) {
+        return false;
+    }
+    *op++ = offset & 0xFF;
+    *op++ = offset >> 8;
+    const uint32_t ml = match_len - LZ_MINMATCH;
+    *token |= MIN(ml, 15U);
+    if (ml >= 15 && !put_length(op, oend, ml - 15)) {
+        return false;
+    }
+    return true;
+}
+
+uint16_t AP_Logger_Compress::compress(const uint8_t *src, uint16_t len, uint8_t *dst, uint16_t dst_max, uint16_t *table)
+{
+    uint8_t *op = dst;
+    const uint8_t *oend = dst + dst_max;
+    uint32_t anchor = 0;
+
+    if (len > LZ_MFLIMIT) {
+        memset(table, 0, sizeof(table[0]) << LOG_COMPRESS_HASH_BITS);
+        const uint32_t match_start_limit = len - LZ_MFLIMIT;
+        const uint32_t match_end_limit = len - LZ_LASTLITERALS;
+        uint32_t ip = 0;
+        while (ip < match_start_limit) {
+            const uint32_t seq = read32(&src[ip]);
+            const uint16_t h = lz_hash(seq);
+            const uint32_t ref = table[h];
+            table[h] = ip;
+            if (ref >= ip || ip - ref > LZ_MAX_OFFSET || read32(&src[ref]) != seq) {
+                ip++;
+                continue;
+            }
+            uint32_t match_len = LZ_MINMATCH;
+            while (ip + match_len < match_end_limit && src[ref + match_len] == src[ip + match_len]) {
+                match_len++;
+            }
+            if (!put_sequence(op, oend, &src[anchor], ip - anchor, ip - ref, match_len)) {
+                return 0;
+            }
+            ip += match_len;
+            anchor = ip;
+        }
+    }
+
+    if (!put_sequence(op, oend, &src[anchor], len - anchor, 0, 0)) {
+        return 0;
+    }
+    return op - dst;
+}
+
+int32_t AP_Logger_Compress::decompress(const uint8_t *src, uint16_t len, uint8_t *dst, uint16_t dst_max)
+{
+    const uint8_t *ip = src;
+    const uint8_t *iend = src + len;
+    uint8_t *op = dst;
+    const uint8_t *oend = dst + dst_max;
+
+    while (ip < iend) {
+        const uint8_t token = *ip++;
+        uint32_t lit_len = token >> 4;
+        if (lit_len == 15) {
+            uint8_t b;
+            do {
+                if (ip >= iend) {
+                    return -1;
+                }
+                b = *ip++;
+                lit_len += b;
+            } while (b == 255);
+        }
+        if (lit_len > uint32_t(iend - ip) || lit_len > uint32_t(oend - op)) {
+            return -1;
+        }
+        memcpy(op, ip, lit_len);
+        ip += lit_len;
+        op += lit_len;
+        if (ip == iend) {
+            // final literals
+            break;
+        }
+        if (iend - ip < 2) {
+            return -1;
+        }
+        const uint16_t offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > op - dst) {
+            return -1;
+        }
+        uint32_t match_len = token & 0x0F;
+        if (match_len == 15) {
+            uint8_t b;
+            do {
+                if (ip >= iend) {
+                    return -1;
+                }
+                b = *ip++;
+                match_len += b;
+            } while (b == 255);
+        }
+        match_len += LZ_MINMATCH;
+        if (match_len > uint32_t(oend - op)) {
+            return -1;
+        }
+        // matches may overlap their own output
+        const uint8_t *match = op - offset;
+        while (match_len--) {
+            *op++ = *match++;
+        }
+    }
+    return op - dst;
+}
+
+static uint16_t block_crc(const log_compress_block_header &hdr, const uint8_t *payload)
+{
+    const uint16_t crc = crc16_ccitt((const uint8_t *)&hdr, offsetof(log_compress_block_header, crc), 0);
+    return crc16_ccitt(payload, hdr.data_len, crc);
+}
+
+uint16_t AP_Logger_Compress::encode_block(const uint8_t *raw, uint16_t len, uint8_t *out, uint16_t *table)
+{
+    log_compress_block_header hdr;
+    uint8_t *payload = out + sizeof(hdr);
+    hdr.magic = LOG_COMPRESS_BLOCK_MAGIC;
+    hdr.raw_len = len;
+    // only keep the compressed form if it is smaller
+    hdr.data_len = compress(raw, len, payload, len > 0 ? len - 1 : 0, table);
+    if (hdr.data_len == 0) {
+        memcpy(payload, raw, len);
+        hdr.data_len = len;
+    }
+    hdr.crc = block_crc(hdr, payload);
+    memcpy(out, &hdr, sizeof(hdr));
+    return sizeof(hdr) + hdr.data_len;
+}
+
+bool AP_Logger_Compress::block_valid(const log_compress_block_header &hdr, const uint8_t *payload)
+{
+    return hdr.magic == LOG_COMPRESS_BLOCK_MAGIC &&
+        hdr.raw_len <= LOG_COMPRESS_BLOCK_MAX &&
+        hdr.data_len <= hdr.raw_len &&
+        block_crc(hdr, payload) == hdr.crc;
+}
+
+void AP_Logger_Compress::fill_file_header(log_compress_file_header &hdr)
+{
+    memset(&hdr, 0, sizeof(hdr));
+    memcpy(hdr.magic, LOG_COMPRESS_FILE_MAGIC, sizeof(hdr.magic));
+    hdr.version = LOG_COMPRESS_VERSION;
+}
+
+AP_Logger_CompressedReader::~AP_Logger_CompressedReader()
+{
+    delete[] _block;
+    delete[] _payload;
+}
+
+bool AP_Logger_CompressedReader::check_file_header(int fd)
+{
+    log_compress_file_header hdr;
+    if (AP::FS().lseek(fd, 0, SEEK_SET) == (off_t)-1) {
+        return false;
+    }
+    if (AP::FS().read(fd, &hdr, sizeof(hdr)) != sizeof(hdr) ||
+        memcmp(hdr.magic, LOG_COMPRESS_FILE_MAGIC, sizeof(hdr.magic)) != 0 ||
+        hdr.version != LOG_COMPRESS_VERSION) {
+        AP::FS().lseek(fd, 0, SEEK_SET);
+        return false;
+    }
+    return true;
+}
+
+bool AP_Logger_CompressedReader::read_block_header(int fd, uint32_t ofs, log_compress_block_header &hdr)
+{
+    return AP::FS().lseek(fd, ofs, SEEK_SET) != (off_t)-1 &&
+        AP::FS().read(fd, &hdr, sizeof(hdr)) == sizeof(hdr) &&
+        hdr.magic == LOG_COMPRESS_BLOCK_MAGIC &&
+        hdr.raw_len <= LOG_COMPRESS_BLOCK_MAX &&
+        hdr.data_len <= hdr.raw_len;
+}
+
+bool AP_Logger_CompressedReader::open(int fd)
+{
+    close();
+    if (!check_file_header(fd)) {
+        return false;
+    }
+    if (_block == nullptr) {
+        _block = new uint8_t[LOG_COMPRESS_BLOCK_MAX];
+    }
+    if (_payload == nullptr) {
+        _payload = new uint8_t[LOG_COMPRESS_BLOCK_MAX];
+    }
+    if (_block == nullptr || _payload == nullptr) {
+        AP::FS().lseek(fd, 0, SEEK_SET);
+        return false;
+    }
+    _fd = fd;
+    rewind();
+    return true;
+}
+
+void AP_Logger_CompressedReader::close()
+{
+    _fd = -1;
+}
+
+void AP_Logger_CompressedReader::rewind()
+{
+    _block_len = 0;
+    _block_ofs = 0;
+    _block_start = 0;
+    _next_block_start = 0;
+    _next_file_ofs = sizeof(log_compress_file_header);
+}
+
+bool AP_Logger_CompressedReader::next_block()
+{
+    log_compress_block_header hdr;
+    if (!read_block_header(_fd, _next_file_ofs, hdr)) {
+        return false;
+    }
+    if (AP::FS().read(_fd, _payload, hdr.data_len) != hdr.data_len ||
+        !AP_Logger_Compress::block_valid(hdr, _payload)) {
+        // torn or corrupt block, treat as end of log
+        return false;
+    }
+    if (hdr.data_len == hdr.raw_len) {
+        memcpy(_block, _payload, hdr.raw_len);
+    } else if (AP_Logger_Compress::decompress(_payload, hdr.data_len, _block, LOG_COMPRESS_BLOCK_MAX) != hdr.raw_len) {
+        return false;
+    }
+    _block_start = _next_block_start;
+    _block_len = hdr.raw_len;
+    _block_ofs = 0;
+    _next_block_start += hdr.raw_len;
+    _next_file_ofs += sizeof(hdr) + hdr.data_len;
+    return true;
+}
+
+int32_t AP_Logger_CompressedReader::read(uint8_t *data, uint32_t len)
+{
+    if (_fd == -1) {
+        return -1;
+    }
+    uint32_t ret = 0;
+    while (ret < len) {
+        if (_block_ofs >= _block_len) {
+            if (!next_block()) {
+                break;
+            }
+            continue;
+        }
+        const uint32_t n = MIN(len - ret, uint32_t(_block_len - _block_ofs));
+        memcpy(&data[ret], &_block[_block_ofs], n);
+        _block_ofs += n;
+        ret += n;
+    }
+    return ret;
+}
+
+bool AP_Logger_CompressedReader::seek(uint32_t ofs)
+{
+    if (_fd == -1) {
+        return false;
+    }
+    if (ofs >= _block_start && ofs < _block_start + _block_len) {
+        _block_ofs = ofs - _block_start;
+        return true;
+    }
+    if (ofs < _block_start) {
+        rewind();
+    }
+    // skip blocks which must end before ofs using just their
+    // headers, then decode the one containing ofs
+    while (_next_block_start + LOG_COMPRESS_BLOCK_MAX <= ofs) {
+        log_compress_block_header hdr;
+        if (!read_block_header(_fd, _next_file_ofs, hdr)) {
+            return false;
+        }
+        _next_block_start += hdr.raw_len;
+        _next_file_ofs += sizeof(hdr) + hdr.data_len;
+    }
+    _block_len = 0;
+    _block_ofs = 0;
+    while (_next_block_start <= ofs) {
+        if (!next_block()) {
+            return false;
+        }
+        if (ofs < _block_start + _block_len) {
+            _block_ofs = ofs - _block_start;
+            return true;
+        }
+    }
+    return false;
+}
+
+int64_t AP_Logger_CompressedReader::decoded_size(int fd)
+{
+    if (!check_file_header(fd)) {
+        return -1;
+    }
+    const int32_t file_size = AP::FS().lseek(fd, 0, SEEK_END);
+    uint32_t file_ofs = sizeof(log_compress_file_header);
+    int64_t ret = 0;
+    log_compress_block_header hdr;
+    while (read_block_header(fd, file_ofs, hdr)) {
+        file_ofs += sizeof(hdr) + hdr.data_len;
+        if (file_size < 0 || file_ofs > uint32_t(file_size)) {
+            // a final block cut short by a crash is not counted
+            break;
+        }
+        ret += hdr.raw_len;
+    }
+    return ret;
+}
+
+#endif // HAL_LOGGER_FILE_COMPRESSION_ENABLED
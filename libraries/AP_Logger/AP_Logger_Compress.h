@@ -0,0 +1,112 @@
+/*
+  block compression for file logs
+
+  A compressed log starts with a log_compress_file_header followed by
+  a sequence of independently decodable blocks, each preceded by a
+  log_compress_block_header. Block payloads use the LZ4 block format;
+  a block which does not compress is stored verbatim. Each block
+  carries a CRC so a reader stops cleanly at a block torn by a crash
+  or power loss, losing at most that block.
+ */
+#pragma once
+
+#include "AP_Logger.h"
+
+#if HAL_LOGGER_FILE_COMPRESSION_ENABLED
+
+#define LOG_COMPRESS_FILE_MAGIC "APLZ"
+#define LOG_COMPRESS_VERSION 1
+#define LOG_COMPRESS_BLOCK_MAGIC 0x5A4C
+// maximum decoded size of a block
+#define LOG_COMPRESS_BLOCK_MAX 4096
+// compressor hash table entries
+#define LOG_COMPRESS_HASH_BITS 12
+
+struct PACKED log_compress_file_header {
+    char magic[4];
+    uint8_t version;
+    uint8_t reserved[3];
+};
+
+struct PACKED log_compress_block_header {
+    uint16_t magic;
+    uint16_t raw_len;
+    uint16_t data_len;  // equal to raw_len if stored uncompressed
+    uint16_t crc;       // over the preceding header fields and payload
+};
+
+namespace AP_Logger_Compress {
+
+/*
+  compress len bytes from src into the LZ4 block format in dst.
+  Returns compressed length, or 0 if the data would not fit in
+  dst_max bytes. table must have (1U<<LOG_COMPRESS_HASH_BITS) entries
+ */
+uint16_t compress(const uint8_t *src, uint16_t len, uint8_t *dst, uint16_t dst_max, uint16_t *table);
+
+/*
+  decompress an LZ4 block. Returns decoded length, or -1 if the
+  input is malformed or would overflow dst_max bytes
+ */
+int32_t decompress(const uint8_t *src, uint16_t len, uint8_t *dst, uint16_t dst_max);
+
+/*
+  build a complete block (header + payload) for raw data into out,
+  which must hold sizeof(log_compress_block_header) + len bytes.
+  Returns the number of bytes in the block
+ */
+uint16_t encode_block(const uint8_t *raw, uint16_t len, uint8_t *out, uint16_t *table);
+
+// check a block header and payload; returns true if the CRC matches
+bool block_valid(const log_compress_block_header &hdr, const uint8_t *payload);
+
+void fill_file_header(log_compress_file_header &hdr);
+
+}
+
+/*
+  sequential reader for compressed logs, with seeking by decoded
+  offset. Used by the log download path and by Replay
+ */
+class AP_Logger_CompressedReader {
+public:
+    ~AP_Logger_CompressedReader();
+
+    // check the file header on fd; returns true if the file is a
+    // compressed log. If not, fd is left positioned at the start
+    bool open(int fd);
+
+    void close();
+
+    bool is_open() const { return _fd != -1; }
+
+    // read up to len decoded bytes, returning the number read, 0 at
+    // the end of the log (including a torn final block) or -1 on error
+    int32_t read(uint8_t *data, uint32_t len);
+
+    // position the reader at decoded offset ofs
+    bool seek(uint32_t ofs);
+
+    // decoded size of the log open on fd, found by walking the block
+    // headers, or -1 if fd is not a compressed log
+    static int64_t decoded_size(int fd);
+
+private:
+    int _fd = -1;
+    uint8_t *_block = nullptr;
+    uint8_t *_payload = nullptr;
+    uint16_t _block_len;
+    uint16_t _block_ofs;
+    uint32_t _block_start;      // decoded offset of _block[0]
+    uint32_t _next_block_start; // decoded offset of the next block
+    uint32_t _next_file_ofs;    // file offset of the next block header
+
+    void rewind();
+    // read and decode the next block; returns false at end of log
+    bool next_block();
+    // read the header of the block at file offset ofs
+    static bool read_block_header(int fd, uint32_t ofs, log_compress_block_header &hdr);
+    static bool check_file_header(int fd);
+};
+
+#endif // HAL_LOGGER_FILE_COMPRESSION_ENABLED
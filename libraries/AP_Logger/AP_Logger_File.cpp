@@ -86,6 +86,12 @@ void AP_Logger_File::Init()
 
     DEV_PRINTF("AP_Logger_File: buffer size=%u\n", (unsigned)bufsize);
 
+#if HAL_LOGGER_INGEST_QUEUE_SLOTS > 0 && !APM_BUILD_TYPE(APM_BUILD_Replay)
+    if (!_ingest.init(HAL_LOGGER_INGEST_QUEUE_SLOTS)) {
+        DEV_PRINTF("AP_Logger_File: no staging queue\n");
+    }
+#endif
+
     _initialised = true;
 
     const char* custom_dir = hal.util->get_custom_log_directory();
@@ -339,6 +345,9 @@ void AP_Logger_File::Prep_MinSpace()
                 }
             } else {
                 free(filename_to_remove);
+#if HAL_LOGGER_FILE_CATALOG_ENABLED
+                _catalog.forget(log_to_remove);
+#endif
             }
         }
         log_to_remove++;
@@ -346,6 +355,9 @@ void AP_Logger_File::Prep_MinSpace()
             log_to_remove = 1;
         }
     } while (log_to_remove != first_log_to_remove);
+
+    // the oldest log may have been removed
+    _cached_oldest_log = 0;
 }
 
 /*
@@ -408,6 +420,87 @@ char *AP_Logger_File::_lastlog_file_name(void) const
     return buf;
 }
 
+#if HAL_LOGGER_FILE_CATALOG_ENABLED
+/*
+  return path name of the log catalog
+  Note: Caller must free.
+ */
+char *AP_Logger_File::_catalog_file_name(void) const
+{
+    char *buf = nullptr;
+    if (asprintf(&buf, "%s/LOGINDEX.DAT", _log_directory) == -1) {
+        return nullptr;
+    }
+    return buf;
+}
+
+/*
+  load the catalog on first use, dropping entries for logs which have
+  been removed since it was saved
+ */
+bool AP_Logger_File::catalog_ready()
+{
+    if (_catalog.loaded()) {
+        return true;
+    }
+    char *fname = _catalog_file_name();
+    if (fname == nullptr) {
+        return false;
+    }
+    const bool ok = _catalog.load(fname);
+    free(fname);
+    if (!ok) {
+        return false;
+    }
+
+    Bitmask<MAX_LOG_FILES> present;
+    EXPECT_DELAY_MS(3000);
+    auto *d = AP::FS().opendir(_log_directory);
+    if (d != nullptr) {
+        for (struct dirent *de=AP::FS().readdir(d); de; de=AP::FS().readdir(d)) {
+            EXPECT_DELAY_MS(100);
+            uint16_t thisnum;
+            if (dirent_to_log_num(de, thisnum) && thisnum > 0) {
+                present.set(thisnum-1);
+            }
+        }
+        AP::FS().closedir(d);
+    }
+    _catalog.set_present(present);
+    return true;
+}
+
+/*
+  record the log we have just closed so that listing it doesn't need
+  to look at the file
+ */
+void AP_Logger_File::catalog_log_closed()
+{
+    uint64_t utc_usec;
+    if (!AP::rtc().get_utc_usec(utc_usec) || !catalog_ready()) {
+        // filled in from the file when next listed
+        return;
+    }
+    uint32_t size = _write_offset;
+#if HAL_LOGGER_FILE_COMPRESSION_ENABLED
+    if (compressing()) {
+        size = _compress.raw_written;
+    }
+#endif
+    _catalog.update(_write_log_num, size, utc_usec / 1000000U);
+}
+
+void AP_Logger_File::catalog_save()
+{
+    char *fname = _catalog_file_name();
+    if (fname == nullptr) {
+        return;
+    }
+    _catalog.save(fname);
+    free(fname);
+}
+#endif // HAL_LOGGER_FILE_CATALOG_ENABLED
+
 
 // remove all log files
 void AP_Logger_File::EraseAll()
@@ -454,6 +547,34 @@ bool AP_Logger_File::StartNewLogOK() const
 /* Write a block of data at current offset */
 bool AP_Logger_File::_WritePrioritisedBlock(const void *pBuffer, uint16_t size, bool is_critical)
 {
+#if !APM_BUILD_TYPE(APM_BUILD_Replay)
+    if (_ingest.enabled() && size <= AP_Logger_IngestQueue::MAX_MESSAGE_SIZE &&
+        _startup_messagewriter->fmt_done() && !_writing_startup_messages) {
+        // don't make the caller wait for another writer; if the lock
+        // is busy, or messages staged by other threads are still
+        // waiting, stage this one too so per-thread order is kept
+        if (semaphore.take_nonblocking()) {
+            drain_ingest_queue();
+            if (_ingest.empty()) {
+                const bool ret = write_to_buffer(pBuffer, size, is_critical);
+                semaphore.give();
+                return ret;
+            }
+            semaphore.give();
+        }
+        if (_ingest.push(pBuffer, size, is_critical)) {
+            return true;
+        }
+        if (!is_critical) {
+            // counted in the queue's drop count, folded into _dropped
+            // when the queue is next drained
+            return false;
+        }
+        // critical messages must not be lost to a full staging
+        // queue; fall through and wait for the lock
+    }
+#endif
+
     WITH_SEMAPHORE(semaphore);
 
     if (! WriteBlockCheckStartupMessages()) {
@@ -468,7 +589,16 @@ bool AP_Logger_File::_WritePrioritisedBlock(const void *pBuffer, uint16_t size,
     return true;
 #endif
 
+    drain_ingest_queue();
+    return write_to_buffer(pBuffer, size, is_critical);
+}
 
+/*
+  copy a message into the ring buffer, applying the reservations
+  for critical and startup messages. Caller must hold semaphore
+ */
+bool AP_Logger_File::write_to_buffer(const void *pBuffer, uint16_t size, bool is_critical)
+{
     uint32_t space = _writebuf.space();
 
     if (_writing_startup_messages &&
@@ -504,6 +634,23 @@ bool AP_Logger_File::_WritePrioritisedBlock(const void *pBuffer, uint16_t size,
     return true;
 }
 
+/*
+  move messages staged by writers which found the lock busy into the
+  ring buffer, oldest first. Caller must hold semaphore
+ */
+void AP_Logger_File::drain_ingest_queue()
+{
+    _dropped += _ingest.take_new_drops();
+
+    uint16_t size;
+    bool is_critical;
+    const uint8_t *msg;
+    while ((msg = _ingest.peek(size, is_critical)) != nullptr) {
+        write_to_buffer(msg, size, is_critical);
+        _ingest.pop();
+    }
+}
+
 /*
   find the highest log number
  */
@@ -549,6 +696,41 @@ uint32_t AP_Logger_File::_get_log_size(const uint16_t log_num)
     return st.st_size;
 }
 
+/*
+  size of a log as seen by a downloader; compressed logs are
+  downloaded decompressed. Listing goes through the catalog, so each
+  closed log is only opened here once
+ */
+uint32_t AP_Logger_File::_get_log_size_decoded(const uint16_t log_num)
+{
+    const uint32_t size = _get_log_size(log_num);
+#if HAL_LOGGER_FILE_COMPRESSION_ENABLED
+    if (size == 0) {
+        return 0;
+    }
+    if (_write_fd != -1 && log_num == _write_log_num) {
+        // we know how the log being written is stored
+        return compressing() ? _compress.raw_written : size;
+    }
+    char *fname = _log_file_name(log_num);
+    if (fname == nullptr) {
+        return size;
+    }
+    EXPECT_DELAY_MS(3000);
+    const int fd = AP::FS().open(fname, O_RDONLY);
+    free(fname);
+    if (fd == -1) {
+        return size;
+    }
+    // only the file header is read for an uncompressed log
+    const int64_t decoded_size = AP_Logger_CompressedReader::decoded_size(fd);
+    AP::FS().close(fd);
+    return decoded_size >= 0 ? decoded_size : size;
+#else
+    return size;
+#endif
+}
+
 uint32_t AP_Logger_File::_get_log_time(const uint16_t log_num)
 {
     char *fname = _log_file_name(log_num);
@@ -591,8 +773,10 @@ void AP_Logger_File::get_log_boundaries(const uint16_t list_entry, uint32_t & st
         return;
     }
 
+    uint32_t size, time_utc;
+    _get_log_info(log_num, size, time_utc);
     start_page = 0;
-    end_page = _get_log_size(log_num) / LOGGER_PAGE_SIZE;
+    end_page = size / LOGGER_PAGE_SIZE;
 }
 
 /*
@@ -630,14 +814,81 @@ int16_t AP_Logger_File::get_log_data(const uint16_t list_entry, const uint16_t p
             DEV_PRINTF("Log read open fail for %s - %s\n",
                                 fname, strerror(saved_errno));
             free(fname);
+#if HAL_LOGGER_FILE_CATALOG_ENABLED
+            _catalog.forget(log_num);
+#endif
             return -1;            
         }
         free(fname);
         _read_offset = 0;
         _read_fd_log_num = log_num;
+#if HAL_LOGGER_FILE_COMPRESSION_ENABLED
+        // compressed logs are sent decompressed
+        _compressed_reader.open(_read_fd);
+#endif
+#if HAL_LOGGER_READ_AHEAD_SIZE > 0
+        _read_ahead.len = 0;
+        _read_ahead.eof = false;
+#endif
     }
     uint32_t ofs = page * (uint32_t)LOGGER_PAGE_SIZE + offset;
 
+#if HAL_LOGGER_READ_AHEAD_SIZE > 0
+    /*
+      serve LOG_DATA sized requests from a buffer filled with large
+      reads, which is much cheaper than a filesystem read per packet
+      and absorbs the small backwards seeks of a GCS filling gaps
+     */
+    if (_read_ahead.buf == nullptr) {
+        _read_ahead.buf = new uint8_t[HAL_LOGGER_READ_AHEAD_SIZE];
+    }
+    if (_read_ahead.buf != nullptr) {
+        const uint32_t end = _read_ahead.ofs + _read_ahead.len;
+        // only the log being written can grow after its end is read
+        const uint32_t write_size = (_write_fd != -1 && log_num == _write_log_num) ? _write_offset : 0;
+        if (ofs < _read_ahead.ofs || ofs > end ||
+            (ofs + len > end && (!_read_ahead.eof || write_size != _read_ahead.file_size))) {
+            _read_ahead.file_size = write_size;
+            const int32_t ret = _read_log_data(ofs, _read_ahead.buf, HAL_LOGGER_READ_AHEAD_SIZE);
+            if (ret < 0) {
+                _read_ahead.len = 0;
+                _read_ahead.eof = false;
+                return ret;
+            }
+            _read_ahead.ofs = ofs;
+            _read_ahead.len = ret;
+            _read_ahead.eof = ret < HAL_LOGGER_READ_AHEAD_SIZE;
+        }
+        const uint16_t n = MIN(uint32_t(len), _read_ahead.ofs + _read_ahead.len - ofs);
+        memcpy(data, &_read_ahead.buf[ofs - _read_ahead.ofs], n);
+        return n;
+    }
+#endif
+
+    return _read_log_data(ofs, data, len);
+}
+
+/*
+  read from the open log at an offset as seen by a downloader
+ */
+int32_t AP_Logger_File::_read_log_data(uint32_t ofs, uint8_t *data, uint32_t len)
+{
+#if HAL_LOGGER_FILE_COMPRESSION_ENABLED
+    if (_compressed_reader.is_open()) {
+        if (ofs != _read_offset) {
+            if (!_compressed_reader.seek(ofs)) {
+                return 0;
+            }
+            _read_offset = ofs;
+        }
+        const int32_t ret = _compressed_reader.read(data, len);
+        if (ret > 0) {
+            _read_offset += ret;
+        }
+        return ret;
+    }
+#endif
+
     if (ofs != _read_offset) {
         if (AP::FS().lseek(_read_fd, ofs, SEEK_SET) == (off_t)-1) {
             AP::FS().close(_read_fd);
@@ -646,7 +897,7 @@ int16_t AP_Logger_File::get_log_data(const uint16_t list_entry, const uint16_t p
         }
         _read_offset = ofs;
     }
-    int16_t ret = (int16_t)AP::FS().read(_read_fd, data, len);
+    const int32_t ret = AP::FS().read(_read_fd, data, len);
     if (ret > 0) {
         _read_offset += ret;
     }
@@ -666,16 +917,58 @@ void AP_Logger_File::get_log_info(const uint16_t list_entry, uint32_t &size, uin
         return;
     }
 
-    size = _get_log_size(log_num);
+    _get_log_info(log_num, size, time_utc);
+}
+
+/*
+  size and time of a log, from the catalog if it is there
+ */
+void AP_Logger_File::_get_log_info(const uint16_t log_num, uint32_t &size, uint32_t &time_utc)
+{
+#if HAL_LOGGER_FILE_CATALOG_ENABLED
+    // the log being written keeps changing
+    const bool cacheable = !(_write_fd != -1 && log_num == _write_log_num);
+    if (cacheable && catalog_ready() && _catalog.lookup(log_num, size, time_utc)) {
+        return;
+    }
+#endif
+    size = _get_log_size_decoded(log_num);
     time_utc = _get_log_time(log_num);
+#if HAL_LOGGER_FILE_CATALOG_ENABLED
+    if (cacheable) {
+        _catalog.update(log_num, size, time_utc);
+    }
+#endif
 }
 
 
+#if HAL_LOGGER_FILE_CATALOG_ENABLED
+/*
+  the catalog knows which logs exist, so logs which have been removed
+  from the middle of the sequence are not listed
+ */
+uint16_t AP_Logger_File::log_num_from_list_entry(const uint16_t list_entry)
+{
+    if (!catalog_ready()) {
+        return AP_Logger_Backend::log_num_from_list_entry(list_entry);
+    }
+    return _catalog.log_num_from_list_entry(find_oldest_log(), list_entry);
+}
+#endif
+
 /*
   get the number of logs - note that the log numbers must be consecutive
+  unless the catalog is available
  */
 uint16_t AP_Logger_File::get_num_logs()
 {
+#if HAL_LOGGER_FILE_CATALOG_ENABLED
+    // with log sizes and times also coming from the catalog a list
+    // request needs no directory scan
+    if (catalog_ready()) {
+        return _catalog.num_logs();
+    }
+#endif
     auto *d = AP::FS().opendir(_log_directory);
     if (d == nullptr) {
         return 0;
@@ -716,6 +1009,9 @@ void AP_Logger_File::stop_logging(void)
         int fd = _write_fd;
         _write_fd = -1;
         AP::FS().close(fd);
+#if HAL_LOGGER_FILE_CATALOG_ENABLED
+        catalog_log_closed();
+#endif
     }
     if (have_sem) {
         write_fd_semaphore.give();
@@ -814,6 +1110,7 @@ void AP_Logger_File::start_new_log(void)
         write_fd_semaphore.give();
         return;
     }
+    _write_log_num = log_num;
 
 #if CONFIG_HAL_BOARD == HAL_BOARD_CHIBIOS
     // remember if we had utc time when we opened the file
@@ -843,8 +1140,34 @@ void AP_Logger_File::start_new_log(void)
     _open_error_ms = 0;
     _write_offset = 0;
     _writebuf.clear();
+#if HAL_LOGGER_FILE_COMPRESSION_ENABLED
+    if (!start_compressed_log()) {
+        AP::FS().close(_write_fd);
+        _write_fd = -1;
+        write_fd_semaphore.give();
+        _open_error_ms = AP_HAL::millis();
+        return;
+    }
+#endif
     write_fd_semaphore.give();
 
+    {
+        // staged messages belong to the old log
+        WITH_SEMAPHORE(semaphore);
+        _ingest.clear();
+    }
+
+#if HAL_LOGGER_FILE_CATALOG_ENABLED
+    // make sure a saved catalog never describes the log this number
+    // used to refer to
+    if (catalog_ready()) {
+        _catalog.log_created(log_num);
+        if (_catalog.dirty()) {
+            catalog_save();
+        }
+    }
+#endif
+
     // now update lastlog.txt with the new log number
     char *fname = _lastlog_file_name();
 
@@ -876,7 +1199,8 @@ void AP_Logger_File::flush(void)
 #if APM_BUILD_TYPE(APM_BUILD_Replay) || APM_BUILD_TYPE(APM_BUILD_UNKNOWN)
 {
     uint32_t tnow = AP_HAL::millis();
-    while (_write_fd != -1 && _initialised && !recent_open_error() && _writebuf.available()) {
+    while (_write_fd != -1 && _initialised && !recent_open_error() &&
+           (_writebuf.available() || !_ingest.empty() || compressed_frame_pending())) {
         // convince the IO timer that it really is OK to write out
         // less than _writebuf_chunk bytes:
         if (tnow > 2001) { // avoid resetting _last_write_time to 0
@@ -916,15 +1240,31 @@ void AP_Logger_File::io_timer(void)
         return;
     }
 
+#if HAL_LOGGER_FILE_CATALOG_ENABLED
+    // save the catalog once it stops changing, e.g. after a list
+    if (_catalog.dirty() && tnow - _catalog.last_change_ms() > 1000) {
+        last_io_operation = "catalog";
+        catalog_save();
+        last_io_operation = "";
+    }
+#endif
+
     if (_write_fd == -1 || !_initialised || recent_open_error()) {
         return;
     }
 
+    // pick up messages staged while writers were contending for the
+    // lock; if a writer holds the lock it will drain them itself
+    if (!_ingest.empty() && semaphore.take_nonblocking()) {
+        drain_ingest_queue();
+        semaphore.give();
+    }
+
     uint32_t nbytes = _writebuf.available();
-    if (nbytes == 0) {
+    if (nbytes == 0 && !compressed_frame_pending()) {
         return;
     }
-    if (nbytes < _writebuf_chunk && 
+    if (nbytes < _writebuf_chunk && !compressed_frame_pending() &&
         tnow - _last_write_time < 2000UL) {
         // write in _writebuf_chunk-sized chunks, but always write at
         // least once per 2 seconds if data is available
@@ -953,8 +1293,12 @@ void AP_Logger_File::io_timer(void)
     const uint8_t *head = _writebuf.readptr(size);
     nbytes = MIN(nbytes, size);
 
-    // try to align writes on a 512 byte boundary to avoid filesystem reads
-    if ((nbytes + _write_offset) % 512 != 0) {
+    if (compressing()) {
+        // compressed blocks are written whole; the file offset no
+        // longer tracks the raw stream so don't try to align
+        next_compressed_frame(head, nbytes);
+    } else if ((nbytes + _write_offset) % 512 != 0) {
+        // try to align writes on a 512 byte boundary to avoid filesystem reads
         uint32_t ofs = (nbytes + _write_offset) % 512;
         if (ofs < nbytes) {
             nbytes -= ofs;
@@ -987,7 +1331,11 @@ void AP_Logger_File::io_timer(void)
         _last_write_failed = false;
         _last_write_ms = tnow;
         _write_offset += nwritten;
-        _writebuf.advance(nwritten);
+        if (compressing()) {
+            compressed_frame_written(nwritten);
+        } else {
+            _writebuf.advance(nwritten);
+        }
         /*
           the best strategy for minimizing corruption on microSD cards
           seems to be to write in 4k chunks and fsync the file on each
@@ -1016,6 +1364,71 @@ void AP_Logger_File::io_timer(void)
     write_fd_semaphore.give();
 }
 
+#if HAL_LOGGER_FILE_COMPRESSION_ENABLED
+/*
+  if compression is enabled write the file header for a newly opened
+  log. Returns false if the log could not be set up
+ */
+bool AP_Logger_File::start_compressed_log()
+{
+    _compress.active = false;
+    _compress.frame_len = 0;
+    _compress.frame_ofs = 0;
+    _compress.raw_written = 0;
+    if (_front._params.file_compress == 0 ||
+        APM_BUILD_TYPE(APM_BUILD_Replay)) {
+        // Replay writes straight to the file, bypassing the io_timer
+        return true;
+    }
+    if (_compress.table == nullptr) {
+        _compress.table = new uint16_t[1U<<LOG_COMPRESS_HASH_BITS];
+    }
+    if (_compress.frame == nullptr) {
+        _compress.frame = new uint8_t[sizeof(log_compress_block_header) + LOG_COMPRESS_BLOCK_MAX];
+    }
+    if (_compress.table == nullptr || _compress.frame == nullptr) {
+        // not enough memory, log uncompressed
+        return true;
+    }
+    log_compress_file_header hdr;
+    AP_Logger_Compress::fill_file_header(hdr);
+    if (AP::FS().write(_write_fd, &hdr, sizeof(hdr)) != sizeof(hdr)) {
+        return false;
+    }
+    _write_offset = sizeof(hdr);
+    _compress.active = true;
+    return true;
+}
+
+/*
+  return the next piece of compressed data to write, encoding a new
+  block from the ring buffer if the previous one has been written
+ */
+void AP_Logger_File::next_compressed_frame(const uint8_t *&head, uint32_t &nbytes)
+{
+    if (!compressed_frame_pending()) {
+        const uint16_t raw_len = MIN(nbytes, uint32_t(LOG_COMPRESS_BLOCK_MAX));
+        const uint32_t start_us = AP_HAL::micros();
+        _compress.frame_len = AP_Logger_Compress::encode_block(head, raw_len, _compress.frame, _compress.table);
+        _compress.frame_ofs = 0;
+        _compress.frame_raw_len = raw_len;
+        df_stats_compress(raw_len, _compress.frame_len, AP_HAL::micros() - start_us);
+        // the raw data now lives in the frame
+        _writebuf.advance(raw_len);
+    }
+    head = &_compress.frame[_compress.frame_ofs];
+    nbytes = _compress.frame_len - _compress.frame_ofs;
+}
+
+void AP_Logger_File::compressed_frame_written(uint32_t nbytes)
+{
+    _compress.frame_ofs += nbytes;
+    if (!compressed_frame_pending()) {
+        _compress.raw_written += _compress.frame_raw_len;
+    }
+}
+#endif // HAL_LOGGER_FILE_COMPRESSION_ENABLED
+
 bool AP_Logger_File::io_thread_alive() const
 {
     if (!hal.scheduler->is_system_initialized()) {
@@ -1085,6 +1498,15 @@ void AP_Logger_File::erase_next(void)
         free(fname);
     }
 
+#if HAL_LOGGER_FILE_CATALOG_ENABLED
+    fname = _catalog_file_name();
+    if (fname != nullptr) {
+        AP::FS().unlink(fname);
+        free(fname);
+    }
+    _catalog.clear();
+#endif
+
     _cached_oldest_log = 0;
 
     erase.log_num = 0;
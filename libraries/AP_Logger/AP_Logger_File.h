@@ -10,6 +10,8 @@
 
 #include <AP_HAL/utility/RingBuffer.h>
 #include "AP_Logger_Backend.h"
+#include "AP_Logger_Compress.h"
+#include "AP_Logger_FileCatalog.h"
 
 #if HAL_LOGGING_FILESYSTEM_ENABLED
 
@@ -17,6 +19,18 @@
 #define HAL_LOGGER_WRITE_CHUNK_SIZE 4096
 #endif
 
+// size of the buffer log downloads are read through, 0 to read each
+// LOG_DATA packet from the file directly
+#ifndef HAL_LOGGER_READ_AHEAD_SIZE
+#define HAL_LOGGER_READ_AHEAD_SIZE (HAL_MEM_CLASS >= HAL_MEM_CLASS_500 ? 4096 : 0)
+#endif
+
+// the catalog keeps the decoded size of compressed logs so listing
+// doesn't decode every log
+#if HAL_LOGGER_FILE_COMPRESSION_ENABLED && !HAL_LOGGER_FILE_CATALOG_ENABLED
+#error "HAL_LOGGER_FILE_COMPRESSION_ENABLED requires HAL_LOGGER_FILE_CATALOG_ENABLED"
+#endif
+
 class AP_Logger_File : public AP_Logger_Backend
 {
 public:
@@ -78,6 +92,7 @@ private:
     int _read_fd = -1;
     uint16_t _read_fd_log_num;
     uint32_t _read_offset;
+    uint16_t _write_log_num;
     uint32_t _write_offset;
     volatile uint32_t _open_error_ms;
     const char *_log_directory;
@@ -104,6 +119,32 @@ private:
 
     // write buffer
     ByteBuffer _writebuf{0};
+    bool write_to_buffer(const void *pBuffer, uint16_t size, bool is_critical);
+    void drain_ingest_queue();
+
+#if HAL_LOGGER_FILE_COMPRESSION_ENABLED
+    // block compression of the log being written
+    struct {
+        bool active;            // current log is compressed
+        uint16_t *table;        // compressor hash table
+        uint8_t *frame;         // encoded block being written out
+        uint16_t frame_len;
+        uint16_t frame_ofs;     // bytes of frame already written
+        uint16_t frame_raw_len; // raw bytes encoded in frame
+        uint32_t raw_written;   // raw bytes in completed frames
+    } _compress;
+    AP_Logger_CompressedReader _compressed_reader;
+    bool start_compressed_log();
+    bool compressing() const { return _compress.active; }
+    bool compressed_frame_pending() const { return _compress.frame_ofs < _compress.frame_len; }
+    void next_compressed_frame(const uint8_t *&head, uint32_t &nbytes);
+    void compressed_frame_written(uint32_t nbytes);
+#else
+    bool compressing() const { return false; }
+    bool compressed_frame_pending() const { return false; }
+    void next_compressed_frame(const uint8_t *&head, uint32_t &nbytes) {}
+    void compressed_frame_written(uint32_t nbytes) {}
+#endif
     const uint16_t _writebuf_chunk = HAL_LOGGER_WRITE_CHUNK_SIZE;
     uint32_t _last_write_time;
 
@@ -113,7 +154,30 @@ private:
     char *_log_file_name_short(const uint16_t log_num) const;
     char *_lastlog_file_name() const;
     uint32_t _get_log_size(const uint16_t log_num);
+    uint32_t _get_log_size_decoded(const uint16_t log_num);
     uint32_t _get_log_time(const uint16_t log_num);
+    void _get_log_info(const uint16_t log_num, uint32_t &size, uint32_t &time_utc);
+    int32_t _read_log_data(uint32_t ofs, uint8_t *data, uint32_t len);
+
+#if HAL_LOGGER_READ_AHEAD_SIZE > 0
+    // buffered data of the log being downloaded
+    struct {
+        uint8_t *buf;
+        uint32_t ofs;   // offset in the log of buf[0]
+        uint16_t len;
+        bool eof;       // buf ends at the end of the log
+        uint32_t file_size; // size of the log being written when buf was read
+    } _read_ahead;
+#endif
+
+#if HAL_LOGGER_FILE_CATALOG_ENABLED
+    AP_Logger_FileCatalog _catalog;
+    char *_catalog_file_name() const;
+    bool catalog_ready();
+    void catalog_log_closed();
+    void catalog_save();
+    uint16_t log_num_from_list_entry(const uint16_t list_entry) override;
+#endif
 
     void stop_logging(void) override;
 
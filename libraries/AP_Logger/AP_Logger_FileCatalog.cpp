@@ -0,0 +1,196 @@
+#include "AP_Logger_FileCatalog.h"
+
+#if HAL_LOGGER_FILE_CATALOG_ENABLED
+
+#include <AP_Filesystem/AP_Filesystem.h>
+#include <AP_Math/crc.h>
+#include <string.h>
+
+bool AP_Logger_FileCatalog::load(const char *fname)
+{
+    WITH_SEMAPHORE(_sem);
+
+    if (_entries != nullptr) {
+        // already loaded by another thread
+        return true;
+    }
+    _entries = new entry[MAX_LOG_FILES];
+    if (_entries == nullptr) {
+        return false;
+    }
+    memset(_entries, 0, MAX_LOG_FILES * sizeof(entry));
+
+    EXPECT_DELAY_MS(3000);
+    const int fd = AP::FS().open(fname, O_RDONLY);
+    if (fd == -1) {
+        return true;
+    }
+    file_header hdr;
+    uint16_t file_crc;
+    const ssize_t entries_len = MAX_LOG_FILES * sizeof(entry);
+    const bool ok = AP::FS().read(fd, &hdr, sizeof(hdr)) == sizeof(hdr) &&
+        hdr.magic == LOG_CATALOG_MAGIC &&
+        hdr.version == LOG_CATALOG_VERSION &&
+        hdr.num_entries == MAX_LOG_FILES &&
+        AP::FS().read(fd, _entries, entries_len) == entries_len &&
+        AP::FS().read(fd, &file_crc, sizeof(file_crc)) == sizeof(file_crc) &&
+        file_crc == crc(hdr);
+    AP::FS().close(fd);
+    if (!ok) {
+        // rebuilt on demand
+        memset(_entries, 0, MAX_LOG_FILES * sizeof(entry));
+    }
+    return true;
+}
+
+void AP_Logger_FileCatalog::set_present(const Bitmask<MAX_LOG_FILES> &present)
+{
+    WITH_SEMAPHORE(_sem);
+
+    if (_entries == nullptr) {
+        return;
+    }
+    _present = present;
+    for (uint16_t i=0; i<MAX_LOG_FILES; i++) {
+        if (_entries[i].size != 0 && !_present.get(i)) {
+            _entries[i] = {};
+            changed();
+        }
+    }
+}
+
+void AP_Logger_FileCatalog::log_created(uint16_t log_num)
+{
+    forget(log_num);
+
+    WITH_SEMAPHORE(_sem);
+    if (log_num >= 1) {
+        _present.set(log_num-1);
+    }
+}
+
+uint16_t AP_Logger_FileCatalog::num_logs()
+{
+    WITH_SEMAPHORE(_sem);
+
+    return _present.count();
+}
+
+uint16_t AP_Logger_FileCatalog::log_num_from_list_entry(uint16_t oldest_log, uint16_t list_entry)
+{
+    WITH_SEMAPHORE(_sem);
+
+    if (oldest_log < 1 || oldest_log > MAX_LOG_FILES || list_entry == 0) {
+        return 0;
+    }
+    // logs are listed in order from the oldest, wrapping at
+    // MAX_LOG_FILES, skipping any which have been removed
+    uint16_t log_num = oldest_log;
+    for (uint16_t i=0; i<MAX_LOG_FILES; i++) {
+        if (_present.get(log_num-1) && --list_entry == 0) {
+            return log_num;
+        }
+        log_num = log_num % MAX_LOG_FILES + 1;
+    }
+    return 0;
+}
+
+bool AP_Logger_FileCatalog::lookup(uint16_t log_num, uint32_t &size, uint32_t &time_utc)
+{
+    WITH_SEMAPHORE(_sem);
+
+    if (_entries == nullptr || log_num < 1 || log_num > MAX_LOG_FILES) {
+        return false;
+    }
+    const entry &e = _entries[log_num-1];
+    if (e.size == 0) {
+        return false;
+    }
+    size = e.size;
+    time_utc = e.time_utc;
+    return true;
+}
+
+void AP_Logger_FileCatalog::update(uint16_t log_num, uint32_t size, uint32_t time_utc)
+{
+    WITH_SEMAPHORE(_sem);
+
+    if (_entries == nullptr || log_num < 1 || log_num > MAX_LOG_FILES) {
+        return;
+    }
+    entry &e = _entries[log_num-1];
+    if (e.size != size || e.time_utc != time_utc) {
+        e.size = size;
+        e.time_utc = time_utc;
+        changed();
+    }
+}
+
+void AP_Logger_FileCatalog::forget(uint16_t log_num)
+{
+    update(log_num, 0, 0);
+
+    WITH_SEMAPHORE(_sem);
+    if (log_num >= 1) {
+        _present.clear(log_num-1);
+    }
+}
+
+void AP_Logger_FileCatalog::clear()
+{
+    WITH_SEMAPHORE(_sem);
+
+    if (_entries == nullptr) {
+        return;
+    }
+    memset(_entries, 0, MAX_LOG_FILES * sizeof(entry));
+    _present.clearall();
+    _dirty = false;
+}
+
+void AP_Logger_FileCatalog::changed()
+{
+    _dirty = true;
+    _last_change_ms = AP_HAL::millis();
+}
+
+uint16_t AP_Logger_FileCatalog::crc(const file_header &hdr) const
+{
+    const uint16_t c = crc16_ccitt((const uint8_t *)&hdr, sizeof(hdr), 0xFFFF);
+    return crc16_ccitt((const uint8_t *)_entries, MAX_LOG_FILES * sizeof(entry), c);
+}
+
+bool AP_Logger_FileCatalog::save(const char *fname)
+{
+    WITH_SEMAPHORE(_sem);
+
+    if (_entries == nullptr) {
+        return false;
+    }
+    const file_header hdr {
+        LOG_CATALOG_MAGIC,
+        LOG_CATALOG_VERSION,
+        MAX_LOG_FILES
+    };
+    const uint16_t file_crc = crc(hdr);
+
+    EXPECT_DELAY_MS(3000);
+    const int fd = AP::FS().open(fname, O_WRONLY|O_CREAT|O_TRUNC);
+    if (fd == -1) {
+        return false;
+    }
+    const ssize_t entries_len = MAX_LOG_FILES * sizeof(entry);
+    const bool ok = AP::FS().write(fd, &hdr, sizeof(hdr)) == sizeof(hdr) &&
+        AP::FS().write(fd, _entries, entries_len) == entries_len &&
+        AP::FS().write(fd, &file_crc, sizeof(file_crc)) == sizeof(file_crc);
+    AP::FS().close(fd);
+    if (ok) {
+        _dirty = false;
+    } else {
+        // try again later rather than on every call
+        _last_change_ms = AP_HAL::millis();
+    }
+    return ok;
+}
+
+#endif // HAL_LOGGER_FILE_CATALOG_ENABLED
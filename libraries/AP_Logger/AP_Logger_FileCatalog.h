@@ -0,0 +1,79 @@
+/*
+  catalog of closed file logs
+
+  Keeps the size and time of each closed log so that a log list
+  request can be answered without a stat() (and, for compressed logs,
+  a full decode) of every log file. The catalog is saved to a file in
+  the log directory so it persists across boots; a missing, stale or
+  corrupt catalog file only costs rebuilding entries on demand.
+ */
+#pragma once
+
+#include "AP_Logger.h"
+
+#ifndef HAL_LOGGER_FILE_CATALOG_ENABLED
+#define HAL_LOGGER_FILE_CATALOG_ENABLED (HAL_LOGGING_FILESYSTEM_ENABLED && HAL_MEM_CLASS >= HAL_MEM_CLASS_500)
+#endif
+
+#if HAL_LOGGER_FILE_CATALOG_ENABLED
+
+#include "AP_Logger_Backend.h"
+
+#define LOG_CATALOG_MAGIC 0x5441434CUL // "LCAT"
+#define LOG_CATALOG_VERSION 1
+
+class AP_Logger_FileCatalog {
+public:
+    // allocate the catalog and load it from fname if present, doing
+    // nothing if already loaded. Returns false if out of memory
+    bool load(const char *fname);
+    bool loaded() const { return _entries != nullptr; }
+
+    // record which logs exist, indexed by log number - 1, dropping
+    // entries for logs which don't
+    void set_present(const Bitmask<MAX_LOG_FILES> &present);
+
+    // a log has been created, replacing any log of the same number
+    void log_created(uint16_t log_num);
+
+    // number of logs which exist, and the log number of the
+    // list_entry'th of them counting from oldest_log
+    uint16_t num_logs();
+    uint16_t log_num_from_list_entry(uint16_t oldest_log, uint16_t list_entry);
+
+    // size as downloaded and UTC time of a log; returns false if the
+    // log is not in the catalog
+    bool lookup(uint16_t log_num, uint32_t &size, uint32_t &time_utc);
+    void update(uint16_t log_num, uint32_t size, uint32_t time_utc);
+    // a log has been removed
+    void forget(uint16_t log_num);
+    // all logs have been removed
+    void clear();
+
+    // true if the catalog has changed and not been saved
+    bool dirty() const { return _dirty; }
+    uint32_t last_change_ms() const { return _last_change_ms; }
+    bool save(const char *fname);
+
+private:
+    struct PACKED entry {
+        uint32_t size;      // zero if unknown
+        uint32_t time_utc;
+    };
+    struct PACKED file_header {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t num_entries;
+    };
+
+    entry *_entries = nullptr;
+    Bitmask<MAX_LOG_FILES> _present;
+    bool _dirty;
+    uint32_t _last_change_ms;
+    HAL_Semaphore _sem;
+
+    void changed();
+    uint16_t crc(const file_header &hdr) const;
+};
+
+#endif // HAL_LOGGER_FILE_CATALOG_ENABLED
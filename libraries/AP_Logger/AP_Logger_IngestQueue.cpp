@@ -0,0 +1,118 @@
+#include "AP_Logger_IngestQueue.h"
+
+#include <AP_Math/AP_Math.h>
+#include <string.h>
+
+bool AP_Logger_IngestQueue::init(uint16_t nslots)
+{
+    if (nslots == 0 || (nslots & (nslots-1)) != 0) {
+        return false;
+    }
+    slots = new Slot[nslots];
+    if (slots == nullptr) {
+        return false;
+    }
+    for (uint16_t i=0; i<nslots; i++) {
+        slots[i].seq.store(i, std::memory_order_relaxed);
+    }
+    mask = nslots - 1;
+    return true;
+}
+
+bool AP_Logger_IngestQueue::push(const void *pBuffer, uint16_t size, bool is_critical)
+{
+    if (slots == nullptr) {
+        return false;
+    }
+    if (size > sizeof(Slot::data)) {
+        drops.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    const uint8_t e = epoch.load(std::memory_order_relaxed);
+    uint32_t pos = enqueue_pos.load(std::memory_order_relaxed);
+    Slot *slot;
+    while (true) {
+        slot = &slots[pos & mask];
+        const uint32_t seq = slot->seq.load(std::memory_order_acquire);
+        const int32_t dif = int32_t(seq - pos);
+        if (dif == 0) {
+            if (enqueue_pos.compare_exchange_weak(pos, pos+1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (dif < 0) {
+            // consumer has not yet freed this slot; queue is full
+            drops.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            pos = enqueue_pos.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->epoch = e;
+    slot->is_critical = is_critical;
+    slot->size = size;
+    memcpy(slot->data, pBuffer, size);
+    slot->seq.store(pos+1, std::memory_order_release);
+    staged.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+const uint8_t *AP_Logger_IngestQueue::peek(uint16_t &size, bool &is_critical)
+{
+    if (slots == nullptr) {
+        return nullptr;
+    }
+    const uint32_t pos = dequeue_pos.load(std::memory_order_relaxed);
+    const uint32_t depth = enqueue_pos.load(std::memory_order_relaxed) - pos;
+    if (depth > max_depth) {
+        max_depth = MIN(depth, UINT8_MAX);
+    }
+    while (true) {
+        const uint32_t dpos = dequeue_pos.load(std::memory_order_relaxed);
+        Slot &slot = slots[dpos & mask];
+        if (slot.seq.load(std::memory_order_acquire) != dpos+1) {
+            // empty, or the oldest message is still being written
+            return nullptr;
+        }
+        if (slot.epoch == epoch.load(std::memory_order_relaxed)) {
+            size = slot.size;
+            is_critical = slot.is_critical;
+            return slot.data;
+        }
+        // queued before the last clear()
+        pop();
+    }
+}
+
+void AP_Logger_IngestQueue::pop()
+{
+    const uint32_t dpos = dequeue_pos.load(std::memory_order_relaxed);
+    Slot &slot = slots[dpos & mask];
+    slot.seq.store(dpos + mask + 1, std::memory_order_release);
+    dequeue_pos.store(dpos + 1, std::memory_order_release);
+}
+
+void AP_Logger_IngestQueue::clear()
+{
+    epoch.fetch_add(1, std::memory_order_relaxed);
+    uint16_t size;
+    bool is_critical;
+    while (peek(size, is_critical) != nullptr) {
+        pop();
+    }
+}
+
+uint32_t AP_Logger_IngestQueue::take_new_drops()
+{
+    const uint32_t n = drops.load(std::memory_order_relaxed);
+    const uint32_t ret = n - drops_reported;
+    drops_reported = n;
+    return ret;
+}
+
+uint8_t AP_Logger_IngestQueue::take_max_depth()
+{
+    const uint8_t ret = max_depth;
+    max_depth = 0;
+    return ret;
+}
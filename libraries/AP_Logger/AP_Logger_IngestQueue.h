@@ -0,0 +1,97 @@
+/*
+  lock-free multi-producer, single-consumer staging queue for log
+  messages.
+
+  Threads which find a backend's ring buffer lock held by another
+  writer push their message here instead of blocking. The queue is
+  drained into the ring buffer by whichever thread next holds the
+  lock, so a writer never waits on another writer.
+
+  Slots are fixed size and claimed with a compare-and-swap on the
+  enqueue position (a bounded queue with per-slot sequence numbers),
+  so a producer preempted part way through a copy never corrupts
+  another producer's message; the consumer simply stops at the first
+  slot which is not yet complete.
+ */
+#pragma once
+
+#include <AP_HAL/AP_HAL_Boards.h>
+
+#include <atomic>
+#include <stdint.h>
+
+#ifndef HAL_LOGGER_INGEST_QUEUE_SLOTS
+#if HAL_MEM_CLASS >= HAL_MEM_CLASS_500
+#define HAL_LOGGER_INGEST_QUEUE_SLOTS 16
+#else
+#define HAL_LOGGER_INGEST_QUEUE_SLOTS 0
+#endif
+#endif
+
+class AP_Logger_IngestQueue
+{
+public:
+    // allocate nslots slots; nslots must be a power of two
+    bool init(uint16_t nslots);
+
+    // true if init() has allocated the slots
+    bool enabled() const { return slots != nullptr; }
+
+    // largest message which can be queued
+    static const uint16_t MAX_MESSAGE_SIZE = UINT8_MAX;
+
+    // producer side, safe to call from any thread. Returns false if
+    // the queue is full or the message too large, in which case the
+    // message has not been queued and is counted as dropped
+    bool push(const void *pBuffer, uint16_t size, bool is_critical);
+
+    /*
+      consumer side; only one thread may consume at a time (the
+      caller must hold the lock for the destination buffer).
+
+      peek returns the oldest completed message, or nullptr if there
+      is none. Messages queued before the last clear() are skipped.
+     */
+    const uint8_t *peek(uint16_t &size, bool &is_critical);
+    void pop();
+
+    // true if no message is queued or part way through being queued.
+    // Safe to call from any thread
+    bool empty() const {
+        return enqueue_pos.load(std::memory_order_acquire) == dequeue_pos.load(std::memory_order_acquire);
+    }
+
+    // discard queued messages, e.g. when a new log is started; a
+    // message being pushed concurrently is discarded when it is peeked
+    void clear();
+
+    // statistics
+    uint32_t num_staged() const { return staged.load(std::memory_order_relaxed); }
+    uint32_t num_drops() const { return drops.load(std::memory_order_relaxed); }
+    // number of drops since the last call; used to fold the drops
+    // into the backend's dropped count from the consumer side
+    uint32_t take_new_drops();
+    // maximum depth since the last call
+    uint8_t take_max_depth();
+
+private:
+    struct Slot {
+        std::atomic<uint32_t> seq;
+        uint8_t epoch;
+        uint8_t is_critical;
+        uint8_t size;
+        uint8_t data[MAX_MESSAGE_SIZE];
+    };
+    Slot *slots = nullptr;
+    uint16_t mask;
+
+    std::atomic<uint32_t> enqueue_pos{0};
+    // only changed by the consumer, read by empty() from any thread
+    std::atomic<uint32_t> dequeue_pos{0};
+    std::atomic<uint8_t> epoch{0};
+
+    std::atomic<uint32_t> staged{0};
+    std::atomic<uint32_t> drops{0};  // messages rejected as the queue was full or they were too large
+    uint32_t drops_reported = 0;
+    uint8_t max_depth = 0;
+};
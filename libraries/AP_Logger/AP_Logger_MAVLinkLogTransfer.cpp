@@ -106,20 +106,23 @@ void AP_Logger::handle_log_request_data(GCS_MAVLINK &link, const mavlink_message
 {
     WITH_SEMAPHORE(_log_send_sem);
 
+    mavlink_log_request_data_t packet;
+    mavlink_msg_log_request_data_decode(&msg, &packet);
+
     if (_log_sending_link != nullptr) {
         // some GCS (e.g. MAVProxy) attempt to stream request_data
         // messages when they're filling gaps in the downloaded logs.
-        // This channel check avoids complaining to them, at the cost
-        // of silently dropping any repeated attempts to start logging
+        // Requests for the log being sent are queued and served once
+        // the current request completes; others are silently dropped
         if (_log_sending_link->get_chan() != link.get_chan()) {
             link.send_text(MAV_SEVERITY_INFO, "Log download in progress");
+        } else if (transfer_activity == TransferActivity::SENDING &&
+                   packet.id == _log_num_data) {
+            log_data_request_queue(packet.ofs, packet.count);
         }
         return;
     }
 
-    mavlink_log_request_data_t packet;
-    mavlink_msg_log_request_data_decode(&msg, &packet);
-
     // consider opening or switching logs:
     if (transfer_activity != TransferActivity::SENDING || _log_num_data != packet.id) {
 
@@ -139,15 +142,8 @@ void AP_Logger::handle_log_request_data(GCS_MAVLINK &link, const mavlink_message
         get_log_boundaries(packet.id, _log_data_page, end);
     }
 
-    _log_data_offset = packet.ofs;
-    if (_log_data_offset >= _log_data_size) {
-        _log_data_remaining = 0;
-    } else {
-        _log_data_remaining = _log_data_size - _log_data_offset;
-    }
-    if (_log_data_remaining > packet.count) {
-        _log_data_remaining = packet.count;
-    }
+    _log_data_queue_len = 0;
+    log_data_request_start(packet.ofs, packet.count);
 
     transfer_activity = TransferActivity::SENDING;
     _log_sending_link = &link;
@@ -177,6 +173,55 @@ void AP_Logger::handle_log_request_end(GCS_MAVLINK &link, const mavlink_message_
 
     transfer_activity = TransferActivity::IDLE;
     _log_sending_link = nullptr;
+    _log_data_queue_len = 0;
+}
+
+/**
+   set up to send count bytes of the current log from ofs
+ */
+void AP_Logger::log_data_request_start(uint32_t ofs, uint32_t count)
+{
+    _log_data_offset = ofs;
+    if (_log_data_offset >= _log_data_size) {
+        _log_data_remaining = 0;
+    } else {
+        _log_data_remaining = _log_data_size - _log_data_offset;
+    }
+    if (_log_data_remaining > count) {
+        _log_data_remaining = count;
+    }
+}
+
+/**
+   queue a request for the log being sent. Data which the current
+   request is still going to send is not queued again
+ */
+void AP_Logger::log_data_request_queue(uint32_t ofs, uint32_t count)
+{
+    if (ofs >= _log_data_size) {
+        return;
+    }
+    uint32_t end = _log_data_size;
+    if (count < end - ofs) {
+        end = ofs + count;
+    }
+    const uint32_t pending_end = _log_data_offset + _log_data_remaining;
+    if (ofs >= _log_data_offset && ofs < pending_end) {
+        if (end <= pending_end) {
+            return;
+        }
+        ofs = pending_end;
+    }
+    for (uint8_t i=0; i<_log_data_queue_len; i++) {
+        if (_log_data_queue[i].ofs == ofs && _log_data_queue[i].count == end - ofs) {
+            // GCS retrying a request we have not got to yet
+            return;
+        }
+    }
+    if (_log_data_queue_len >= ARRAY_SIZE(_log_data_queue)) {
+        return;
+    }
+    _log_data_queue[_log_data_queue_len++] = { ofs, end - ofs };
 }
 
 /**
@@ -321,8 +366,15 @@ bool AP_Logger::handle_log_send_data()
     _log_data_offset += nbytes;
     _log_data_remaining -= nbytes;
     if (nbytes < MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN || _log_data_remaining == 0) {
-        transfer_activity = TransferActivity::IDLE;
-        _log_sending_link = nullptr;
+        if (_log_data_queue_len > 0) {
+            // move on to the next queued request
+            log_data_request_start(_log_data_queue[0].ofs, _log_data_queue[0].count);
+            _log_data_queue_len--;
+            memmove(&_log_data_queue[0], &_log_data_queue[1], _log_data_queue_len * sizeof(_log_data_queue[0]));
+        } else {
+            transfer_activity = TransferActivity::IDLE;
+            _log_sending_link = nullptr;
+        }
     }
     return true;
 }
@@ -218,6 +218,22 @@ struct PACKED log_DSF {
     uint32_t buf_space_min;
     uint32_t buf_space_max;
     uint32_t buf_space_avg;
+    uint32_t staged;
+    uint32_t staged_dropped;
+    uint8_t  staged_max;
+    float    compress_ratio;
+    uint32_t compress_us;
+};
+
+struct PACKED log_DSB {
+    LOG_PACKET_HEADER;
+    uint64_t time_us;
+    float    page_rate;
+    uint32_t stall_us;
+    uint16_t erases;
+    uint16_t erases_ahead;
+    uint16_t erase_min;
+    uint16_t erase_max;
 };
 
 struct PACKED log_Event {
@@ -795,6 +811,21 @@ struct PACKED log_VER {
 // @Field: FMn: Minimum free space in write buffer in last time period
 // @Field: FMx: Maximum free space in write buffer in last time period
 // @Field: FAv: Average free space in write buffer in last time period
+// @Field: Stg: Number of writes staged because another thread was writing to the buffer
+// @Field: SDp: Number of staged writes dropped because the staging queue was full or the write was too large
+// @Field: SMx: Maximum staging queue depth in last time period
+// @Field: CRt: Compression ratio of log data written in last time period, zero if not compressing
+// @Field: CUs: Time spent compressing log data in last time period
+
+// @LoggerMessage: DSB
+// @Description: Block logger writer statistics
+// @Field: TimeUS: Time since system startup
+// @Field: PgR: Rate at which pages were programmed in last time period
+// @Field: Stl: Time log data was waiting on a busy chip in last time period
+// @Field: Er: Number of block erases in last time period
+// @Field: ErA: Number of blocks erased ahead of the write pointer in last time period
+// @Field: EMn: Lowest erase count of any block since boot
+// @Field: EMx: Highest erase count of any block since boot
 
 // @LoggerMessage: DSTL
 // @Description: Deepstall Landing data
@@ -1299,7 +1330,9 @@ LOG_STRUCTURE_FROM_HAL_CHIBIOS \
 LOG_STRUCTURE_FROM_RPM \
 LOG_STRUCTURE_FROM_FENCE \
     { LOG_DF_FILE_STATS, sizeof(log_DSF), \
-      "DSF", "QIHIIII", "TimeUS,Dp,Blk,Bytes,FMn,FMx,FAv", "s--b---", "F--0---" }, \
+      "DSF", "QIHIIIIIIBfI", "TimeUS,Dp,Blk,Bytes,FMn,FMx,FAv,Stg,SDp,SMx,CRt,CUs", "s--b-------s", "F--0-------F" }, \
+    { LOG_DF_BLOCK_STATS, sizeof(log_DSB), \
+      "DSB", "QfIHHHH", "TimeUS,PgR,Stl,Er,ErA,EMn,EMx", "szs----", "F0F----" }, \
     { LOG_RALLY_MSG, sizeof(log_Rally), \
       "RALY", "QBBLLh", "TimeUS,Tot,Seq,Lat,Lng,Alt", "s--DUm", "F--GGB" },  \
     { LOG_MAV_MSG, sizeof(log_MAV),   \
@@ -1423,6 +1456,7 @@ enum LogMessages : uint8_t {
     LOG_RCOUT2_MSG,
     LOG_RCOUT3_MSG,
     LOG_IDS_FROM_FENCE,
+    LOG_DF_BLOCK_STATS,
 
     _LOG_LAST_MSG_
 };
@@ -0,0 +1,140 @@
+/*
+ * Measure the rate at which dynamic messages can be pushed through
+ * AP_Logger::Write() by name, through a resolved handle with
+ * WriteH(), and with the compile-time packed WritePacked()
+ */
+
+#include <AP_HAL/AP_HAL.h>
+#include <AP_Logger/AP_Logger.h>
+#include <AP_Scheduler/AP_Scheduler.h>
+#include <GCS_MAVLink/GCS_Dummy.h>
+#include <stdio.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+static const struct LogStructure log_structure[] = {
+    LOG_COMMON_STRUCTURES,
+};
+
+// number of messages written between flushes; the flush time is
+// excluded from the measurement so dropped messages do not inflate
+// the rate
+#define BATCH_SIZE 50
+#define NUM_BATCHES 200
+
+// a few dummy names so the name lookup has a realistic list to walk
+static const char *const filler_names[] = {
+    "FIL0", "FIL1", "FIL2", "FIL3", "FIL4", "FIL5", "FIL6", "FIL7",
+    "FIL8", "FIL9", "FILA", "FILB", "FILC", "FILD", "FILE", "FILF",
+};
+
+// the name is compared by pointer, so use the same pointer for every call
+static const char rate_name[] = "RATE";
+#define RATE_LBL "TimeUS,A,B,C,D,I"
+#define RATE_FMT "QffffB"
+
+class AP_LoggerTest_WriteRate : public AP_HAL::HAL::Callbacks {
+public:
+    void setup() override;
+    void loop() override;
+
+private:
+
+    AP_Int32 log_bitmask;
+    AP_Logger logger{log_bitmask};
+    AP_Scheduler scheduler;
+
+    enum class Method {
+        WRITE,
+        WRITE_HANDLE,
+        WRITE_PACKED,
+    };
+    void run(const char *label, Method method);
+    void flush_logger();
+};
+
+void AP_LoggerTest_WriteRate::flush_logger()
+{
+#if CONFIG_HAL_BOARD == HAL_BOARD_SITL || CONFIG_HAL_BOARD == HAL_BOARD_LINUX
+    logger.flush();
+#else
+    hal.scheduler->delay(50);
+#endif
+}
+
+void AP_LoggerTest_WriteRate::run(const char *label, Method method)
+{
+    AP_Logger::log_write_fmt *h = logger.find_msg_handle(rate_name, RATE_LBL, RATE_FMT);
+    const uint32_t dropped_start = logger.num_dropped();
+    uint32_t total_us = 0;
+    uint32_t count = 0;
+
+    for (uint16_t b=0; b<NUM_BATCHES; b++) {
+        const uint32_t start_us = AP_HAL::micros();
+        for (uint16_t i=0; i<BATCH_SIZE; i++) {
+            const uint64_t now = AP_HAL::micros64();
+            const float a = i * 0.1f;
+            const uint8_t inst = i & 3;
+            switch (method) {
+            case Method::WRITE:
+                logger.Write(rate_name, RATE_LBL, RATE_FMT,
+                             now, (double)a, (double)(a+1), (double)(a+2), (double)(a+3), inst);
+                break;
+            case Method::WRITE_HANDLE:
+                logger.WriteH(h, now, (double)a, (double)(a+1), (double)(a+2), (double)(a+3), inst);
+                break;
+            case Method::WRITE_PACKED:
+                logger.WritePacked(h, now, a, a+1, a+2, a+3, inst);
+                break;
+            }
+        }
+        total_us += AP_HAL::micros() - start_us;
+        count += BATCH_SIZE;
+        flush_logger();
+    }
+
+    hal.console->printf("%-12s %7lu msgs %8.0f msgs/s %5.2f us/msg dropped=%lu\n",
+                        label,
+                        (unsigned long)count,
+                        (double)(count * 1.0e6f / MAX(total_us, 1U)),
+                        (double)(total_us / float(count)),
+                        (unsigned long)(logger.num_dropped() - dropped_start));
+}
+
+void AP_LoggerTest_WriteRate::setup(void)
+{
+    hal.console->printf("Logger Write rate\n");
+
+    log_bitmask.set((uint32_t)-1);
+    logger.Init(log_structure, ARRAY_SIZE(log_structure));
+    logger.set_vehicle_armed(true);
+    logger.Write_Message("AP_Logger WriteRate");
+
+    for (const char *name : filler_names) {
+        logger.Write(name, "TimeUS,V", "Qf", AP_HAL::micros64(), 0.0);
+    }
+
+    hal.scheduler->delay(20);
+
+    run("Write", Method::WRITE);
+    run("WriteH", Method::WRITE_HANDLE);
+    run("WritePacked", Method::WRITE_PACKED);
+
+    logger.StopLogging();
+
+    hal.console->printf("tests done\n");
+}
+
+void AP_LoggerTest_WriteRate::loop(void)
+{
+    hal.scheduler->delay(1000);
+}
+
+const struct AP_Param::GroupInfo        GCS_MAVLINK_Parameters::var_info[] = {
+    AP_GROUPEND
+};
+GCS_Dummy _gcs;
+
+static AP_LoggerTest_WriteRate loggertest;
+
+AP_HAL_MAIN_CALLBACKS(&loggertest);
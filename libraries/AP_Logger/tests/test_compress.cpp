@@ -0,0 +1,296 @@
+#include <AP_gtest.h>
+
+/*
+  tests for AP_Logger/AP_Logger_Compress.cpp
+ */
+
+#include <AP_Logger/AP_Logger_Compress.h>
+#include <AP_Filesystem/AP_Filesystem.h>
+#include <string.h>
+
+const AP_HAL::HAL &hal = AP_HAL::get_HAL();
+
+#if HAL_LOGGER_FILE_COMPRESSION_ENABLED
+
+#define TEST_LOG_FILE "test_compress.bin"
+
+static uint16_t table[1U<<LOG_COMPRESS_HASH_BITS];
+
+// deterministic pseudo-random bytes
+static void fill_random(uint8_t *buf, uint32_t len, uint32_t seed)
+{
+    for (uint32_t i=0; i<len; i++) {
+        seed = seed * 1664525U + 1013904223U;
+        buf[i] = seed >> 24;
+    }
+}
+
+// data which looks like a log: short repeated messages with a
+// slowly changing timestamp
+static void fill_compressible(uint8_t *buf, uint32_t len, uint32_t seed)
+{
+    static const uint8_t msg[] { 0xA3, 0x95, 0x40, 'A', 'T', 'T', 0, 0, 0x10, 0x20, 0x30, 0x40, 0x50 };
+    for (uint32_t i=0; i<len; i++) {
+        buf[i] = msg[i % sizeof(msg)];
+        if (i % sizeof(msg) == 6) {
+            buf[i] = uint8_t(seed + i / sizeof(msg));
+        }
+    }
+}
+
+static void check_round_trip(const uint8_t *src, uint16_t len)
+{
+    static uint8_t compressed[LOG_COMPRESS_BLOCK_MAX * 2];
+    static uint8_t decoded[LOG_COMPRESS_BLOCK_MAX];
+    const uint16_t clen = AP_Logger_Compress::compress(src, len, compressed, sizeof(compressed), table);
+    ASSERT_GT(clen, 0);
+    EXPECT_EQ(AP_Logger_Compress::decompress(compressed, clen, decoded, sizeof(decoded)), len);
+    EXPECT_EQ(memcmp(src, decoded, len), 0);
+
+    // the decoder must not write past a too small output buffer
+    if (len > 0) {
+        memset(decoded, 0xAA, sizeof(decoded));
+        EXPECT_EQ(AP_Logger_Compress::decompress(compressed, clen, decoded, len-1), -1);
+        EXPECT_EQ(decoded[len-1], 0xAA);
+    }
+}
+
+TEST(AP_Logger_Compress, round_trip)
+{
+    static uint8_t buf[LOG_COMPRESS_BLOCK_MAX];
+    const uint16_t sizes[] { 0, 1, 4, 12, 13, 17, 255, 256, 1000, LOG_COMPRESS_BLOCK_MAX };
+    for (const uint16_t len : sizes) {
+        fill_random(buf, len, len);
+        check_round_trip(buf, len);
+        fill_compressible(buf, len, len);
+        check_round_trip(buf, len);
+        memset(buf, 0, len);
+        check_round_trip(buf, len);
+    }
+}
+
+TEST(AP_Logger_Compress, ratio)
+{
+    static uint8_t buf[LOG_COMPRESS_BLOCK_MAX];
+    static uint8_t compressed[LOG_COMPRESS_BLOCK_MAX];
+
+    // random data doesn't fit in fewer bytes than it started with
+    fill_random(buf, sizeof(buf), 1);
+    EXPECT_EQ(AP_Logger_Compress::compress(buf, sizeof(buf), compressed, sizeof(buf)-1, table), 0);
+
+    fill_compressible(buf, sizeof(buf), 1);
+    const uint16_t clen = AP_Logger_Compress::compress(buf, sizeof(buf), compressed, sizeof(buf)-1, table);
+    EXPECT_GT(clen, 0);
+    EXPECT_LT(clen, sizeof(buf) / 2);
+}
+
+TEST(AP_Logger_Compress, block_valid)
+{
+    static uint8_t raw[1000];
+    static uint8_t block[sizeof(log_compress_block_header) + sizeof(raw)];
+    for (uint8_t compressible=0; compressible<2; compressible++) {
+        if (compressible) {
+            fill_compressible(raw, sizeof(raw), 3);
+        } else {
+            fill_random(raw, sizeof(raw), 3);
+        }
+        const uint16_t len = AP_Logger_Compress::encode_block(raw, sizeof(raw), block, table);
+        log_compress_block_header hdr;
+        memcpy(&hdr, block, sizeof(hdr));
+        EXPECT_EQ(hdr.raw_len, sizeof(raw));
+        EXPECT_EQ(hdr.data_len == hdr.raw_len, !compressible);
+        EXPECT_EQ(len, sizeof(hdr) + hdr.data_len);
+        EXPECT_TRUE(AP_Logger_Compress::block_valid(hdr, &block[sizeof(hdr)]));
+
+        // every single bit error in the header or payload is detected
+        for (uint32_t bit=0; bit<len*8U; bit++) {
+            block[bit/8] ^= 1U<<(bit%8);
+            memcpy(&hdr, block, sizeof(hdr));
+            EXPECT_FALSE(AP_Logger_Compress::block_valid(hdr, &block[sizeof(hdr)])) << "bit " << bit;
+            block[bit/8] ^= 1U<<(bit%8);
+        }
+    }
+}
+
+TEST(AP_Logger_Compress, malformed)
+{
+    static uint8_t raw[LOG_COMPRESS_BLOCK_MAX];
+    static uint8_t compressed[LOG_COMPRESS_BLOCK_MAX];
+    static uint8_t decoded[LOG_COMPRESS_BLOCK_MAX + 16];
+    fill_compressible(raw, sizeof(raw), 5);
+    const uint16_t clen = AP_Logger_Compress::compress(raw, sizeof(raw), compressed, sizeof(compressed), table);
+    ASSERT_GT(clen, 0);
+
+    // truncated input is rejected or decodes to a prefix, and never
+    // overruns the output
+    for (uint16_t len=0; len<clen; len++) {
+        memset(decoded, 0xAA, sizeof(decoded));
+        const int32_t ret = AP_Logger_Compress::decompress(compressed, len, decoded, LOG_COMPRESS_BLOCK_MAX);
+        EXPECT_LE(ret, int32_t(LOG_COMPRESS_BLOCK_MAX));
+        if (ret > 0) {
+            EXPECT_EQ(memcmp(raw, decoded, ret), 0);
+        }
+        EXPECT_EQ(decoded[LOG_COMPRESS_BLOCK_MAX], 0xAA);
+    }
+
+    // so is corrupted input
+    uint32_t seed = 7;
+    for (uint16_t i=0; i<2000; i++) {
+        static uint8_t mutated[LOG_COMPRESS_BLOCK_MAX];
+        memcpy(mutated, compressed, clen);
+        seed = seed * 1664525U + 1013904223U;
+        mutated[(seed >> 8) % clen] ^= 1U<<(seed % 8);
+        memset(decoded, 0xAA, sizeof(decoded));
+        const int32_t ret = AP_Logger_Compress::decompress(mutated, clen, decoded, LOG_COMPRESS_BLOCK_MAX);
+        EXPECT_LE(ret, int32_t(LOG_COMPRESS_BLOCK_MAX));
+        EXPECT_EQ(decoded[LOG_COMPRESS_BLOCK_MAX], 0xAA);
+    }
+}
+
+/*
+  write a compressed log of len bytes of data in blocks of block_len,
+  returning the file size
+ */
+static int32_t write_log(const uint8_t *data, uint32_t len, uint16_t block_len)
+{
+    const int fd = AP::FS().open(TEST_LOG_FILE, O_WRONLY|O_CREAT|O_TRUNC);
+    if (fd == -1) {
+        return -1;
+    }
+    log_compress_file_header fhdr;
+    AP_Logger_Compress::fill_file_header(fhdr);
+    int32_t ret = AP::FS().write(fd, &fhdr, sizeof(fhdr));
+    static uint8_t block[sizeof(log_compress_block_header) + LOG_COMPRESS_BLOCK_MAX];
+    for (uint32_t ofs=0; ofs<len; ofs+=block_len) {
+        const uint16_t n = MIN(uint32_t(block_len), len - ofs);
+        const uint16_t blen = AP_Logger_Compress::encode_block(&data[ofs], n, block, table);
+        ret += AP::FS().write(fd, block, blen);
+    }
+    AP::FS().close(fd);
+    return ret;
+}
+
+TEST(AP_Logger_CompressedReader, read_and_seek)
+{
+    static uint8_t data[50000];
+    static uint8_t buf[3000];
+    // a mix of compressible and incompressible blocks
+    fill_compressible(data, sizeof(data), 9);
+    fill_random(&data[20000], 5000, 9);
+    ASSERT_GT(write_log(data, sizeof(data), 3000), 0);
+
+    const int fd = AP::FS().open(TEST_LOG_FILE, O_RDONLY);
+    ASSERT_NE(fd, -1);
+    EXPECT_EQ(AP_Logger_CompressedReader::decoded_size(fd), int64_t(sizeof(data)));
+
+    AP_Logger_CompressedReader reader;
+    ASSERT_TRUE(reader.open(fd));
+
+    // sequential reads of a size which doesn't divide the block size
+    uint32_t ofs = 0;
+    while (true) {
+        const int32_t n = reader.read(buf, 1234);
+        ASSERT_GE(n, 0);
+        if (n == 0) {
+            break;
+        }
+        EXPECT_EQ(memcmp(buf, &data[ofs], n), 0);
+        ofs += n;
+    }
+    EXPECT_EQ(ofs, sizeof(data));
+
+    // seeks backwards, forwards, within a block, across many blocks
+    // and at block boundaries
+    const uint32_t seeks[] { 0, 2999, 3000, 3001, 45000, 100, 100, 6001, 29999, 49999, 1 };
+    for (const uint32_t s : seeks) {
+        ASSERT_TRUE(reader.seek(s)) << "seek " << s;
+        const int32_t n = reader.read(buf, sizeof(buf));
+        EXPECT_EQ(n, int32_t(MIN(uint32_t(sizeof(buf)), uint32_t(sizeof(data)) - s)));
+        EXPECT_EQ(memcmp(buf, &data[s], n), 0) << "seek " << s;
+    }
+
+    // seeking to or past the end fails
+    EXPECT_FALSE(reader.seek(sizeof(data)));
+    EXPECT_FALSE(reader.seek(sizeof(data) + 10000));
+    EXPECT_TRUE(reader.seek(10));
+    EXPECT_EQ(reader.read(buf, 1), 1);
+    EXPECT_EQ(buf[0], data[10]);
+
+    reader.close();
+    AP::FS().close(fd);
+    AP::FS().unlink(TEST_LOG_FILE);
+}
+
+TEST(AP_Logger_CompressedReader, torn_block)
+{
+    static uint8_t data[10000];
+    static uint8_t buf[sizeof(data)];
+    fill_compressible(data, sizeof(data), 11);
+    const int32_t file_size = write_log(data, sizeof(data), 4000);
+    ASSERT_GT(file_size, 0);
+
+    // cut the last block short, as a crash while writing would
+    int fd = AP::FS().open(TEST_LOG_FILE, O_RDWR);
+    ASSERT_NE(fd, -1);
+    static uint8_t contents[sizeof(log_compress_file_header) + sizeof(data) + 100];
+    ASSERT_EQ(AP::FS().read(fd, contents, sizeof(contents)), file_size);
+    AP::FS().close(fd);
+    fd = AP::FS().open(TEST_LOG_FILE, O_WRONLY|O_TRUNC);
+    ASSERT_NE(fd, -1);
+    ASSERT_EQ(AP::FS().write(fd, contents, file_size - 1), file_size - 1);
+    AP::FS().close(fd);
+
+    // only the complete blocks are seen
+    fd = AP::FS().open(TEST_LOG_FILE, O_RDONLY);
+    ASSERT_NE(fd, -1);
+    EXPECT_EQ(AP_Logger_CompressedReader::decoded_size(fd), 8000);
+    AP_Logger_CompressedReader reader;
+    ASSERT_TRUE(reader.open(fd));
+    EXPECT_EQ(reader.read(buf, sizeof(buf)), 8000);
+    EXPECT_EQ(memcmp(buf, data, 8000), 0);
+    EXPECT_EQ(reader.read(buf, sizeof(buf)), 0);
+    EXPECT_FALSE(reader.seek(8000));
+    reader.close();
+    AP::FS().close(fd);
+
+    // a corrupt block ends the log the same way
+    contents[sizeof(log_compress_file_header) + sizeof(log_compress_block_header) + 10] ^= 0x01;
+    fd = AP::FS().open(TEST_LOG_FILE, O_WRONLY|O_TRUNC);
+    ASSERT_NE(fd, -1);
+    ASSERT_EQ(AP::FS().write(fd, contents, file_size), file_size);
+    AP::FS().close(fd);
+    fd = AP::FS().open(TEST_LOG_FILE, O_RDONLY);
+    ASSERT_NE(fd, -1);
+    ASSERT_TRUE(reader.open(fd));
+    EXPECT_EQ(reader.read(buf, sizeof(buf)), 0);
+    reader.close();
+    AP::FS().close(fd);
+
+    AP::FS().unlink(TEST_LOG_FILE);
+}
+
+TEST(AP_Logger_CompressedReader, not_compressed)
+{
+    const uint8_t data[] { 0xA3, 0x95, 0x80, 0x80, 0x59 };
+    int fd = AP::FS().open(TEST_LOG_FILE, O_WRONLY|O_CREAT|O_TRUNC);
+    ASSERT_NE(fd, -1);
+    ASSERT_EQ(AP::FS().write(fd, data, sizeof(data)), int32_t(sizeof(data)));
+    AP::FS().close(fd);
+
+    // a plain log is left for the caller to read from the start
+    fd = AP::FS().open(TEST_LOG_FILE, O_RDONLY);
+    ASSERT_NE(fd, -1);
+    EXPECT_EQ(AP_Logger_CompressedReader::decoded_size(fd), -1);
+    AP_Logger_CompressedReader reader;
+    EXPECT_FALSE(reader.open(fd));
+    EXPECT_FALSE(reader.is_open());
+    uint8_t buf[sizeof(data)];
+    EXPECT_EQ(AP::FS().read(fd, buf, sizeof(buf)), int32_t(sizeof(buf)));
+    EXPECT_EQ(memcmp(buf, data, sizeof(data)), 0);
+    AP::FS().close(fd);
+    AP::FS().unlink(TEST_LOG_FILE);
+}
+
+#endif // HAL_LOGGER_FILE_COMPRESSION_ENABLED
+
+AP_GTEST_MAIN()
@@ -0,0 +1,165 @@
+#include <AP_gtest.h>
+
+/*
+  tests for AP_Logger/AP_Logger_IngestQueue.cpp
+ */
+
+#include <AP_Logger/AP_Logger_IngestQueue.h>
+#include <string.h>
+
+const AP_HAL::HAL &hal = AP_HAL::get_HAL();
+
+// fill a message whose contents identify it
+static void make_message(uint8_t *buf, uint16_t size, uint32_t n)
+{
+    for (uint16_t i=0; i<size; i++) {
+        buf[i] = uint8_t(n + i);
+    }
+}
+
+static bool check_message(const uint8_t *buf, uint16_t size, uint32_t n)
+{
+    uint8_t expected[AP_Logger_IngestQueue::MAX_MESSAGE_SIZE];
+    make_message(expected, size, n);
+    return memcmp(buf, expected, size) == 0;
+}
+
+TEST(AP_Logger_IngestQueue, init)
+{
+    AP_Logger_IngestQueue q;
+    EXPECT_FALSE(q.enabled());
+    EXPECT_FALSE(q.init(0));
+    EXPECT_FALSE(q.init(6));
+    EXPECT_TRUE(q.init(8));
+    EXPECT_TRUE(q.enabled());
+    EXPECT_TRUE(q.empty());
+
+    // an unallocated queue never accepts messages
+    AP_Logger_IngestQueue q2;
+    const uint8_t msg[4] {};
+    EXPECT_FALSE(q2.push(msg, sizeof(msg), false));
+    EXPECT_EQ(q2.num_drops(), 0U);
+}
+
+TEST(AP_Logger_IngestQueue, order_and_wraparound)
+{
+    AP_Logger_IngestQueue q;
+    EXPECT_TRUE(q.init(4));
+
+    // push and pop many times the number of slots, with a varying
+    // number of messages in the queue, so positions wrap repeatedly
+    uint32_t pushed = 0;
+    uint32_t popped = 0;
+    uint8_t msg[AP_Logger_IngestQueue::MAX_MESSAGE_SIZE];
+    for (uint32_t round=0; round<100; round++) {
+        const uint32_t npush = 1 + round % 4;
+        for (uint32_t i=0; i<npush; i++) {
+            const uint16_t size = 1 + (pushed * 37) % sizeof(msg);
+            make_message(msg, size, pushed);
+            EXPECT_TRUE(q.push(msg, size, (pushed % 3) == 0));
+            pushed++;
+        }
+        EXPECT_FALSE(q.empty());
+        while (popped < pushed) {
+            uint16_t size;
+            bool is_critical;
+            const uint8_t *data = q.peek(size, is_critical);
+            ASSERT_NE(data, nullptr);
+            EXPECT_EQ(size, 1 + (popped * 37) % sizeof(msg));
+            EXPECT_EQ(is_critical, (popped % 3) == 0);
+            EXPECT_TRUE(check_message(data, size, popped));
+            q.pop();
+            popped++;
+        }
+        EXPECT_TRUE(q.empty());
+        uint16_t size;
+        bool is_critical;
+        EXPECT_EQ(q.peek(size, is_critical), nullptr);
+    }
+    EXPECT_EQ(q.num_staged(), pushed);
+    EXPECT_EQ(q.num_drops(), 0U);
+    EXPECT_EQ(q.take_max_depth(), 4);
+    EXPECT_EQ(q.take_max_depth(), 0);
+}
+
+TEST(AP_Logger_IngestQueue, full)
+{
+    AP_Logger_IngestQueue q;
+    EXPECT_TRUE(q.init(4));
+
+    uint8_t msg[8];
+    for (uint32_t i=0; i<4; i++) {
+        make_message(msg, sizeof(msg), i);
+        EXPECT_TRUE(q.push(msg, sizeof(msg), false));
+    }
+
+    // queue is full; further pushes are dropped and counted
+    make_message(msg, sizeof(msg), 4);
+    EXPECT_FALSE(q.push(msg, sizeof(msg), false));
+    EXPECT_FALSE(q.push(msg, sizeof(msg), true));
+    EXPECT_EQ(q.num_drops(), 2U);
+    EXPECT_EQ(q.take_new_drops(), 2U);
+    EXPECT_EQ(q.take_new_drops(), 0U);
+
+    // freeing one slot allows one more push, and order is kept
+    uint16_t size;
+    bool is_critical;
+    const uint8_t *data = q.peek(size, is_critical);
+    ASSERT_NE(data, nullptr);
+    EXPECT_TRUE(check_message(data, size, 0));
+    q.pop();
+    EXPECT_TRUE(q.push(msg, sizeof(msg), false));
+    EXPECT_FALSE(q.push(msg, sizeof(msg), false));
+    EXPECT_EQ(q.take_new_drops(), 1U);
+
+    for (uint32_t i=1; i<=4; i++) {
+        data = q.peek(size, is_critical);
+        ASSERT_NE(data, nullptr);
+        EXPECT_TRUE(check_message(data, size, i));
+        q.pop();
+    }
+    EXPECT_TRUE(q.empty());
+}
+
+TEST(AP_Logger_IngestQueue, oversize)
+{
+    AP_Logger_IngestQueue q;
+    EXPECT_TRUE(q.init(4));
+
+    static uint8_t msg[AP_Logger_IngestQueue::MAX_MESSAGE_SIZE+1];
+    EXPECT_TRUE(q.push(msg, AP_Logger_IngestQueue::MAX_MESSAGE_SIZE, false));
+    EXPECT_FALSE(q.push(msg, sizeof(msg), false));
+    EXPECT_EQ(q.num_drops(), 1U);
+    EXPECT_EQ(q.num_staged(), 1U);
+}
+
+TEST(AP_Logger_IngestQueue, clear)
+{
+    AP_Logger_IngestQueue q;
+    EXPECT_TRUE(q.init(4));
+
+    uint8_t msg[8];
+    for (uint32_t i=0; i<3; i++) {
+        make_message(msg, sizeof(msg), i);
+        EXPECT_TRUE(q.push(msg, sizeof(msg), false));
+    }
+    q.clear();
+    EXPECT_TRUE(q.empty());
+
+    // messages pushed after the clear are delivered, across the wrap
+    for (uint32_t i=10; i<14; i++) {
+        make_message(msg, sizeof(msg), i);
+        EXPECT_TRUE(q.push(msg, sizeof(msg), false));
+    }
+    for (uint32_t i=10; i<14; i++) {
+        uint16_t size;
+        bool is_critical;
+        const uint8_t *data = q.peek(size, is_critical);
+        ASSERT_NE(data, nullptr);
+        EXPECT_TRUE(check_message(data, size, i));
+        q.pop();
+    }
+    EXPECT_TRUE(q.empty());
+}
+
+AP_GTEST_MAIN()
@@ -0,0 +1,70 @@
+#include <AP_gbenchmark.h>
+
+#include <AP_Math/AP_Math.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+/*
+  errors spanning the linear and square root sections of the controller
+ */
+static const float errors[] { -50.0f, -2.0f, -0.05f, 0.0f, 0.01f, 0.5f, 3.0f, 120.0f };
+
+static void BM_SqrtController(benchmark::State& state)
+{
+    uint8_t i = 0;
+    while (state.KeepRunning()) {
+        float error = errors[i++ % ARRAY_SIZE(errors)];
+        gbenchmark_escape(&error);
+        float correction = sqrt_controller(error, 2.0f, 5.0f, 0.0025f);
+        gbenchmark_escape(&correction);
+    }
+}
+
+static void BM_SqrtController2D(benchmark::State& state)
+{
+    uint8_t i = 0;
+    while (state.KeepRunning()) {
+        Vector2f error(errors[i % ARRAY_SIZE(errors)], errors[(i+3) % ARRAY_SIZE(errors)]);
+        i++;
+        gbenchmark_escape(&error);
+        Vector2f correction = sqrt_controller(error, 2.0f, 5.0f, 0.0025f);
+        gbenchmark_escape(&correction);
+    }
+}
+
+static void BM_InvSqrtController(benchmark::State& state)
+{
+    uint8_t i = 0;
+    while (state.KeepRunning()) {
+        float output = errors[i++ % ARRAY_SIZE(errors)];
+        gbenchmark_escape(&output);
+        float error = inv_sqrt_controller(output, 2.0f, 5.0f);
+        gbenchmark_escape(&error);
+    }
+}
+
+// Vector2p follows HAL_WITH_POSTYPE_DOUBLE
+static void BM_ShapePosVelAccelXY(benchmark::State& state)
+{
+    state.SetLabel(sizeof(postype_t) == 8 ? "double" : "float");
+    Vector2p pos(10.0, -5.0);
+    Vector2f vel(1.0f, 2.0f);
+    Vector2f accel;
+    const Vector2p pos_target(100.0, 50.0);
+    const Vector2f vel_target;
+    const Vector2f accel_target;
+
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&pos);
+        shape_pos_vel_accel_xy(pos_target, vel_target, accel_target, pos, vel, accel,
+                               5.0f, 2.5f, 10.0f, 0.0025f, false);
+        gbenchmark_escape(&accel);
+    }
+}
+
+BENCHMARK(BM_SqrtController);
+BENCHMARK(BM_SqrtController2D);
+BENCHMARK(BM_InvSqrtController);
+BENCHMARK(BM_ShapePosVelAccelXY);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,84 @@
+#include <AP_gbenchmark.h>
+
+#include <AP_Math/AP_Math.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+/*
+  CRC throughput over buffers from a short RC frame up to a flash
+  sector sized block. Bytes per second is reported, divide by the CPU
+  clock for bytes per cycle
+ */
+static uint8_t buf[4096];
+
+static void fill_buf(void)
+{
+    uint32_t seed = 1;
+    for (uint16_t i=0; i<sizeof(buf); i++) {
+        seed = seed * 1103515245U + 12345U;
+        buf[i] = seed >> 16;
+    }
+}
+
+static void BM_CRC32(benchmark::State& state)
+{
+    const uint32_t len = state.range_x();
+    fill_buf();
+    while (state.KeepRunning()) {
+        uint32_t crc = crc_crc32(0, buf, len);
+        gbenchmark_escape(&crc);
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * len);
+}
+
+static void BM_CRC32Small(benchmark::State& state)
+{
+    const uint32_t len = state.range_x();
+    fill_buf();
+    while (state.KeepRunning()) {
+        uint32_t crc = crc32_small(0, buf, len);
+        gbenchmark_escape(&crc);
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * len);
+}
+
+static void BM_CRC24(benchmark::State& state)
+{
+    const uint16_t len = state.range_x();
+    fill_buf();
+    while (state.KeepRunning()) {
+        uint32_t crc = crc_crc24(buf, len);
+        gbenchmark_escape(&crc);
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * len);
+}
+
+static void BM_CRC16CCITT(benchmark::State& state)
+{
+    const uint32_t len = state.range_x();
+    fill_buf();
+    while (state.KeepRunning()) {
+        uint16_t crc = crc16_ccitt(buf, len, 0);
+        gbenchmark_escape(&crc);
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * len);
+}
+
+static void BM_CRC8DVBS2(benchmark::State& state)
+{
+    const uint32_t len = state.range_x();
+    fill_buf();
+    while (state.KeepRunning()) {
+        uint8_t crc = crc8_dvb_s2_update(0, buf, len);
+        gbenchmark_escape(&crc);
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * len);
+}
+
+BENCHMARK(BM_CRC32)->Arg(16)->Arg(256)->Arg(4096);
+BENCHMARK(BM_CRC32Small)->Arg(16)->Arg(256)->Arg(4096);
+BENCHMARK(BM_CRC24)->Arg(16)->Arg(256)->Arg(1024);
+BENCHMARK(BM_CRC16CCITT)->Arg(16)->Arg(256)->Arg(4096);
+BENCHMARK(BM_CRC8DVBS2)->Arg(16)->Arg(64);
+
+BENCHMARK_MAIN();
@@ -19,6 +19,57 @@ static void BM_MatrixMultiplication(benchmark::State& state)
     }
 }
 
+template <typename T>
+static void BM_MatrixFromEuler(benchmark::State& state)
+{
+    Matrix3<T> m;
+    T roll = 0.1;
+    T pitch = -0.2;
+    T yaw = 2.5;
+
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&roll);
+        m.from_euler(roll, pitch, yaw);
+        gbenchmark_escape(&m);
+    }
+}
+
+template <typename T>
+static void BM_MatrixToEuler(benchmark::State& state)
+{
+    Matrix3<T> m;
+    m.from_euler(0.1, -0.2, 2.5);
+    T roll, pitch, yaw;
+
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&m);
+        m.to_euler(&roll, &pitch, &yaw);
+        gbenchmark_escape(&roll);
+        gbenchmark_escape(&pitch);
+        gbenchmark_escape(&yaw);
+    }
+}
+
+template <typename T>
+static void BM_MatrixTimesVector(benchmark::State& state)
+{
+    Matrix3<T> m;
+    m.from_euler(0.1, -0.2, 2.5);
+    Vector3<T> v(1, 2, 3);
+
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&v);
+        Vector3<T> r = m * v;
+        gbenchmark_escape(&r);
+    }
+}
+
 BENCHMARK(BM_MatrixMultiplication);
+BENCHMARK_TEMPLATE(BM_MatrixFromEuler, float);
+BENCHMARK_TEMPLATE(BM_MatrixFromEuler, double);
+BENCHMARK_TEMPLATE(BM_MatrixToEuler, float);
+BENCHMARK_TEMPLATE(BM_MatrixToEuler, double);
+BENCHMARK_TEMPLATE(BM_MatrixTimesVector, float);
+BENCHMARK_TEMPLATE(BM_MatrixTimesVector, double);
 
 BENCHMARK_MAIN();
@@ -0,0 +1,82 @@
+#include <AP_gbenchmark.h>
+
+#include <AP_Math/AP_Math.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+#define MATRIX_DIM_MAX 9
+
+/*
+  fill a dim x dim matrix with a well conditioned, diagonally dominant
+  test matrix
+ */
+template <typename T>
+static void fill_test_matrix(T *m, uint16_t dim)
+{
+    for (uint16_t i = 0; i < dim; i++) {
+        for (uint16_t j = 0; j < dim; j++) {
+            m[i*dim + j] = (i == j) ? T(dim + 1) : T(1) / T(1 + i + 2*j);
+        }
+    }
+}
+
+/*
+  mat_inverse uses a dedicated implementation for 3x3 and 4x4 and LU
+  decomposition for all other sizes, so benchmark a range of sizes
+ */
+template <typename T>
+static void BM_MatInverse(benchmark::State& state)
+{
+    const uint16_t dim = state.range_x();
+    T m[MATRIX_DIM_MAX*MATRIX_DIM_MAX];
+    T inv[MATRIX_DIM_MAX*MATRIX_DIM_MAX];
+    fill_test_matrix(m, dim);
+
+    while (state.KeepRunning()) {
+        gbenchmark_escape(m);
+        bool ok = mat_inverse(m, inv, dim);
+        gbenchmark_escape(&ok);
+        gbenchmark_escape(inv);
+    }
+}
+
+template <typename T>
+static void BM_MatMul(benchmark::State& state)
+{
+    const uint16_t dim = state.range_x();
+    T a[MATRIX_DIM_MAX*MATRIX_DIM_MAX];
+    T b[MATRIX_DIM_MAX*MATRIX_DIM_MAX];
+    T c[MATRIX_DIM_MAX*MATRIX_DIM_MAX];
+    fill_test_matrix(a, dim);
+    fill_test_matrix(b, dim);
+
+    while (state.KeepRunning()) {
+        gbenchmark_escape(a);
+        mat_mul(a, b, c, dim);
+        gbenchmark_escape(c);
+    }
+}
+
+template <typename T>
+static void BM_Matrix3Inverse(benchmark::State& state)
+{
+    Matrix3<T> m;
+    m.from_euler(0.1, -0.2, 2.5);
+    Matrix3<T> inv;
+
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&m);
+        bool ok = m.inverse(inv);
+        gbenchmark_escape(&ok);
+        gbenchmark_escape(&inv);
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_MatInverse, float)->Arg(3)->Arg(4)->Arg(6)->Arg(9);
+BENCHMARK_TEMPLATE(BM_MatInverse, double)->Arg(3)->Arg(4)->Arg(6)->Arg(9);
+BENCHMARK_TEMPLATE(BM_MatMul, float)->Arg(3)->Arg(4)->Arg(6)->Arg(9);
+BENCHMARK_TEMPLATE(BM_MatMul, double)->Arg(3)->Arg(4)->Arg(6)->Arg(9);
+BENCHMARK_TEMPLATE(BM_Matrix3Inverse, float);
+BENCHMARK_TEMPLATE(BM_Matrix3Inverse, double);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,165 @@
+#include <AP_gbenchmark.h>
+
+#include <AP_Math/AP_Math.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+#define POLYGON_VERTICES_MAX 1024
+
+/*
+  closed, roughly circular polygon of n vertices with a radius of
+  100m (in cm) and a bumpy edge so that it is not convex
+ */
+static Vector2f polygon[POLYGON_VERTICES_MAX+1];
+static float polygon_x[POLYGON_VERTICES_MAX];
+static float polygon_y[POLYGON_VERTICES_MAX];
+static Polygon_SoAf polygon_soa;
+
+static void make_polygon(unsigned n)
+{
+    for (unsigned i = 0; i < n; i++) {
+        const float angle = M_2PI * i / n;
+        const float radius = (i % 2) ? 10000.0f : 9000.0f;
+        polygon[i] = Vector2f(cosf(angle), sinf(angle)) * radius;
+    }
+    polygon[n] = polygon[0];
+    if (!Polygon_SoA_init(polygon_soa, polygon, n+1, polygon_x, polygon_y)) {
+        abort();
+    }
+}
+
+static void BM_PolygonOutsideInside(benchmark::State& state)
+{
+    const unsigned n = state.range_x();
+    make_polygon(n);
+    Vector2f point(1000.0f, 2000.0f);
+
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&point);
+        bool outside = Polygon_outside(point, polygon, n+1);
+        gbenchmark_escape(&outside);
+    }
+}
+
+static void BM_PolygonOutsideOutside(benchmark::State& state)
+{
+    const unsigned n = state.range_x();
+    make_polygon(n);
+    Vector2f point(20000.0f, -15000.0f);
+
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&point);
+        bool outside = Polygon_outside(point, polygon, n+1);
+        gbenchmark_escape(&outside);
+    }
+}
+
+static void BM_PolygonIntersectsMiss(benchmark::State& state)
+{
+    const unsigned n = state.range_x();
+    make_polygon(n);
+    Vector2f p1(1000.0f, 2000.0f);
+    Vector2f p2(-2000.0f, 1000.0f);
+    Vector2f intersection;
+
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&p1);
+        bool intersects = Polygon_intersects(polygon, n+1, p1, p2, intersection);
+        gbenchmark_escape(&intersects);
+    }
+}
+
+static void BM_PolygonIntersectsHit(benchmark::State& state)
+{
+    const unsigned n = state.range_x();
+    make_polygon(n);
+    Vector2f p1(1000.0f, 2000.0f);
+    Vector2f p2(30000.0f, 25000.0f);
+    Vector2f intersection;
+
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&p1);
+        bool intersects = Polygon_intersects(polygon, n+1, p1, p2, intersection);
+        gbenchmark_escape(&intersects);
+        gbenchmark_escape(&intersection);
+    }
+}
+
+static void BM_PolygonSoAOutsideInside(benchmark::State& state)
+{
+    make_polygon(state.range_x());
+    Vector2f point(1000.0f, 2000.0f);
+
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&point);
+        bool outside = Polygon_outside(point, polygon_soa);
+        gbenchmark_escape(&outside);
+    }
+}
+
+static void BM_PolygonSoAOutsideOutside(benchmark::State& state)
+{
+    make_polygon(state.range_x());
+    Vector2f point(20000.0f, -15000.0f);
+
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&point);
+        bool outside = Polygon_outside(point, polygon_soa);
+        gbenchmark_escape(&outside);
+    }
+}
+
+static void BM_PolygonSoAIntersectsMiss(benchmark::State& state)
+{
+    make_polygon(state.range_x());
+    Vector2f p1(1000.0f, 2000.0f);
+    Vector2f p2(-2000.0f, 1000.0f);
+    Vector2f intersection;
+
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&p1);
+        bool intersects = Polygon_intersects(polygon_soa, p1, p2, intersection);
+        gbenchmark_escape(&intersects);
+    }
+}
+
+static void BM_PolygonSoAIntersectsHit(benchmark::State& state)
+{
+    make_polygon(state.range_x());
+    Vector2f p1(1000.0f, 2000.0f);
+    Vector2f p2(30000.0f, 25000.0f);
+    Vector2f intersection;
+
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&p1);
+        bool intersects = Polygon_intersects(polygon_soa, p1, p2, intersection);
+        gbenchmark_escape(&intersects);
+        gbenchmark_escape(&intersection);
+    }
+}
+
+static void BM_PolygonClosestDistanceLine(benchmark::State& state)
+{
+    const unsigned n = state.range_x();
+    make_polygon(n);
+    Vector2f p1(1000.0f, 2000.0f);
+    Vector2f p2(-2000.0f, 1000.0f);
+
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&p1);
+        float dist = Polygon_closest_distance_line(polygon, n+1, p1, p2);
+        gbenchmark_escape(&dist);
+    }
+}
+
+BENCHMARK(BM_PolygonOutsideInside)->RangeMultiplier(4)->Range(4, POLYGON_VERTICES_MAX);
+BENCHMARK(BM_PolygonOutsideOutside)->RangeMultiplier(4)->Range(4, POLYGON_VERTICES_MAX);
+BENCHMARK(BM_PolygonIntersectsMiss)->RangeMultiplier(4)->Range(4, POLYGON_VERTICES_MAX);
+BENCHMARK(BM_PolygonIntersectsHit)->RangeMultiplier(4)->Range(4, POLYGON_VERTICES_MAX);
+BENCHMARK(BM_PolygonSoAOutsideInside)->RangeMultiplier(4)->Range(4, POLYGON_VERTICES_MAX);
+BENCHMARK(BM_PolygonSoAOutsideOutside)->RangeMultiplier(4)->Range(4, POLYGON_VERTICES_MAX);
+BENCHMARK(BM_PolygonSoAIntersectsMiss)->RangeMultiplier(4)->Range(4, POLYGON_VERTICES_MAX);
+BENCHMARK(BM_PolygonSoAIntersectsHit)->RangeMultiplier(4)->Range(4, POLYGON_VERTICES_MAX);
+BENCHMARK(BM_PolygonClosestDistanceLine)->RangeMultiplier(4)->Range(4, POLYGON_VERTICES_MAX);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,86 @@
+#include <AP_gbenchmark.h>
+
+#include <AP_Math/AP_Math.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+template <typename T>
+static void BM_QuaternionRotate(benchmark::State& state)
+{
+    QuaternionT<T> q;
+    q.from_euler(0.1, -0.2, 2.5);
+    const Vector3<T> rotation(0.001, -0.002, 0.003);
+
+    while (state.KeepRunning()) {
+        q.rotate(rotation);
+        gbenchmark_escape(&q);
+    }
+}
+
+template <typename T>
+static void BM_QuaternionRotateFast(benchmark::State& state)
+{
+    QuaternionT<T> q;
+    q.from_euler(0.1, -0.2, 2.5);
+    const Vector3<T> rotation(0.001, -0.002, 0.003);
+
+    while (state.KeepRunning()) {
+        q.rotate_fast(rotation);
+        gbenchmark_escape(&q);
+    }
+}
+
+template <typename T>
+static void BM_QuaternionTimesVector(benchmark::State& state)
+{
+    QuaternionT<T> q;
+    q.from_euler(0.1, -0.2, 2.5);
+    Vector3<T> v(1, 2, 3);
+
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&v);
+        Vector3<T> r = q * v;
+        gbenchmark_escape(&r);
+    }
+}
+
+template <typename T>
+static void BM_QuaternionFromRotationMatrix(benchmark::State& state)
+{
+    Matrix3<T> m;
+    m.from_euler(0.1, -0.2, 2.5);
+    QuaternionT<T> q;
+
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&m);
+        q.from_rotation_matrix(m);
+        gbenchmark_escape(&q);
+    }
+}
+
+template <typename T>
+static void BM_QuaternionRotationMatrix(benchmark::State& state)
+{
+    QuaternionT<T> q;
+    q.from_euler(0.1, -0.2, 2.5);
+    Matrix3<T> m;
+
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&q);
+        q.rotation_matrix(m);
+        gbenchmark_escape(&m);
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_QuaternionRotate, float);
+BENCHMARK_TEMPLATE(BM_QuaternionRotate, double);
+BENCHMARK_TEMPLATE(BM_QuaternionRotateFast, float);
+BENCHMARK_TEMPLATE(BM_QuaternionRotateFast, double);
+BENCHMARK_TEMPLATE(BM_QuaternionTimesVector, float);
+BENCHMARK_TEMPLATE(BM_QuaternionTimesVector, double);
+BENCHMARK_TEMPLATE(BM_QuaternionFromRotationMatrix, float);
+BENCHMARK_TEMPLATE(BM_QuaternionFromRotationMatrix, double);
+BENCHMARK_TEMPLATE(BM_QuaternionRotationMatrix, float);
+BENCHMARK_TEMPLATE(BM_QuaternionRotationMatrix, double);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,88 @@
+#include <AP_gbenchmark.h>
+
+#include <AP_Math/AP_Math.h>
+#include <AP_Math/SCurve.h>
+#include <AP_Math/SplineCurve.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+static const Vector3f origin(0.0f, 0.0f, 1000.0f);
+static const Vector3f destination(10000.0f, 5000.0f, 2000.0f);
+static const float dt = 0.0025f;
+
+static void BM_SCurveCalculatePath(benchmark::State& state)
+{
+    float L = 150.0f;
+    float Jm_out, tj_out, t2_out, t4_out, t6_out;
+
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&L);
+        SCurve::calculate_path(20.0f, 10.0f, 0.0f, 2.5f, 10.0f, L,
+                               Jm_out, tj_out, t2_out, t4_out, t6_out);
+        gbenchmark_escape(&tj_out);
+        gbenchmark_escape(&t6_out);
+    }
+}
+
+static void BM_SCurveCalculateTrack(benchmark::State& state)
+{
+    SCurve leg;
+
+    while (state.KeepRunning()) {
+        leg.calculate_track(origin, destination, 1000.0f, 250.0f, 150.0f,
+                            250.0f, 100.0f, 2000.0f, 1000.0f);
+        gbenchmark_escape(&leg);
+    }
+}
+
+static void BM_SCurveAdvanceTarget(benchmark::State& state)
+{
+    SCurve prev_leg;
+    SCurve this_leg;
+    SCurve next_leg;
+    this_leg.calculate_track(origin, destination, 1000.0f, 250.0f, 150.0f,
+                             250.0f, 100.0f, 2000.0f, 1000.0f);
+    Vector3f pos, vel, accel;
+
+    while (state.KeepRunning()) {
+        pos = origin;
+        vel.zero();
+        accel.zero();
+        bool passed_apex = this_leg.advance_target_along_track(prev_leg, next_leg, 200.0f, 250.0f, false,
+                                                               dt, pos, vel, accel);
+        gbenchmark_escape(&passed_apex);
+        gbenchmark_escape(&pos);
+        if (this_leg.finished()) {
+            state.PauseTiming();
+            this_leg.calculate_track(origin, destination, 1000.0f, 250.0f, 150.0f,
+                                     250.0f, 100.0f, 2000.0f, 1000.0f);
+            state.ResumeTiming();
+        }
+    }
+}
+
+static void BM_SplineAdvanceTarget(benchmark::State& state)
+{
+    SplineCurve spline;
+    spline.set_speed_accel(1000.0f, 250.0f, 150.0f, 250.0f, 100.0f);
+    spline.set_origin_and_destination(origin, destination, Vector3f(), Vector3f());
+    Vector3f pos, vel;
+
+    while (state.KeepRunning()) {
+        spline.advance_target_along_track(dt, pos, vel);
+        gbenchmark_escape(&pos);
+        gbenchmark_escape(&vel);
+        if (spline.reached_destination()) {
+            state.PauseTiming();
+            spline.set_origin_and_destination(origin, destination, Vector3f(), Vector3f());
+            state.ResumeTiming();
+        }
+    }
+}
+
+BENCHMARK(BM_SCurveCalculatePath);
+BENCHMARK(BM_SCurveCalculateTrack);
+BENCHMARK(BM_SCurveAdvanceTarget);
+BENCHMARK(BM_SplineAdvanceTarget);
+
+BENCHMARK_MAIN();
@@ -17,8 +17,31 @@
  */
 
 #include <stdint.h>
+#include <string.h>
+#include <AP_HAL/AP_HAL_Boards.h>
 #include "crc.h"
 
+#if defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#endif
+
+/*
+  slice-by-8 crc32 needs 8k of tables, built on first use, so only use
+  it where memory is plentiful
+ */
+#ifndef AP_CRC32_SLICE_BY_8_ENABLED
+#define AP_CRC32_SLICE_BY_8_ENABLED (CONFIG_HAL_BOARD == HAL_BOARD_SITL || CONFIG_HAL_BOARD == HAL_BOARD_LINUX)
+#endif
+
+/*
+  the crc24 table costs 1k of flash, so small boards compute it a bit
+  at a time. The threshold matches AP_GPS_RTCM_INJECT_FRAMES_ENABLED,
+  which checks a crc24 for every injected RTCMv3 packet
+ */
+#ifndef AP_CRC24_TABLE_ENABLED
+#define AP_CRC24_TABLE_ENABLED (HAL_MEM_CLASS >= HAL_MEM_CLASS_300)
+#endif
+
 /**
  * crc4 method from datasheet for 16 bytes (8 short values)
  * 
@@ -90,10 +113,38 @@ uint8_t crc_crc8(const uint8_t *p, uint8_t len)
 	return crc & 0xFF;
 }
 
+/*
+  crc8_dvb() table for the DVB-S2 polynomial 0xD5
+ */
+static const uint8_t crc8_dvb_s2_table[] = {
+    0x00, 0xd5, 0x7f, 0xaa, 0xfe, 0x2b, 0x81, 0x54, 0x29, 0xfc, 0x56, 0x83,
+    0xd7, 0x02, 0xa8, 0x7d, 0x52, 0x87, 0x2d, 0xf8, 0xac, 0x79, 0xd3, 0x06,
+    0x7b, 0xae, 0x04, 0xd1, 0x85, 0x50, 0xfa, 0x2f, 0xa4, 0x71, 0xdb, 0x0e,
+    0x5a, 0x8f, 0x25, 0xf0, 0x8d, 0x58, 0xf2, 0x27, 0x73, 0xa6, 0x0c, 0xd9,
+    0xf6, 0x23, 0x89, 0x5c, 0x08, 0xdd, 0x77, 0xa2, 0xdf, 0x0a, 0xa0, 0x75,
+    0x21, 0xf4, 0x5e, 0x8b, 0x9d, 0x48, 0xe2, 0x37, 0x63, 0xb6, 0x1c, 0xc9,
+    0xb4, 0x61, 0xcb, 0x1e, 0x4a, 0x9f, 0x35, 0xe0, 0xcf, 0x1a, 0xb0, 0x65,
+    0x31, 0xe4, 0x4e, 0x9b, 0xe6, 0x33, 0x99, 0x4c, 0x18, 0xcd, 0x67, 0xb2,
+    0x39, 0xec, 0x46, 0x93, 0xc7, 0x12, 0xb8, 0x6d, 0x10, 0xc5, 0x6f, 0xba,
+    0xee, 0x3b, 0x91, 0x44, 0x6b, 0xbe, 0x14, 0xc1, 0x95, 0x40, 0xea, 0x3f,
+    0x42, 0x97, 0x3d, 0xe8, 0xbc, 0x69, 0xc3, 0x16, 0xef, 0x3a, 0x90, 0x45,
+    0x11, 0xc4, 0x6e, 0xbb, 0xc6, 0x13, 0xb9, 0x6c, 0x38, 0xed, 0x47, 0x92,
+    0xbd, 0x68, 0xc2, 0x17, 0x43, 0x96, 0x3c, 0xe9, 0x94, 0x41, 0xeb, 0x3e,
+    0x6a, 0xbf, 0x15, 0xc0, 0x4b, 0x9e, 0x34, 0xe1, 0xb5, 0x60, 0xca, 0x1f,
+    0x62, 0xb7, 0x1d, 0xc8, 0x9c, 0x49, 0xe3, 0x36, 0x19, 0xcc, 0x66, 0xb3,
+    0xe7, 0x32, 0x98, 0x4d, 0x30, 0xe5, 0x4f, 0x9a, 0xce, 0x1b, 0xb1, 0x64,
+    0x72, 0xa7, 0x0d, 0xd8, 0x8c, 0x59, 0xf3, 0x26, 0x5b, 0x8e, 0x24, 0xf1,
+    0xa5, 0x70, 0xda, 0x0f, 0x20, 0xf5, 0x5f, 0x8a, 0xde, 0x0b, 0xa1, 0x74,
+    0x09, 0xdc, 0x76, 0xa3, 0xf7, 0x22, 0x88, 0x5d, 0xd6, 0x03, 0xa9, 0x7c,
+    0x28, 0xfd, 0x57, 0x82, 0xff, 0x2a, 0x80, 0x55, 0x01, 0xd4, 0x7e, 0xab,
+    0x84, 0x51, 0xfb, 0x2e, 0x7a, 0xaf, 0x05, 0xd0, 0xad, 0x78, 0xd2, 0x07,
+    0x53, 0x86, 0x2c, 0xf9
+};
+
 // crc8 from betaflight
 uint8_t crc8_dvb_s2(uint8_t crc, uint8_t a)
 {
-    return crc8_dvb(crc, a, 0xD5);
+    return crc8_dvb_s2_table[crc ^ a];
 }
 
 // crc8 from betaflight
@@ -117,16 +168,17 @@ uint8_t crc8_dvb_s2_update(uint8_t crc, const void *data, uint32_t length)
     const uint8_t *pend = p + length;
 
     for (; p != pend; p++) {
-        crc = crc8_dvb_s2(crc, *p);
+        crc = crc8_dvb_s2_table[crc ^ *p];
     }
     return crc;
 }
 
-// copied from AP_FETtecOneWire.cpp
+// copied from AP_FETtecOneWire.cpp. This is crc8_dvb() with the
+// polynomial 0x07, which crc8_table is for
 uint8_t crc8_dvb_update(uint8_t crc, const uint8_t* buf, const uint16_t buf_len)
 {
     for (uint16_t i = 0; i < buf_len; i++) {
-        crc = crc8_dvb(buf[i], crc, 0x7);
+        crc = crc8_table[crc ^ buf[i]];
     }
     return crc;
 }
@@ -188,26 +240,13 @@ uint8_t crc8_maxim(const uint8_t *data, uint16_t length)
  */
 uint16_t crc_xmodem_update(uint16_t crc, uint8_t data)
 {
-	crc = crc ^ ((uint16_t)data << 8);
-	for (uint16_t i=0; i<8; i++)
-	{
-		if(crc & 0x8000) {
-			crc = (crc << 1) ^ 0x1021;
-		} else {
-			crc <<= 1;
-        }
-	}
-
-	return crc;
+    // xmodem uses the CCITT polynomial, so share its table
+    return crc16_ccitt(&data, 1, crc);
 }
 
 uint16_t crc_xmodem(const uint8_t *data, uint16_t len)
 {
-    uint16_t crc = 0;
-    for (uint16_t i=0; i<len; i++) {
-        crc = crc_xmodem_update(crc, data[i]);
-    }
-    return crc;
+    return crc16_ccitt(data, len, 0);
 }
 
 /*
@@ -260,6 +299,59 @@ static const uint32_t crc32_tab[] = {
 };
 
 
+#if defined(__ARM_FEATURE_CRC32)
+/*
+  the ARMv8 CRC32 instructions use the same polynomial and, like
+  crc_crc32(), don't invert the crc
+ */
+uint32_t crc_crc32(uint32_t crc, const uint8_t *buf, uint32_t size)
+{
+    for (; size >= 8; size -= 8, buf += 8) {
+        uint64_t v;
+        memcpy(&v, buf, sizeof(v));
+        crc = __crc32d(crc, v);
+    }
+    while (size--) {
+        crc = __crc32b(crc, *buf++);
+    }
+    return crc;
+}
+#elif AP_CRC32_SLICE_BY_8_ENABLED
+/*
+  slice-by-8 tables. Table k gives the crc of a byte followed by k
+  zero bytes, so 8 bytes can be folded into the crc at once
+ */
+struct crc32_slice_tables {
+    uint32_t tab[8][256];
+    crc32_slice_tables() {
+        for (uint16_t i=0; i<256; i++) {
+            tab[0][i] = crc32_tab[i];
+        }
+        for (uint8_t k=1; k<8; k++) {
+            for (uint16_t i=0; i<256; i++) {
+                const uint32_t c = tab[k-1][i];
+                tab[k][i] = (c >> 8) ^ crc32_tab[c & 0xff];
+            }
+        }
+    }
+};
+
+uint32_t crc_crc32(uint32_t crc, const uint8_t *buf, uint32_t size)
+{
+    static const crc32_slice_tables slice;
+    const auto &t = slice.tab;
+    for (; size >= 8; size -= 8, buf += 8) {
+        const uint32_t lo = crc ^ (buf[0] | buf[1]<<8 | buf[2]<<16 | uint32_t(buf[3])<<24);
+        const uint32_t hi = buf[4] | buf[5]<<8 | buf[6]<<16 | uint32_t(buf[7])<<24;
+        crc = t[7][lo & 0xff] ^ t[6][(lo>>8) & 0xff] ^ t[5][(lo>>16) & 0xff] ^ t[4][lo>>24] ^
+              t[3][hi & 0xff] ^ t[2][(hi>>8) & 0xff] ^ t[1][(hi>>16) & 0xff] ^ t[0][hi>>24];
+    }
+    while (size--) {
+        crc = crc32_tab[(crc ^ *buf++) & 0xff] ^ (crc >> 8);
+    }
+    return crc;
+}
+#else
 uint32_t crc_crc32(uint32_t crc, const uint8_t *buf, uint32_t size)
 {
 	for (uint32_t i=0; i<size; i++) {
@@ -268,6 +360,7 @@ uint32_t crc_crc32(uint32_t crc, const uint8_t *buf, uint32_t size)
 
 	return crc;
 }
+#endif
 
 // smaller (and slower) crc32 for bootloader
 uint32_t crc32_small(uint32_t crc, const uint8_t *buf, uint32_t size)
@@ -383,6 +476,65 @@ void hash_fnv_1a(uint32_t len, const uint8_t* buf, uint64_t* hash)
     }
 }
 
+/*
+  CRC-24Q, as used by RTCMv3 and SBAS
+ */
+#if AP_CRC24_TABLE_ENABLED
+static const uint32_t crc24_tab[256] = {
+    0x000000, 0x864cfb, 0x8ad50d, 0x0c99f6, 0x93e6e1, 0x15aa1a,
+    0x1933ec, 0x9f7f17, 0xa18139, 0x27cdc2, 0x2b5434, 0xad18cf,
+    0x3267d8, 0xb42b23, 0xb8b2d5, 0x3efe2e, 0xc54e89, 0x430272,
+    0x4f9b84, 0xc9d77f, 0x56a868, 0xd0e493, 0xdc7d65, 0x5a319e,
+    0x64cfb0, 0xe2834b, 0xee1abd, 0x685646, 0xf72951, 0x7165aa,
+    0x7dfc5c, 0xfbb0a7, 0x0cd1e9, 0x8a9d12, 0x8604e4, 0x00481f,
+    0x9f3708, 0x197bf3, 0x15e205, 0x93aefe, 0xad50d0, 0x2b1c2b,
+    0x2785dd, 0xa1c926, 0x3eb631, 0xb8faca, 0xb4633c, 0x322fc7,
+    0xc99f60, 0x4fd39b, 0x434a6d, 0xc50696, 0x5a7981, 0xdc357a,
+    0xd0ac8c, 0x56e077, 0x681e59, 0xee52a2, 0xe2cb54, 0x6487af,
+    0xfbf8b8, 0x7db443, 0x712db5, 0xf7614e, 0x19a3d2, 0x9fef29,
+    0x9376df, 0x153a24, 0x8a4533, 0x0c09c8, 0x00903e, 0x86dcc5,
+    0xb822eb, 0x3e6e10, 0x32f7e6, 0xb4bb1d, 0x2bc40a, 0xad88f1,
+    0xa11107, 0x275dfc, 0xdced5b, 0x5aa1a0, 0x563856, 0xd074ad,
+    0x4f0bba, 0xc94741, 0xc5deb7, 0x43924c, 0x7d6c62, 0xfb2099,
+    0xf7b96f, 0x71f594, 0xee8a83, 0x68c678, 0x645f8e, 0xe21375,
+    0x15723b, 0x933ec0, 0x9fa736, 0x19ebcd, 0x8694da, 0x00d821,
+    0x0c41d7, 0x8a0d2c, 0xb4f302, 0x32bff9, 0x3e260f, 0xb86af4,
+    0x2715e3, 0xa15918, 0xadc0ee, 0x2b8c15, 0xd03cb2, 0x567049,
+    0x5ae9bf, 0xdca544, 0x43da53, 0xc596a8, 0xc90f5e, 0x4f43a5,
+    0x71bd8b, 0xf7f170, 0xfb6886, 0x7d247d, 0xe25b6a, 0x641791,
+    0x688e67, 0xeec29c, 0x3347a4, 0xb50b5f, 0xb992a9, 0x3fde52,
+    0xa0a145, 0x26edbe, 0x2a7448, 0xac38b3, 0x92c69d, 0x148a66,
+    0x181390, 0x9e5f6b, 0x01207c, 0x876c87, 0x8bf571, 0x0db98a,
+    0xf6092d, 0x7045d6, 0x7cdc20, 0xfa90db, 0x65efcc, 0xe3a337,
+    0xef3ac1, 0x69763a, 0x578814, 0xd1c4ef, 0xdd5d19, 0x5b11e2,
+    0xc46ef5, 0x42220e, 0x4ebbf8, 0xc8f703, 0x3f964d, 0xb9dab6,
+    0xb54340, 0x330fbb, 0xac70ac, 0x2a3c57, 0x26a5a1, 0xa0e95a,
+    0x9e1774, 0x185b8f, 0x14c279, 0x928e82, 0x0df195, 0x8bbd6e,
+    0x872498, 0x016863, 0xfad8c4, 0x7c943f, 0x700dc9, 0xf64132,
+    0x693e25, 0xef72de, 0xe3eb28, 0x65a7d3, 0x5b59fd, 0xdd1506,
+    0xd18cf0, 0x57c00b, 0xc8bf1c, 0x4ef3e7, 0x426a11, 0xc426ea,
+    0x2ae476, 0xaca88d, 0xa0317b, 0x267d80, 0xb90297, 0x3f4e6c,
+    0x33d79a, 0xb59b61, 0x8b654f, 0x0d29b4, 0x01b042, 0x87fcb9,
+    0x1883ae, 0x9ecf55, 0x9256a3, 0x141a58, 0xefaaff, 0x69e604,
+    0x657ff2, 0xe33309, 0x7c4c1e, 0xfa00e5, 0xf69913, 0x70d5e8,
+    0x4e2bc6, 0xc8673d, 0xc4fecb, 0x42b230, 0xddcd27, 0x5b81dc,
+    0x57182a, 0xd154d1, 0x26359f, 0xa07964, 0xace092, 0x2aac69,
+    0xb5d37e, 0x339f85, 0x3f0673, 0xb94a88, 0x87b4a6, 0x01f85d,
+    0x0d61ab, 0x8b2d50, 0x145247, 0x921ebc, 0x9e874a, 0x18cbb1,
+    0xe37b16, 0x6537ed, 0x69ae1b, 0xefe2e0, 0x709df7, 0xf6d10c,
+    0xfa48fa, 0x7c0401, 0x42fa2f, 0xc4b6d4, 0xc82f22, 0x4e63d9,
+    0xd11cce, 0x575035, 0x5bc9c3, 0xdd8538
+};
+
+uint32_t crc_crc24(const uint8_t *bytes, uint16_t len)
+{
+    uint32_t crc = 0;
+    while (len--) {
+        crc = ((crc<<8) ^ crc24_tab[((crc>>16) ^ *bytes++) & 0xff]) & 0xFFFFFF;
+    }
+    return crc;
+}
+#else
 // calculate 24 bit crc. We take an approach that saves memory and flash at the cost of higher CPU load.
 uint32_t crc_crc24(const uint8_t *bytes, uint16_t len)
 {
@@ -402,6 +554,7 @@ uint32_t crc_crc24(const uint8_t *bytes, uint16_t len)
     }
     return crc;
 }
+#endif // AP_CRC24_TABLE_ENABLED
 
 // simple 8 bit checksum used by FPort
 uint8_t crc_sum8(const uint8_t *p, uint8_t len)
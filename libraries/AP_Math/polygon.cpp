@@ -124,6 +124,117 @@ template bool Polygon_complete<int32_t>(const Vector2l *V, unsigned n);
 template bool Polygon_outside<float>(const Vector2f &P, const Vector2f *V, unsigned n);
 template bool Polygon_complete<float>(const Vector2f *V, unsigned n);
 
+template <typename T>
+bool Polygon_SoA_init(Polygon_SoA<T> &poly, const Vector2<T> *V, unsigned n, T *x, T *y)
+{
+    poly.n = 0;
+    if (Polygon_complete(V, n)) {
+        // the closing edge is implicit
+        n--;
+    }
+    if (n < 3 || n > UINT16_MAX) {
+        return false;
+    }
+    poly.bb_min = V[0];
+    poly.bb_max = V[0];
+    for (unsigned i=0; i<n; i++) {
+        x[i] = V[i].x;
+        y[i] = V[i].y;
+        poly.bb_min.x = MIN(poly.bb_min.x, V[i].x);
+        poly.bb_min.y = MIN(poly.bb_min.y, V[i].y);
+        poly.bb_max.x = MAX(poly.bb_max.x, V[i].x);
+        poly.bb_max.y = MAX(poly.bb_max.y, V[i].y);
+    }
+    poly.x = x;
+    poly.y = y;
+    poly.n = n;
+    return true;
+}
+
+/*
+  the structure of arrays kernels below are written to be vectorised
+  by the compiler, which needs O3
+ */
+#pragma GCC push_options
+#pragma GCC optimize("O3")
+
+// number of edges screened at a time by Polygon_intersects()
+#define POLYGON_INTERSECTS_BLOCK 32
+
+/*
+  return 1 if a ray from P in the +x direction crosses the edge from
+  (xi,yi) to (xj,yj), 0 otherwise. This is the same test as in
+  Polygon_outside() above, written with bitwise operations rather
+  than branches so the edge loop can be vectorised. For integer
+  polygons the products are formed in 64 bits.
+ */
+template <typename T>
+static inline unsigned Polygon_edge_crossing(const T xi, const T yi, const T xj, const T yj, const T px, const T py)
+{
+    typedef typename std::conditional<std::is_floating_point<T>::value, T, int64_t>::type wide_t;
+    const wide_t dy2 = wide_t(yj) - wide_t(yi);
+    const wide_t cross = (wide_t(px) - wide_t(xi)) * dy2 - (wide_t(xj) - wide_t(xi)) * (wide_t(py) - wide_t(yi));
+    const unsigned straddles = unsigned(yi > py) ^ unsigned(yj > py);
+    // crossing if cross is non-zero and has the opposite sign to dy2
+    const unsigned crosses = (unsigned(cross < 0) ^ unsigned(dy2 < 0)) & unsigned(cross != 0);
+    return straddles & crosses;
+}
+
+/*
+ *  Polygon_outside(): test for a point in a structure of arrays polygon
+ *     Return:  true if P is outside the polygon
+ */
+template <typename T>
+bool Polygon_outside(const Vector2<T> &P, const Polygon_SoA<T> &poly)
+{
+    const unsigned n = poly.n;
+    if (n == 0) {
+        return true;
+    }
+    if (P.x < poly.bb_min.x || P.x > poly.bb_max.x ||
+        P.y < poly.bb_min.y || P.y > poly.bb_max.y) {
+        return true;
+    }
+    const T *x = poly.x;
+    const T *y = poly.y;
+    const T px = P.x;
+    const T py = P.y;
+
+    // closing edge first, so the main loop has a fixed stride
+    unsigned crossings = Polygon_edge_crossing(x[n-1], y[n-1], x[0], y[0], px, py);
+    for (unsigned i=0; i<n-1; i++) {
+        crossings += Polygon_edge_crossing(x[i], y[i], x[i+1], y[i+1], px, py);
+    }
+    return (crossings & 1U) == 0;
+}
+
+/*
+  for the count edges starting at vertices x[0..count-1], y[0..count-1]
+  (the last ending at x_end, y_end) set candidate[k] to 1 if edge k has
+  vertices on both sides of (or on) the line through p1 in direction r2
+ */
+static void Polygon_edge_candidates(const float *x, const float *y, unsigned count, float x_end, float y_end,
+                                    const Vector2f &p1, const Vector2f &r2, uint8_t *candidate)
+{
+    float side[POLYGON_INTERSECTS_BLOCK+1];
+    for (unsigned k=0; k<count; k++) {
+        side[k] = r2.x * (y[k] - p1.y) - r2.y * (x[k] - p1.x);
+    }
+    side[count] = r2.x * (y_end - p1.y) - r2.y * (x_end - p1.x);
+    for (unsigned k=0; k<count; k++) {
+        const unsigned above = unsigned(side[k] > 0) & unsigned(side[k+1] > 0);
+        const unsigned below = unsigned(side[k] < 0) & unsigned(side[k+1] < 0);
+        candidate[k] = uint8_t((above | below) ^ 1U);
+    }
+}
+
+// Necessary to avoid linker errors
+template bool Polygon_SoA_init<int32_t>(Polygon_SoAl &poly, const Vector2l *V, unsigned n, int32_t *x, int32_t *y);
+template bool Polygon_SoA_init<float>(Polygon_SoAf &poly, const Vector2f *V, unsigned n, float *x, float *y);
+template bool Polygon_outside<int32_t>(const Vector2l &P, const Polygon_SoAl &poly);
+template bool Polygon_outside<float>(const Vector2f &P, const Polygon_SoAf &poly);
+
+#pragma GCC pop_options
 
 /*
   determine if the polygon of N verticies defined by points V is
@@ -140,8 +251,8 @@ bool Polygon_intersects(const Vector2f *V, unsigned N, const Vector2f &p1, const
     }
 
     float intersect_dist_sq = FLT_MAX;
-    for (uint8_t i=0; i<N; i++) {
-        uint8_t j = i+1;
+    for (unsigned i=0; i<N; i++) {
+        unsigned j = i+1;
         if (j >= N) {
             j = 0;
         }
@@ -172,6 +283,51 @@ bool Polygon_intersects(const Vector2f *V, unsigned N, const Vector2f &p1, const
     return (intersect_dist_sq < FLT_MAX);
 }
 
+/*
+  structure of arrays equivalent of Polygon_intersects(). The polygon
+  edges are screened in blocks with a branch-free, vectorisable test
+  of which side of the line through p1 and p2 each vertex lies on;
+  only edges with vertices on both sides (typically very few) go on to
+  the full segment intersection test
+ */
+bool Polygon_intersects(const Polygon_SoAf &poly, const Vector2f &p1, const Vector2f &p2, Vector2f &intersection)
+{
+    const unsigned n = poly.n;
+    if (n == 0) {
+        return false;
+    }
+    if (MIN(p1.x, p2.x) > poly.bb_max.x || MAX(p1.x, p2.x) < poly.bb_min.x ||
+        MIN(p1.y, p2.y) > poly.bb_max.y || MAX(p1.y, p2.y) < poly.bb_min.y) {
+        return false;
+    }
+    const float *x = poly.x;
+    const float *y = poly.y;
+    const Vector2f r2 = p2 - p1;
+
+    float intersect_dist_sq = FLT_MAX;
+    uint8_t candidate[POLYGON_INTERSECTS_BLOCK];
+    for (unsigned base=0; base<n; base+=POLYGON_INTERSECTS_BLOCK) {
+        const unsigned count = MIN(n - base, unsigned(POLYGON_INTERSECTS_BLOCK));
+        Polygon_edge_candidates(&x[base], &y[base], count, x[(base+count) % n], y[(base+count) % n], p1, r2, candidate);
+        for (unsigned k=0; k<count; k++) {
+            if (!candidate[k]) {
+                continue;
+            }
+            const unsigned i = base + k;
+            const unsigned j = (i+1 < n) ? i+1 : 0;
+            Vector2f intersect_tmp;
+            if (Vector2f::segment_intersection(Vector2f(x[i], y[i]), Vector2f(x[j], y[j]), p1, p2, intersect_tmp)) {
+                const float dist_sq = sq(intersect_tmp.x - p1.x) + sq(intersect_tmp.y - p1.y);
+                if (dist_sq < intersect_dist_sq) {
+                    intersect_dist_sq = dist_sq;
+                    intersection = intersect_tmp;
+                }
+            }
+        }
+    }
+    return (intersect_dist_sq < FLT_MAX);
+}
+
 /*
   return the closest distance that a line from p1 to p2 comes to an
   edge of closed polygon V, defined by N points
@@ -184,7 +340,7 @@ float Polygon_closest_distance_line(const Vector2f *V, unsigned N, const Vector2
         return -sqrtf(sq(intersection.x - p2.x) + sq(intersection.y - p2.y));
     }
     float closest_sq = FLT_MAX;
-    for (uint8_t i=0; i<N-1; i++) {
+    for (unsigned i=0; i<N-1; i++) {
         const Vector2f &v1 = V[i];
         const Vector2f &v2 = V[i+1];
 
@@ -203,7 +359,7 @@ float Polygon_closest_distance_line(const Vector2f *V, unsigned N, const Vector2
 float Polygon_closest_distance_point(const Vector2f *V, unsigned N, const Vector2f &p)
 {
     float closest_sq = FLT_MAX;
-    for (uint8_t i=0; i<N-1; i++) {
+    for (unsigned i=0; i<N-1; i++) {
         const Vector2f &v1 = V[i];
         const Vector2f &v2 = V[i+1];
 
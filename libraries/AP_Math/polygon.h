@@ -31,6 +31,40 @@ bool        Polygon_complete(const Vector2<T> *V, unsigned n) WARN_IF_UNUSED;
  */
 bool Polygon_intersects(const Vector2f *V, unsigned N, const Vector2f &p1, const Vector2f &p2, Vector2f &intersection) WARN_IF_UNUSED;
 
+/*
+  polygon with its vertices held as separate x and y arrays (structure
+  of arrays) plus a bounding box. The polygon is implicitly closed, so
+  the first vertex is not repeated at the end. This is intended for
+  polygons which are loaded once and then tested many times, such as
+  fences, and allows the edge loops to run without branches.
+ */
+template <typename T>
+struct Polygon_SoA {
+    const T *x;
+    const T *y;
+    uint16_t n;         // number of vertices, zero if not initialised
+    Vector2<T> bb_min;  // bounding box lower corner
+    Vector2<T> bb_max;  // bounding box upper corner
+};
+typedef Polygon_SoA<float> Polygon_SoAf;
+typedef Polygon_SoA<int32_t> Polygon_SoAl;
+
+/*
+  fill in poly from the n vertices in V, using x and y (each with room
+  for n elements) as the storage for the vertices. V may optionally be
+  closed (V[n-1]==V[0]). Returns false if there are fewer than 3 vertices
+ */
+template <typename T>
+bool        Polygon_SoA_init(Polygon_SoA<T> &poly, const Vector2<T> *V, unsigned n, T *x, T *y);
+
+/*
+  structure of arrays equivalents of Polygon_outside and
+  Polygon_intersects, with a bounding box prefilter
+ */
+template <typename T>
+bool        Polygon_outside(const Vector2<T> &P, const Polygon_SoA<T> &poly) WARN_IF_UNUSED;
+bool Polygon_intersects(const Polygon_SoAf &poly, const Vector2f &p1, const Vector2f &p2, Vector2f &intersection) WARN_IF_UNUSED;
+
 
 /*
   return the closest distance that a line from p1 to p2 comes to an
@@ -0,0 +1,116 @@
+#include <AP_gtest.h>
+
+#include <AP_Math/AP_Math.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+/*
+  bit at a time reference implementations of the table driven CRCs
+ */
+static uint32_t ref_crc32(uint32_t crc, const uint8_t *buf, uint32_t size)
+{
+    while (size--) {
+        crc ^= *buf++;
+        for (uint8_t i=0; i<8; i++) {
+            crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320 : crc >> 1;
+        }
+    }
+    return crc;
+}
+
+static uint32_t ref_crc24(const uint8_t *buf, uint16_t len)
+{
+    uint32_t crc = 0;
+    while (len--) {
+        crc ^= uint32_t(*buf++) << 16;
+        for (uint8_t i=0; i<8; i++) {
+            crc <<= 1;
+            if (crc & 0x1000000) {
+                crc ^= 0x1864CFB;
+            }
+        }
+    }
+    return crc;
+}
+
+static uint16_t ref_crc16_ccitt(uint16_t crc, const uint8_t *buf, uint16_t len)
+{
+    while (len--) {
+        crc ^= uint16_t(*buf++) << 8;
+        for (uint8_t i=0; i<8; i++) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+static uint8_t ref_crc8(uint8_t crc, const uint8_t *buf, uint16_t len, uint8_t poly)
+{
+    while (len--) {
+        crc ^= *buf++;
+        for (uint8_t i=0; i<8; i++) {
+            crc = (crc & 0x80) ? (crc << 1) ^ poly : crc << 1;
+        }
+    }
+    return crc;
+}
+
+static const uint8_t check_str[] = "123456789";
+
+// standard check values of each CRC over "123456789"
+TEST(CRCTest, CheckValues)
+{
+    EXPECT_EQ(0xCBF43926U, ~crc_crc32(0xFFFFFFFFU, check_str, 9));
+    EXPECT_EQ(0xCBF43926U, ~crc32_small(0xFFFFFFFFU, check_str, 9));
+    EXPECT_EQ(0xCDE703U, crc_crc24(check_str, 9));
+    EXPECT_EQ(0x31C3U, crc_xmodem(check_str, 9));
+    EXPECT_EQ(0x29B1U, crc16_ccitt(check_str, 9, 0xFFFF));
+    EXPECT_EQ(0xBCU, crc8_dvb_s2_update(0, check_str, 9));
+    EXPECT_EQ(0xF4U, crc8_dvb_update(0, check_str, 9));
+    EXPECT_EQ(0xF4U, crc_crc8(check_str, 9));
+}
+
+// compare against the references over every length and alignment up
+// to a few slice widths, then over longer random buffers
+TEST(CRCTest, MatchesReference)
+{
+    uint8_t buf[1100];
+    uint32_t seed = 1;
+    for (uint16_t i=0; i<sizeof(buf); i++) {
+        seed = seed * 1103515245U + 12345U;
+        buf[i] = seed >> 16;
+    }
+
+    for (uint8_t ofs=0; ofs<8; ofs++) {
+        for (uint16_t len=0; len<=40; len++) {
+            const uint8_t *p = &buf[ofs];
+            EXPECT_EQ(ref_crc32(0x12345678U, p, len), crc_crc32(0x12345678U, p, len));
+            EXPECT_EQ(ref_crc32(0x12345678U, p, len), crc32_small(0x12345678U, p, len));
+            EXPECT_EQ(ref_crc24(p, len), crc_crc24(p, len));
+            EXPECT_EQ(ref_crc16_ccitt(0, p, len), crc_xmodem(p, len));
+            EXPECT_EQ(ref_crc8(0x5A, p, len, 0xD5), crc8_dvb_s2_update(0x5A, p, len));
+            EXPECT_EQ(ref_crc8(0x5A, p, len, 0x07), crc8_dvb_update(0x5A, p, len));
+        }
+    }
+
+    for (uint16_t len=64; len<=1024; len*=2) {
+        EXPECT_EQ(ref_crc32(0, &buf[3], len), crc_crc32(0, &buf[3], len));
+        EXPECT_EQ(ref_crc24(&buf[3], len), crc_crc24(&buf[3], len));
+        EXPECT_EQ(ref_crc16_ccitt(0, &buf[3], len), crc_xmodem(&buf[3], len));
+    }
+
+    // single byte updates must chain to the same result
+    uint16_t xmodem = 0;
+    uint8_t dvb_s2 = 0;
+    uint8_t dvb = 0;
+    for (uint16_t i=0; i<100; i++) {
+        xmodem = crc_xmodem_update(xmodem, buf[i]);
+        dvb_s2 = crc8_dvb_s2(dvb_s2, buf[i]);
+        dvb = crc8_dvb(dvb, buf[i], 0xD5);
+    }
+    EXPECT_EQ(crc_xmodem(buf, 100), xmodem);
+    EXPECT_EQ(crc8_dvb_s2_update(0, buf, 100), dvb_s2);
+    EXPECT_EQ(dvb, dvb_s2);
+}
+
+AP_GTEST_MAIN()
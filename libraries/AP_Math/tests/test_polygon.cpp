@@ -356,6 +356,115 @@ TEST(Polygon, simple)
     TEST_POLYGON_POINTS(SIMPLE_boundary, SIMPLE_test_points);
 }
 
+#define TEST_POLYGON_POINTS_SOA(T, POLYGON, TEST_POINTS)                 \
+    do {                                                                \
+        T x[ARRAY_SIZE(POLYGON)];                                       \
+        T y[ARRAY_SIZE(POLYGON)];                                       \
+        Polygon_SoA<T> poly;                                            \
+        EXPECT_TRUE(Polygon_SoA_init(poly, POLYGON, ARRAY_SIZE(POLYGON), x, y)); \
+        for (uint32_t i = 0; i < ARRAY_SIZE(TEST_POINTS); i++) {        \
+            EXPECT_EQ(TEST_POINTS[i].outside,                           \
+                      Polygon_outside(TEST_POINTS[i].point, poly));     \
+        }                                                               \
+    } while(0)
+
+TEST(Polygon, soa_outside)
+{
+    for (const struct PB &pb : points_boundaries) {
+        float x[3], y[3];
+        Polygon_SoAf poly;
+        EXPECT_TRUE(Polygon_SoA_init(poly, pb.boundary, 3, x, y));
+        EXPECT_EQ(pb.outside, Polygon_outside(pb.point, poly));
+    }
+}
+
+TEST(Polygon, soa_outside_long)
+{
+    for (const struct PB_long &pb : points_boundaries_long) {
+        int32_t x[3], y[3];
+        Polygon_SoAl poly;
+        EXPECT_TRUE(Polygon_SoA_init(poly, pb.boundary, 3, x, y));
+        EXPECT_EQ(pb.outside, Polygon_outside(pb.point, poly));
+    }
+}
+
+TEST(Polygon, soa_obc)
+{
+    TEST_POLYGON_POINTS_SOA(int32_t, OBC_boundary, OBC_test_points);
+}
+
+TEST(Polygon, soa_prox)
+{
+    TEST_POLYGON_POINTS_SOA(float, PROX_boundary, PROX_test_points);
+}
+
+TEST(Polygon, soa_simple)
+{
+    TEST_POLYGON_POINTS_SOA(float, SIMPLE_boundary, SIMPLE_test_points);
+}
+
+TEST(Polygon, soa_too_few_points)
+{
+    const Vector2f line[] { {0,0}, {1,1}, {0,0}, {0,0} };
+    float x[4], y[4];
+    Polygon_SoAf poly;
+    EXPECT_FALSE(Polygon_SoA_init(poly, line, 2, x, y));
+    EXPECT_TRUE(Polygon_outside(Vector2f{0.5f,0.5f}, poly));
+    Vector2f intersection;
+    EXPECT_FALSE(Polygon_intersects(poly, Vector2f{0,1}, Vector2f{1,0}, intersection));
+}
+
+TEST(Polygon, soa_intersects)
+{
+    float x[ARRAY_SIZE(PROX_boundary)], y[ARRAY_SIZE(PROX_boundary)];
+    Polygon_SoAf poly;
+    EXPECT_TRUE(Polygon_SoA_init(poly, PROX_boundary, ARRAY_SIZE(PROX_boundary), x, y));
+
+    // a fan of segments from inside, crossing and outside the polygon
+    const Vector2f starts[] { {0,0}, {-500,500}, {3000,3000}, {-3000,0} };
+    for (const Vector2f &p1 : starts) {
+        for (uint16_t bearing = 0; bearing < 360; bearing += 5) {
+            const Vector2f p2 = p1 + Vector2f{cosf(radians(bearing)), sinf(radians(bearing))} * 2500.0f;
+            Vector2f intersection;
+            Vector2f intersection_soa;
+            const bool intersects = Polygon_intersects(PROX_boundary, ARRAY_SIZE(PROX_boundary), p1, p2, intersection);
+            EXPECT_EQ(intersects, Polygon_intersects(poly, p1, p2, intersection_soa));
+            if (intersects) {
+                EXPECT_NEAR(intersection.x, intersection_soa.x, 0.01f);
+                EXPECT_NEAR(intersection.y, intersection_soa.y, 0.01f);
+            }
+        }
+    }
+
+    // segment entirely outside the bounding box
+    Vector2f intersection;
+    EXPECT_FALSE(Polygon_intersects(poly, Vector2f{5000,5000}, Vector2f{6000,5000}, intersection));
+}
+
+// polygons of more than 255 vertices, as used by the polygon benchmarks
+TEST(Polygon, many_vertices)
+{
+    const unsigned n = 600;
+    static Vector2f poly[n+1];
+    for (unsigned i = 0; i < n; i++) {
+        const float angle = M_2PI * i / n;
+        poly[i] = Vector2f(cosf(angle), sinf(angle)) * 10000.0f;
+    }
+    poly[n] = poly[0];
+
+    EXPECT_FALSE(Polygon_outside(Vector2f{0,0}, poly, n+1));
+    EXPECT_TRUE(Polygon_outside(Vector2f{20000,0}, poly, n+1));
+
+    // segment from the center leaving the polygon on the far side from the first vertex
+    Vector2f intersection;
+    EXPECT_TRUE(Polygon_intersects(poly, n+1, Vector2f{0,0}, Vector2f{-20000,1}, intersection));
+    EXPECT_NEAR(intersection.x, -10000.0f, 1.0f);
+    EXPECT_FALSE(Polygon_intersects(poly, n+1, Vector2f{0,0}, Vector2f{-5000,1}, intersection));
+
+    EXPECT_NEAR(Polygon_closest_distance_line(poly, n+1, Vector2f{-5000,0}, Vector2f{-8000,0}), 2000.0f, 1.0f);
+    EXPECT_NEAR(Polygon_closest_distance_point(poly, n+1, Vector2f{-7000,0}), 3000.0f, 1.0f);
+}
+
 AP_GTEST_MAIN()
 
 
@@ -5,6 +5,7 @@
 #include <AP_Terrain/AP_Terrain.h>
 #include <GCS_MAVLink/GCS.h>
 #include <AP_AHRS/AP_AHRS.h>
+#include <AP_Logger/AP_Logger.h>
 #include <AP_Camera/AP_Camera.h>
 #include <AP_Gripper/AP_Gripper_config.h>
 
@@ -56,6 +57,10 @@ void AP_Mission::init()
     // command list will be cleared if they do not match
     check_eeprom_version();
 
+#if AP_MISSION_CMD_CACHE_ENABLED
+    cache_init();
+#endif
+
     // initialize the jump tracking array
     init_jump_tracking();
 
@@ -272,6 +277,8 @@ void AP_Mission::truncate(uint16_t index)
 ///     should be called at 10hz or higher
 void AP_Mission::update()
 {
+    log_lookup_stats();
+
     // exit immediately if not running or no mission commands
     if (_flags.state != MISSION_RUNNING || _cmd_total == 0) {
         return;
@@ -688,6 +695,65 @@ union PackedContent {
 
 assert_storage_size<PackedContent, 12> assert_storage_size_PackedContent;
 
+/// read_raw_cmd_from_storage - read the undecoded fields of a command from storage
+void AP_Mission::read_raw_cmd_from_storage(uint16_t index, uint16_t &id, uint16_t &p1, uint8_t *content)
+{
+    // Find out proper location in memory by using the start_byte position + the index
+    const uint16_t pos_in_storage = 4 + (index * AP_MISSION_EEPROM_COMMAND_SIZE);
+
+    memset(content, 0, 12);
+
+    const uint8_t b1 = _storage.read_byte(pos_in_storage);
+    if (b1 == 0) {
+        id = _storage.read_uint16(pos_in_storage+1);
+        p1 = _storage.read_uint16(pos_in_storage+3);
+        _storage.read_block(content, pos_in_storage+5, 10);
+    } else {
+        id = b1;
+        p1 = _storage.read_uint16(pos_in_storage+1);
+        _storage.read_block(content, pos_in_storage+3, 12);
+    }
+}
+
+/// read_raw_cmd - read the undecoded fields of a command, from the cache if possible
+void AP_Mission::read_raw_cmd(uint16_t index, uint16_t &id, uint16_t &p1, uint8_t *content) const
+{
+#if AP_MISSION_CMD_CACHE_ENABLED
+    if (index < _cache.size) {
+        id = _cache.id[index];
+        p1 = _cache.p1[index];
+        memcpy(content, _cache.content[index], 12);
+        _lookup_stats.hits++;
+        return;
+    }
+#endif
+    read_raw_cmd_from_storage(index, id, p1, content);
+}
+
+/// read_cmd_id - return the id of the command at index
+uint16_t AP_Mission::read_cmd_id(uint16_t index) const
+{
+    WITH_SEMAPHORE(_rsem);
+
+    if (index == 0) {
+        return MAV_CMD_NAV_WAYPOINT;
+    }
+    if (index >= (unsigned)_cmd_total) {
+        return AP_MISSION_CMD_ID_NONE;
+    }
+#if AP_MISSION_CMD_CACHE_ENABLED
+    if (index < _cache.size) {
+        return _cache.id[index];
+    }
+#endif
+    const uint16_t pos_in_storage = 4 + (index * AP_MISSION_EEPROM_COMMAND_SIZE);
+    const uint8_t b1 = _storage.read_byte(pos_in_storage);
+    if (b1 == 0) {
+        return _storage.read_uint16(pos_in_storage+1);
+    }
+    return b1;
+}
+
 /// load_cmd_from_storage - load command from storage
 ///     true is return if successful
 bool AP_Mission::read_cmd_from_storage(uint16_t index, Mission_Command& cmd) const
@@ -706,33 +772,20 @@ bool AP_Mission::read_cmd_from_storage(uint16_t index, Mission_Command& cmd) con
         return false;
     }
 
+    const uint32_t start_us = AP_HAL::micros();
+
     // ensure all bytes of cmd are zeroed
     cmd = {};
 
-    // Find out proper location in memory by using the start_byte position + the index
-    // we can load a command, we don't process it yet
-    // read WP position
-    const uint16_t pos_in_storage = 4 + (index * AP_MISSION_EEPROM_COMMAND_SIZE);
-
     PackedContent packed_content {};
-
-    const uint8_t b1 = _storage.read_byte(pos_in_storage);
-    if (b1 == 0) {
-        cmd.id = _storage.read_uint16(pos_in_storage+1);
-        cmd.p1 = _storage.read_uint16(pos_in_storage+3);
-        _storage.read_block(packed_content.bytes, pos_in_storage+5, 10);
-    } else {
-        cmd.id = b1;
-        cmd.p1 = _storage.read_uint16(pos_in_storage+1);
-        _storage.read_block(packed_content.bytes, pos_in_storage+3, 12);
-    }
+    read_raw_cmd(index, cmd.id, cmd.p1, packed_content.bytes);
 
     if (stored_in_location(cmd.id)) {
 #if CONFIG_HAL_BOARD == HAL_BOARD_SITL
         // NOTE!  no 16-bit command may be stored_in_location as only
         // 10 bytes are available for storage and lat/lon/alt required
         // 4*sizeof(float) == 12 bytes of storage.
-        if (b1 == 0) {
+        if (cmd.id > 255) {
             AP_HAL::panic("May not store location for 16-bit commands");
         }
 #endif
@@ -760,6 +813,11 @@ bool AP_Mission::read_cmd_from_storage(uint16_t index, Mission_Command& cmd) con
     // set command's index to it's position in eeprom
     cmd.index = index;
 
+    const uint32_t dt_us = AP_HAL::micros() - start_us;
+    _lookup_stats.count++;
+    _lookup_stats.total_us += dt_us;
+    _lookup_stats.max_us = MAX(_lookup_stats.max_us, dt_us);
+
     // return success
     return true;
 }
@@ -834,7 +892,21 @@ bool AP_Mission::write_cmd_to_storage(uint16_t index, const Mission_Command& cmd
         _storage.write_uint16(pos_in_storage+1, cmd.id);
         _storage.write_uint16(pos_in_storage+3, cmd.p1);
         _storage.write_block(pos_in_storage+5, packed.bytes, 10);
+        // only 10 bytes are stored; match what a read from storage returns
+        packed.bytes[10] = 0;
+        packed.bytes[11] = 0;
+    }
+
+#if AP_MISSION_CMD_CACHE_ENABLED
+    if (index < _cache.size) {
+        _cache.id[index] = cmd.id;
+        _cache.p1[index] = cmd.p1;
+        memcpy(_cache.content[index], packed.bytes, 12);
     }
+#endif
+#if AP_MISSION_DISTANCE_INDEX_ENABLED
+    dist_index_invalidate(index);
+#endif
 
     // remember when the mission last changed
     _last_change_time_ms = AP_HAL::millis();
@@ -2036,14 +2108,27 @@ int16_t AP_Mission::get_jump_times_run(const Mission_Command& cmd)
         return AP_MISSION_JUMP_TIMES_MAX;
     }
 
+#if AP_MISSION_CMD_CACHE_ENABLED
+    const int16_t slot = cached_jump_slot(cmd.index);
+    if (slot >= 0) {
+        return _jump_tracking[slot].num_times_run;
+    }
+#endif
+
     // search through jump_tracking array for this cmd
     for (uint8_t i=0; i<AP_MISSION_MAX_NUM_DO_JUMP_COMMANDS; i++) {
         if (_jump_tracking[i].index == cmd.index) {
+#if AP_MISSION_CMD_CACHE_ENABLED
+            cache_jump_slot(cmd.index, i);
+#endif
             return _jump_tracking[i].num_times_run;
         } else if (_jump_tracking[i].index == AP_MISSION_CMD_INDEX_NONE) {
             // we've searched through all known jump commands and haven't found it so allocate new space in _jump_tracking array
             _jump_tracking[i].index = cmd.index;
             _jump_tracking[i].num_times_run = 0;
+#if AP_MISSION_CMD_CACHE_ENABLED
+            cache_jump_slot(cmd.index, i);
+#endif
             return 0;
         }
     }
@@ -2062,8 +2147,16 @@ void AP_Mission::increment_jump_times_run(Mission_Command& cmd, bool send_gcs_ms
         return;
     }
 
-    // search through jump_tracking array for this cmd
-    for (uint8_t i=0; i<AP_MISSION_MAX_NUM_DO_JUMP_COMMANDS; i++) {
+    // search through jump_tracking array for this cmd, starting at
+    // the slot it was last found in
+    uint8_t first = 0;
+#if AP_MISSION_CMD_CACHE_ENABLED
+    const int16_t slot = cached_jump_slot(cmd.index);
+    if (slot >= 0) {
+        first = slot;
+    }
+#endif
+    for (uint8_t i=first; i<AP_MISSION_MAX_NUM_DO_JUMP_COMMANDS; i++) {
         if (_jump_tracking[i].index == cmd.index) {
             _jump_tracking[i].num_times_run++;
             if (send_gcs_msg) {
@@ -2074,6 +2167,9 @@ void AP_Mission::increment_jump_times_run(Mission_Command& cmd, bool send_gcs_ms
             // we've searched through all known jump commands and haven't found it so allocate new space in _jump_tracking array
             _jump_tracking[i].index = cmd.index;
             _jump_tracking[i].num_times_run = 1;
+#if AP_MISSION_CMD_CACHE_ENABLED
+            cache_jump_slot(cmd.index, i);
+#endif
             return;
         }
     }
@@ -2106,6 +2202,100 @@ uint16_t AP_Mission::num_commands_max(void) const
     return (_storage.size() - 4) / AP_MISSION_EEPROM_COMMAND_SIZE;
 }
 
+#if AP_MISSION_CMD_CACHE_ENABLED
+/*
+  allocate the command cache and fill it from storage. If allocation
+  fails commands are read from storage as before
+ */
+void AP_Mission::cache_init()
+{
+    WITH_SEMAPHORE(_rsem);
+
+    if (_cache.size != 0) {
+        return;
+    }
+    const uint16_t n = num_commands_max();
+    _cache.id = new uint16_t[n];
+    _cache.p1 = new uint16_t[n];
+    _cache.content = new uint8_t[n][12];
+    _cache.jump_slot = new uint8_t[n];
+    if (_cache.id == nullptr || _cache.p1 == nullptr ||
+        _cache.content == nullptr || _cache.jump_slot == nullptr) {
+        delete[] _cache.id;
+        delete[] _cache.p1;
+        delete[] _cache.content;
+        delete[] _cache.jump_slot;
+        _cache.id = nullptr;
+        _cache.p1 = nullptr;
+        _cache.content = nullptr;
+        _cache.jump_slot = nullptr;
+        return;
+    }
+    for (uint16_t i=0; i<n; i++) {
+        read_raw_cmd_from_storage(i, _cache.id[i], _cache.p1[i], _cache.content[i]);
+        _cache.jump_slot[i] = JUMP_SLOT_NONE;
+    }
+    _cache.size = n;
+}
+
+/*
+  the jump slot is only a hint; it is checked against _jump_tracking
+  so it stays valid across init_jump_tracking() and mission changes
+ */
+int16_t AP_Mission::cached_jump_slot(uint16_t index) const
+{
+    if (index >= _cache.size) {
+        return -1;
+    }
+    const uint8_t slot = _cache.jump_slot[index];
+    if (slot >= AP_MISSION_MAX_NUM_DO_JUMP_COMMANDS || _jump_tracking[slot].index != index) {
+        return -1;
+    }
+    return slot;
+}
+
+void AP_Mission::cache_jump_slot(uint16_t index, uint8_t slot)
+{
+    if (index < _cache.size) {
+        _cache.jump_slot[index] = slot;
+    }
+}
+#endif // AP_MISSION_CMD_CACHE_ENABLED
+
+/*
+  log command read counts and timing once a second
+ */
+void AP_Mission::log_lookup_stats()
+{
+#if HAL_LOGGING_ENABLED
+    WITH_SEMAPHORE(_rsem);
+
+    const uint32_t now_ms = AP_HAL::millis();
+    if (now_ms - _lookup_stats.last_log_ms < 1000) {
+        return;
+    }
+    _lookup_stats.last_log_ms = now_ms;
+    if (_lookup_stats.count == 0) {
+        return;
+    }
+
+    // @LoggerMessage: MISL
+    // @Description: Mission command lookup timing
+    // @Field: TimeUS: Time since system startup
+    // @Field: N: number of commands read since the last message
+    // @Field: Hit: number of those commands read from the RAM cache
+    // @Field: Avg: average time to read a command
+    // @Field: Max: longest time to read a command
+    AP::logger().Write("MISL", "TimeUS,N,Hit,Avg,Max", "s--ss", "F--FF", "QIIII",
+                       AP_HAL::micros64(),
+                       _lookup_stats.count,
+                       _lookup_stats.hits,
+                       _lookup_stats.total_us / _lookup_stats.count,
+                       _lookup_stats.max_us);
+    _lookup_stats = { 0, 0, 0, 0, now_ms };
+#endif
+}
+
 // find the nearest landing sequence starting point (DO_LAND_START) and
 // return its index.  Returns 0 if no appropriate DO_LAND_START point can
 // be found.
@@ -2122,20 +2312,21 @@ uint16_t AP_Mission::get_landing_sequence_start()
 
     // Go through mission looking for nearest landing start command
     for (uint16_t i = 1; i < num_commands(); i++) {
+        if (read_cmd_id(i) != MAV_CMD_DO_LAND_START) {
+            continue;
+        }
         Mission_Command tmp;
         if (!read_cmd_from_storage(i, tmp)) {
             continue;
         }
-        if (tmp.id == MAV_CMD_DO_LAND_START) {
-            if (!tmp.content.location.initialised() && !get_next_nav_cmd(i, tmp)) {
-                // command does not have a valid location and cannot get next valid
-                continue;
-            }
-            float tmp_distance = tmp.content.location.get_distance(current_loc);
-            if (min_distance < 0 || tmp_distance < min_distance) {
-                min_distance = tmp_distance;
-                landing_start_index = i;
-            }
+        if (!tmp.content.location.initialised() && !get_next_nav_cmd(i, tmp)) {
+            // command does not have a valid location and cannot get next valid
+            continue;
+        }
+        float tmp_distance = tmp.content.location.get_distance(current_loc);
+        if (min_distance < 0 || tmp_distance < min_distance) {
+            min_distance = tmp_distance;
+            landing_start_index = i;
         }
     }
 
@@ -2276,6 +2467,13 @@ bool AP_Mission::distance_to_landing(uint16_t index, float &tot_distance, Locati
     tot_distance = 0.0f;
     bool ret;
 
+#if AP_MISSION_DISTANCE_INDEX_ENABLED
+    if (distance_to_landing_indexed(index, tot_distance, prev_loc, ret)) {
+        return ret;
+    }
+    tot_distance = 0.0f;
+#endif
+
     // back up jump tracking to reset after distance calculation
     jump_tracking_struct _jump_tracking_backup[AP_MISSION_MAX_NUM_DO_JUMP_COMMANDS];
     for (uint8_t i=0; i<AP_MISSION_MAX_NUM_DO_JUMP_COMMANDS; i++) {
@@ -2328,6 +2526,160 @@ reset_do_jump_tracking:
     return ret;
 }
 
+#if AP_MISSION_DISTANCE_INDEX_ENABLED
+// mark commands from index on as needing to be indexed again
+void AP_Mission::dist_index_invalidate(uint16_t index)
+{
+    _dist_index.valid = MIN(_dist_index.valid, index);
+}
+
+/*
+  bring the distance index up to date with the mission, starting
+  from the first command changed since the last update. Returns false
+  if the index could not be allocated
+ */
+bool AP_Mission::dist_index_update()
+{
+    if (_dist_index.size == 0) {
+        const uint16_t n = num_commands_max();
+        _dist_index.wp_index = new uint16_t[n];
+        _dist_index.wp_cum = new float[n];
+        _dist_index.stop_index = new uint16_t[n];
+        if (_dist_index.wp_index == nullptr || _dist_index.wp_cum == nullptr || _dist_index.stop_index == nullptr) {
+            delete[] _dist_index.wp_index;
+            delete[] _dist_index.wp_cum;
+            delete[] _dist_index.stop_index;
+            _dist_index.wp_index = nullptr;
+            _dist_index.wp_cum = nullptr;
+            _dist_index.stop_index = nullptr;
+            return false;
+        }
+        _dist_index.size = n;
+        _dist_index.valid = 0;
+        _dist_index.num_wp = 0;
+        _dist_index.num_stop = 0;
+    }
+
+    const uint16_t total = MIN(num_commands(), _dist_index.size);
+    if (_dist_index.valid == total) {
+        return true;
+    }
+    const uint16_t start = MAX(MIN(_dist_index.valid, total), AP_MISSION_FIRST_REAL_COMMAND);
+
+    // drop entries for changed commands
+    while (_dist_index.num_wp > 0 && _dist_index.wp_index[_dist_index.num_wp-1] >= start) {
+        _dist_index.num_wp--;
+    }
+    while (_dist_index.num_stop > 0 && _dist_index.stop_index[_dist_index.num_stop-1] >= start) {
+        _dist_index.num_stop--;
+    }
+
+    Location prev_loc;
+    float cum = 0;
+    if (_dist_index.num_wp > 0) {
+        Mission_Command cmd;
+        if (!read_cmd_from_storage(_dist_index.wp_index[_dist_index.num_wp-1], cmd)) {
+            return false;
+        }
+        prev_loc = cmd.content.location;
+        cum = _dist_index.wp_cum[_dist_index.num_wp-1];
+    }
+
+    // classify commands the same way distance_to_landing() does
+    for (uint16_t i=start; i<total; i++) {
+        Mission_Command cmd;
+        if (!read_cmd_from_storage(i, cmd)) {
+            return false;
+        }
+        if (cmd.id == MAV_CMD_DO_JUMP) {
+            _dist_index.stop_index[_dist_index.num_stop++] = i;
+        } else if (cmd.id == MAV_CMD_NAV_WAYPOINT || cmd.id == MAV_CMD_NAV_SPLINE_WAYPOINT || is_landing_type_cmd(cmd.id)) {
+            if (!(cmd.content.location.lat == 0 && cmd.content.location.lng == 0)) {
+                if (_dist_index.num_wp > 0) {
+                    cum += prev_loc.get_distance(cmd.content.location);
+                }
+                _dist_index.wp_index[_dist_index.num_wp] = i;
+                _dist_index.wp_cum[_dist_index.num_wp] = cum;
+                _dist_index.num_wp++;
+                prev_loc = cmd.content.location;
+            }
+            if (is_landing_type_cmd(cmd.id)) {
+                _dist_index.stop_index[_dist_index.num_stop++] = i;
+            }
+        } else if (is_nav_cmd(cmd) || cmd.id == MAV_CMD_CONDITION_DELAY) {
+            _dist_index.stop_index[_dist_index.num_stop++] = i;
+        }
+    }
+    _dist_index.valid = total;
+    return true;
+}
+
+// index of the first element of a sorted list that is >= value
+static uint16_t index_lower_bound(const uint16_t *list, uint16_t n, uint16_t value)
+{
+    uint16_t lo = 0;
+    while (n > 0) {
+        const uint16_t half = n / 2;
+        if (list[lo+half] < value) {
+            lo += half + 1;
+            n -= half + 1;
+        } else {
+            n = half;
+        }
+    }
+    return lo;
+}
+
+/*
+  with no DO_JUMP between index and the landing the distance is the
+  first leg from prev_loc plus a difference of cumulative distances
+ */
+bool AP_Mission::distance_to_landing_indexed(uint16_t index, float &tot_distance, const Location &prev_loc, bool &result)
+{
+    WITH_SEMAPHORE(_rsem);
+
+    // home is not stored in the mission so is not indexed
+    if (index < AP_MISSION_FIRST_REAL_COMMAND || index >= (unsigned)_cmd_total) {
+        return false;
+    }
+    if (!dist_index_update() || _dist_index.valid < (unsigned)_cmd_total) {
+        return false;
+    }
+
+    const uint16_t s = index_lower_bound(_dist_index.stop_index, _dist_index.num_stop, index);
+    if (s == _dist_index.num_stop) {
+        // we would get to the end of the mission
+        result = false;
+        return true;
+    }
+    const uint16_t stop = _dist_index.stop_index[s];
+    const uint16_t stop_id = read_cmd_id(stop);
+    if (stop_id == MAV_CMD_DO_JUMP) {
+        // depends on the jump state; leave it to the full search
+        return false;
+    }
+    if (!is_landing_type_cmd(stop_id)) {
+        // can't measure past this command
+        result = false;
+        return true;
+    }
+
+    const uint16_t first = index_lower_bound(_dist_index.wp_index, _dist_index.num_wp, index);
+    if (first < _dist_index.num_wp && _dist_index.wp_index[first] <= stop) {
+        Mission_Command cmd;
+        if (!read_cmd_from_storage(_dist_index.wp_index[first], cmd)) {
+            return false;
+        }
+        // the last waypoint at or before the landing
+        const uint16_t last = index_lower_bound(_dist_index.wp_index, _dist_index.num_wp, stop+1) - 1;
+        tot_distance = prev_loc.get_distance(cmd.content.location) +
+            _dist_index.wp_cum[last] - _dist_index.wp_cum[first];
+    }
+    result = true;
+    return true;
+}
+#endif // AP_MISSION_DISTANCE_INDEX_ENABLED
+
 // check if command is a landing type command.
 bool AP_Mission::is_landing_type_cmd(uint16_t id) const
 {
@@ -2475,11 +2827,7 @@ const char *AP_Mission::Mission_Command::type() const
 bool AP_Mission::contains_item(MAV_CMD command) const
 {
     for (int i = 1; i < num_commands(); i++) {
-        Mission_Command tmp;
-        if (!read_cmd_from_storage(i, tmp)) {
-            continue;
-        }
-        if (tmp.id == command) {
+        if (read_cmd_id(i) == command) {
             return true;
         }
     }
@@ -645,6 +645,68 @@ private:
 
     static bool stored_in_location(uint16_t id);
 
+    // read the id, p1 and 12 packed content bytes of a command, from
+    // the cache if available
+    void read_raw_cmd(uint16_t index, uint16_t &id, uint16_t &p1, uint8_t *content) const;
+    static void read_raw_cmd_from_storage(uint16_t index, uint16_t &id, uint16_t &p1, uint8_t *content);
+
+    // id of the stored command at index, AP_MISSION_CMD_ID_NONE if
+    // index is out of range. Cheaper than read_cmd_from_storage()
+    uint16_t read_cmd_id(uint16_t index) const;
+
+#if AP_MISSION_CMD_CACHE_ENABLED
+    // copy of every stored command slot, kept coherent by
+    // write_cmd_to_storage(). Laid out as parallel arrays so scans
+    // for a command id only touch the id array
+    struct {
+        uint16_t *id;
+        uint16_t *p1;
+        uint8_t (*content)[12];
+        uint8_t *jump_slot;     // _jump_tracking index of DO_JUMP commands, JUMP_SLOT_NONE otherwise
+        uint16_t size;          // number of slots held, zero if not allocated
+    } _cache;
+    static const uint8_t JUMP_SLOT_NONE = 0xFF;
+    void cache_init();
+
+    // remembered _jump_tracking index of the DO_JUMP at index, or -1
+    // if not known
+    int16_t cached_jump_slot(uint16_t index) const;
+    void cache_jump_slot(uint16_t index, uint8_t slot);
+#endif
+
+#if AP_MISSION_DISTANCE_INDEX_ENABLED
+    // sorted lists of the commands distance_to_landing() measures to,
+    // with the cumulative leg distance from the first of them, and of
+    // the commands it stops at. Built forward through the mission and
+    // updated from the first changed command when next queried
+    struct {
+        uint16_t *wp_index;     // commands with a location that count towards distance
+        float *wp_cum;          // distance along the legs from wp_index[0]
+        uint16_t *stop_index;   // landings, DO_JUMPs and unmeasurable nav commands
+        uint16_t num_wp;
+        uint16_t num_stop;
+        uint16_t valid;         // commands below this index are indexed
+        uint16_t size;          // zero if not allocated
+    } _dist_index;
+    bool dist_index_update();
+    void dist_index_invalidate(uint16_t index);
+
+    // distance_to_landing() using the index. Returns false if the
+    // index can't answer, e.g. a DO_JUMP is reached first, otherwise
+    // sets result to what distance_to_landing() would return
+    bool distance_to_landing_indexed(uint16_t index, float &tot_distance, const Location &prev_loc, bool &result);
+#endif
+
+    // time spent reading commands, logged once a second
+    mutable struct {
+        uint32_t count;
+        uint32_t hits;          // reads served from the cache
+        uint32_t total_us;
+        uint32_t max_us;
+        uint32_t last_log_ms;
+    } _lookup_stats;
+    void log_lookup_stats();
+
     struct Mission_Flags {
         mission_state state;
         bool nav_cmd_loaded;         // true if a "navigation" command has been loaded into _nav_cmd
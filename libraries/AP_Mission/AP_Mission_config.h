@@ -3,3 +3,13 @@
 #ifndef AP_MISSION_ENABLED
 #define AP_MISSION_ENABLED 1
 #endif
+
+// keep a RAM copy of the stored mission so lookups don't go to storage
+#ifndef AP_MISSION_CMD_CACHE_ENABLED
+#define AP_MISSION_CMD_CACHE_ENABLED (HAL_MEM_CLASS >= HAL_MEM_CLASS_500)
+#endif
+
+// index of waypoint distances for distance to landing queries
+#ifndef AP_MISSION_DISTANCE_INDEX_ENABLED
+#define AP_MISSION_DISTANCE_INDEX_ENABLED AP_MISSION_CMD_CACHE_ENABLED
+#endif
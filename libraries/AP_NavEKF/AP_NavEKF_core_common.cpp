@@ -17,9 +17,11 @@
 #include "AP_NavEKF_core_common.h"
 
 NavEKF_core_common::Matrix24 NavEKF_core_common::KH;
+#if !HAL_NAVEKF_CORE_SCRATCH_PER_CORE
 NavEKF_core_common::Matrix24 NavEKF_core_common::KHP;
 NavEKF_core_common::Matrix24 NavEKF_core_common::nextP;
 NavEKF_core_common::Vector28 NavEKF_core_common::Kfusion;
+#endif
 
 /*
   fill common scratch variables, for detecting re-use of variables between loops in SITL
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <stdint.h>
+#include <AP_HAL/AP_HAL_Boards.h>
 #include <AP_Math/AP_Math.h>
 #include <AP_Math/vectorN.h>
 #include "AP_Nav_Common.h"
@@ -30,7 +31,14 @@
   we also save a lot of CPU (approx 10% on STM32F427) as the compiler
   is able to resolve the address of these variables at compile time,
   which means significantly faster code
+
+  Boards which can update EKF cores on separate threads give each
+  core its own copy instead
  */
+#ifndef HAL_NAVEKF_CORE_SCRATCH_PER_CORE
+#define HAL_NAVEKF_CORE_SCRATCH_PER_CORE (CONFIG_HAL_BOARD == HAL_BOARD_LINUX)
+#endif
+
 class NavEKF_core_common {
 public:
 #if MATH_CHECK_INDEXES
@@ -42,10 +50,17 @@ public:
 #endif
 
 protected:
+    // only used by EKF2, whose cores are always updated in turn
     static Matrix24 KH;                   // intermediate result used for covariance updates
+#if HAL_NAVEKF_CORE_SCRATCH_PER_CORE
+    Matrix24 KHP;                         // intermediate result used for covariance updates
+    Matrix24 nextP;                       // Predicted covariance matrix before addition of process noise to diagonals
+    Vector28 Kfusion;                     // intermediate fusion vector
+#else
     static Matrix24 KHP;                  // intermediate result used for covariance updates
     static Matrix24 nextP;                // Predicted covariance matrix before addition of process noise to diagonals
     static Vector28 Kfusion;              // intermediate fusion vector
+#endif
 
     // fill all the common scratch variables with NaN on SITL
     void fill_scratch_variables(void);
@@ -45,63 +45,105 @@ uint32_t ekf_ring_buffer::time_ms(uint8_t idx) const
     return el->time_ms;
 }
 
+/*
+  return the number of elements, starting from the oldest, that are
+  not younger than sample_time_ms. Stops at the first younger element
+  so data pushed out of time order is never skipped over
+*/
+uint8_t ekf_ring_buffer::count_not_younger(const uint32_t sample_time_ms) const
+{
+    if (!in_order) {
+        uint8_t n = 0;
+        while (n < count && int32_t(sample_time_ms - time_ms(index_after_oldest(n))) >= 0) {
+            n++;
+        }
+        return n;
+    }
+    // elements are in time order, so binary search for the first
+    // element younger than the sample time
+    uint8_t lo = 0;
+    uint8_t hi = count;
+    while (lo < hi) {
+        const uint8_t mid = (lo + hi) / 2;
+        if (int32_t(sample_time_ms - time_ms(index_after_oldest(mid))) >= 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
 /*
   Search through a ring buffer and return the newest data that is
   older than the time specified by sample_time_ms
-  Returns false if no data can be found that is less than 100msec old
+  Returns nullptr if no data can be found that is less than 100msec old
 */
-bool ekf_ring_buffer::recall(void *element, const uint32_t sample_time_ms)
+const void *ekf_ring_buffer::recall(const uint32_t sample_time_ms)
 {
-    bool ret = false;
-    while (count > 0) {
-        const uint32_t toldest = time_ms(oldest);
-        const int32_t dt = sample_time_ms - toldest;
-        const bool matches = dt >= 0 && dt < 100;
-        if (matches) {
-            memcpy(element, get_offset(oldest), elsize);
-            ret = true;
+    const uint8_t n = count_not_younger(sample_time_ms);
+    if (n == 0) {
+        // the oldest element is younger than we want
+        return nullptr;
+    }
+
+    // use the newest of those samples that is less than 100msec
+    // old. When in time order that can only be the newest one
+    const void *ret = nullptr;
+    for (int16_t i=n-1; i>=0; i--) {
+        const uint8_t idx = index_after_oldest(i);
+        const int32_t dt = sample_time_ms - time_ms(idx);
+        if (dt < 100) {
+            ret = get_offset(idx);
+            break;
         }
-        if (dt < 0) {
-            // the oldest element is younger than we want, stop
-            // searching and don't consume this element
+        if (in_order) {
             break;
         }
-        // discard the sample
-        count--;
-        oldest = (oldest+1) % size;
+    }
+
+    // discard the samples so they cannot be used again
+    oldest = index_after_oldest(n);
+    count -= n;
+    if (count == 0) {
+        in_order = true;
     }
     return ret;
 }
 
 /*
- * Writes data and timestamp to a Ring buffer and advances indices that
- * define the location of the newest and oldest data
+ * Advances indices that define the location of the newest and oldest
+ * data and returns the slot to write new data to
  */
-void ekf_ring_buffer::push(const void *element)
+void *ekf_ring_buffer::push(const uint32_t element_time_ms)
 {
     if (buffer == nullptr) {
-        return;
+        return nullptr;
     }
 
-    // Advance head to next available index
-    const uint8_t head = (oldest+count) % size;
+    if (count > 0 && int32_t(element_time_ms - newest_ms) < 0) {
+        in_order = false;
+    }
+    newest_ms = element_time_ms;
 
-    // New data is written at the head
-    memcpy(get_offset(head), element, elsize);
+    // Advance head to next available index
+    const uint8_t head = index_after_oldest(count);
 
     if (count < size) {
         count++;
     } else {
-        oldest = (oldest+1) % size;
+        oldest = index_after_oldest(1);
     }
-}
 
+    return get_offset(head);
+}
 
 // zeroes all data in the ring buffer
 void ekf_ring_buffer::reset()
 {
     count = 0;
     oldest = 0;
+    in_order = true;
 }
 
 ////////////////////////////////////////////////////
@@ -22,22 +22,26 @@ public:
     // initialise buffer, returns false when allocation has failed
     bool init(uint8_t size);
 
+    // zeroes all data in the ring buffer
+    void reset();
+
+protected:
     /*
-     * Searches through a ring buffer and return the newest data that is older than the
-     * time specified by sample_time_ms
-     * Zeros old data so it cannot not be used again
-     * Returns false if no data can be found that is less than 100msec old
+     * Searches through a ring buffer for the newest data that is older than the
+     * time specified by sample_time_ms, discarding it and all older data so it
+     * cannot be used again
+     * Returns a pointer to the data, valid until the next push, or nullptr if no
+     * data can be found that is less than 100msec old
     */
-    bool recall(void *element, const uint32_t sample_time_ms);
+    const void *recall(const uint32_t sample_time_ms);
 
     /*
-     * Writes data and timestamp to a Ring buffer and advances indices that
-     * define the location of the newest and oldest data
+     * Advances indices that define the location of the newest and oldest data
+     * and returns a pointer to the slot the new data, with timestamp
+     * element_time_ms, should be written to, or nullptr if the buffer is not
+     * allocated
     */
-    void push(const void *element);
-
-    // zeroes all data in the ring buffer
-    void reset();
+    void *push(const uint32_t element_time_ms);
 
 private:
     const uint8_t elsize;
@@ -52,8 +56,25 @@ private:
     // total number of elements in the buffer
     uint8_t count;
 
+    // true while the elements in the buffer are in time order, which
+    // allows recall to binary search for the newest matching element
+    bool in_order;
+
+    // timestamp of the newest element
+    uint32_t newest_ms;
+
     uint32_t time_ms(uint8_t idx) const;
     void *get_offset(uint8_t idx) const;
+
+    // index of the element n places after the oldest
+    uint8_t index_after_oldest(uint8_t n) const {
+        const uint16_t idx = uint16_t(oldest) + n;
+        return idx >= size ? idx - size : idx;
+    }
+
+    // number of elements, starting from the oldest, that are not
+    // younger than sample_time_ms
+    uint8_t count_not_younger(const uint32_t sample_time_ms) const;
 };
 
 /*
@@ -76,11 +97,19 @@ public:
     }
 
     bool recall(element_type &element,uint32_t sample_time) {
-        return ekf_ring_buffer::recall(&element, sample_time);
+        const element_type *ret = (const element_type *)ekf_ring_buffer::recall(sample_time);
+        if (ret == nullptr) {
+            return false;
+        }
+        element = *ret;
+        return true;
     }
 
     void push(const element_type &element) {
-        return ekf_ring_buffer::push(&element);
+        element_type *slot = (element_type *)ekf_ring_buffer::push(element.time_ms);
+        if (slot != nullptr) {
+            *slot = element;
+        }
     }
 
     void reset() {
@@ -0,0 +1,82 @@
+#include <AP_gbenchmark.h>
+
+#include <AP_Math/AP_Math.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+/*
+  covariance correction KHP = K*H*P for a scalar observation whose H
+  has range_x() non-zero elements, as formed by the EKF3 fusions
+ */
+
+typedef ftype Matrix24[24][24];
+
+static Matrix24 P, KH, KHP;
+static ftype K[24], H[24];
+
+static void setup(uint8_t n)
+{
+    for (uint8_t i=0; i<24; i++) {
+        K[i] = 0.01 * (i + 1);
+        H[i] = i < n ? 0.5 + i : 0;
+        for (uint8_t j=0; j<24; j++) {
+            P[i][j] = (i == j) ? 1.0 : 0.001 * (i + j);
+        }
+    }
+}
+
+// the full expansion, skipping the known zero columns of KH as the
+// hand-written fusions did
+static void BM_KHPExpanded(benchmark::State& state)
+{
+    const uint8_t n = state.range_x();
+    setup(n);
+    while (state.KeepRunning()) {
+        for (uint8_t i=0; i<24; i++) {
+            for (uint8_t j=0; j<n; j++) {
+                KH[i][j] = K[i] * H[j];
+            }
+            for (uint8_t j=n; j<24; j++) {
+                KH[i][j] = 0;
+            }
+        }
+        for (uint8_t j=0; j<24; j++) {
+            for (uint8_t i=0; i<24; i++) {
+                ftype res = 0;
+                for (uint8_t k=0; k<n; k++) {
+                    res += KH[i][k] * P[k][j];
+                }
+                KHP[i][j] = res;
+            }
+        }
+        gbenchmark_escape(&KHP);
+    }
+}
+
+// H*P formed once and scaled by each gain
+static void BM_KHPRankOne(benchmark::State& state)
+{
+    const uint8_t n = state.range_x();
+    setup(n);
+    while (state.KeepRunning()) {
+        ftype HP[24];
+        for (uint8_t j=0; j<24; j++) {
+            ftype res = 0;
+            for (uint8_t k=0; k<n; k++) {
+                res += H[k] * P[k][j];
+            }
+            HP[j] = res;
+        }
+        for (uint8_t i=0; i<24; i++) {
+            for (uint8_t j=0; j<24; j++) {
+                KHP[i][j] = K[i] * HP[j];
+            }
+        }
+        gbenchmark_escape(&KHP);
+    }
+}
+
+BENCHMARK(BM_KHPExpanded)->Arg(1)->Arg(3)->Arg(7)->Arg(10);
+BENCHMARK(BM_KHPRankOne)->Arg(1)->Arg(3)->Arg(7)->Arg(10);
+
+BENCHMARK_MAIN();
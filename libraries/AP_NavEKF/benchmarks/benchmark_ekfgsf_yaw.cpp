@@ -0,0 +1,64 @@
+#include <AP_gbenchmark.h>
+
+#include <AP_NavEKF/EKFGSF_yaw.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+/*
+  IMU samples at 400Hz for a vehicle in a gentle level turn
+ */
+static const ftype imu_dt = 0.0025;
+
+static void imu_sample(uint32_t i, Vector3F &delAng, Vector3F &delVel)
+{
+    const ftype t = i * imu_dt;
+    delAng = Vector3F(0.01 * sinF(t), 0.01 * cosF(t), 0.2) * imu_dt;
+    delVel = Vector3F(0.5 * cosF(t), 0.5 * sinF(t), -GRAVITY_MSS) * imu_dt;
+}
+
+// get the yaw estimator aligned and fusing velocity
+static void setup_gsf(EKFGSF_yaw &gsf, uint32_t &i)
+{
+    Vector3F delAng, delVel;
+    for (i = 0; i < 4000; i++) {
+        imu_sample(i, delAng, delVel);
+        gsf.update(delAng, delVel, imu_dt, imu_dt, true, 0);
+        if (i % 80 == 0) {
+            gsf.fuseVelData(Vector2F(5.0 * cosF(i * imu_dt * 0.2), 5.0 * sinF(i * imu_dt * 0.2)), 0.5);
+        }
+    }
+}
+
+static void BM_EKFGSF_update(benchmark::State& state)
+{
+    EKFGSF_yaw *gsf = new EKFGSF_yaw();
+    uint32_t i;
+    setup_gsf(*gsf, i);
+    Vector3F delAng, delVel;
+
+    while (state.KeepRunning()) {
+        imu_sample(i++, delAng, delVel);
+        gsf->update(delAng, delVel, imu_dt, imu_dt, true, 0);
+        gbenchmark_escape(gsf);
+    }
+    delete gsf;
+}
+
+static void BM_EKFGSF_fuseVelData(benchmark::State& state)
+{
+    EKFGSF_yaw *gsf = new EKFGSF_yaw();
+    uint32_t i;
+    setup_gsf(*gsf, i);
+    const Vector2F vel(5.0, 0.5);
+
+    while (state.KeepRunning()) {
+        gsf->fuseVelData(vel, 0.5);
+        gbenchmark_escape(gsf);
+    }
+    delete gsf;
+}
+
+BENCHMARK(BM_EKFGSF_update);
+BENCHMARK(BM_EKFGSF_fuseVelData);
+
+BENCHMARK_MAIN();
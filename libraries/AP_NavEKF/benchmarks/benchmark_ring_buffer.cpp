@@ -0,0 +1,58 @@
+#include <AP_gbenchmark.h>
+
+#include <AP_NavEKF/EKF_Buffer.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+struct bm_data : EKF_obs_element_t {
+    float data[10];
+};
+
+/*
+  push a sample every 10ms and recall 200ms behind, as the EKF does
+  for sensors that are sampled faster than the fusion rate
+ */
+static void BM_EKFBufferPushRecall(benchmark::State& state)
+{
+    EKF_obs_buffer_t<bm_data> buf;
+    buf.init(state.range_x());
+    bm_data d {}, d2;
+    uint32_t now_ms = 1000;
+
+    while (state.KeepRunning()) {
+        d.time_ms = now_ms;
+        buf.push(d);
+        bool found = buf.recall(d2, now_ms - 200);
+        gbenchmark_escape(&found);
+        gbenchmark_escape(&d2);
+        now_ms += 10;
+    }
+}
+
+/*
+  fill the buffer and recall the newest sample, discarding all of it
+ */
+static void BM_EKFBufferRecallFull(benchmark::State& state)
+{
+    EKF_obs_buffer_t<bm_data> buf;
+    const uint8_t size = state.range_x();
+    buf.init(size);
+    bm_data d {}, d2;
+    uint32_t now_ms = 1000;
+
+    while (state.KeepRunning()) {
+        for (uint8_t i=0; i<size; i++) {
+            d.time_ms = now_ms;
+            buf.push(d);
+            now_ms += 10;
+        }
+        bool found = buf.recall(d2, now_ms);
+        gbenchmark_escape(&found);
+        gbenchmark_escape(&d2);
+    }
+}
+
+BENCHMARK(BM_EKFBufferPushRecall)->Arg(8)->Arg(32)->Arg(64);
+BENCHMARK(BM_EKFBufferRecallFull)->Arg(8)->Arg(32)->Arg(64);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,160 @@
+#include <AP_gtest.h>
+
+/*
+  check that the rank-one covariance correction used by the EKF3
+  scalar fusions matches the full K*H*P expansion it replaced, for the
+  H sparsity pattern of each fusion. Both forms are implemented here,
+  so this checks the algebra only; it does not run the NavEKF3_core
+  fusion code and so would not catch a wrong H index in a fusion
+ */
+
+#include <AP_Math/AP_Math.h>
+
+#if CONFIG_HAL_BOARD == HAL_BOARD_SITL || CONFIG_HAL_BOARD == HAL_BOARD_LINUX
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+typedef ftype Matrix24[24][24];
+
+// non-zero elements of H for each scalar observation type
+static const struct {
+    const char *name;
+    uint8_t n;
+    uint8_t idx[10];
+} patterns[] = {
+    { "vel_pos", 1, { 4 } },
+    { "hgt", 1, { 9 } },
+    { "mag", 10, { 0, 1, 2, 3, 16, 17, 18, 19, 20, 21 } },
+    { "yaw", 4, { 0, 1, 2, 3 } },
+    { "decl", 2, { 16, 17 } },
+    { "tas", 5, { 4, 5, 6, 22, 23 } },
+    { "beta", 9, { 0, 1, 2, 3, 4, 5, 6, 22, 23 } },
+    { "body_vel", 7, { 0, 1, 2, 3, 4, 5, 6 } },
+    { "flow", 7, { 0, 1, 2, 3, 4, 5, 6 } },
+    { "rng_bcn", 3, { 7, 8, 9 } },
+};
+
+static ftype rand_float(uint32_t &seed)
+{
+    seed = seed * 1664525U + 1013904223U;
+    return ftype(seed >> 8) / ftype(1U << 24) - 0.5;
+}
+
+// a symmetric positive definite covariance with EKF-like scaling
+static void make_covariance(Matrix24 &P, uint32_t seed)
+{
+    Matrix24 A;
+    for (uint8_t i=0; i<24; i++) {
+        for (uint8_t j=0; j<24; j++) {
+            A[i][j] = rand_float(seed);
+        }
+    }
+    for (uint8_t i=0; i<24; i++) {
+        for (uint8_t j=0; j<=i; j++) {
+            ftype sum = 0;
+            for (uint8_t k=0; k<24; k++) {
+                sum += A[i][k] * A[j][k];
+            }
+            P[i][j] = P[j][i] = sum * 0.01;
+        }
+        P[i][i] += 0.001;
+    }
+}
+
+// the full expansion: KH = K*H, then KHP = KH*P
+static void expanded_KHP(const ftype *K, const ftype *H, const Matrix24 &P, Matrix24 &KHP)
+{
+    Matrix24 KH;
+    for (uint8_t i=0; i<24; i++) {
+        for (uint8_t j=0; j<24; j++) {
+            KH[i][j] = K[i] * H[j];
+        }
+    }
+    for (uint8_t i=0; i<24; i++) {
+        for (uint8_t j=0; j<24; j++) {
+            ftype res = 0;
+            for (uint8_t k=0; k<24; k++) {
+                res += KH[i][k] * P[k][j];
+            }
+            KHP[i][j] = res;
+        }
+    }
+}
+
+// the rank-one form: HP = H*P over the non-zero elements of H, then
+// each row of KHP is HP scaled by one gain
+static void rank_one_KHP(const ftype *K, const ftype *H, const uint8_t *idx, uint8_t n, const Matrix24 &P, Matrix24 &KHP)
+{
+    ftype HP[24];
+    for (uint8_t j=0; j<24; j++) {
+        HP[j] = 0;
+        for (uint8_t k=0; k<n; k++) {
+            HP[j] += H[idx[k]] * P[idx[k]][j];
+        }
+    }
+    for (uint8_t i=0; i<24; i++) {
+        for (uint8_t j=0; j<24; j++) {
+            KHP[i][j] = K[i] * HP[j];
+        }
+    }
+}
+
+TEST(EKF_CovarianceUpdate, rank_one_matches_expansion)
+{
+    // relative tolerance for rounding differences
+#if HAL_WITH_EKF_DOUBLE
+    const ftype tol = 1e-12;
+#else
+    const ftype tol = 1e-5;
+#endif
+    uint32_t seed = 1;
+    for (const auto &pattern : patterns) {
+        for (uint8_t trial=0; trial<20; trial++) {
+            Matrix24 P, KHP1, KHP2;
+            make_covariance(P, seed++);
+            ftype H[24] {};
+            for (uint8_t k=0; k<pattern.n; k++) {
+                H[pattern.idx[k]] = rand_float(seed) * 10;
+            }
+            if (pattern.n == 1) {
+                // direct observation of a state
+                H[pattern.idx[0]] = 1;
+            }
+            // K = P*H'/(H*P*H' + R)
+            ftype K[24];
+            ftype HPHt = 0;
+            for (uint8_t i=0; i<24; i++) {
+                ftype PHt = 0;
+                for (uint8_t k=0; k<pattern.n; k++) {
+                    PHt += P[i][pattern.idx[k]] * H[pattern.idx[k]];
+                }
+                K[i] = PHt;
+                HPHt += H[i] * PHt;
+            }
+            for (uint8_t i=0; i<24; i++) {
+                K[i] /= HPHt + 0.1;
+            }
+
+            expanded_KHP(K, H, P, KHP1);
+            rank_one_KHP(K, H, pattern.idx, pattern.n, P, KHP2);
+
+            ftype max_abs = 0;
+            for (uint8_t i=0; i<24; i++) {
+                for (uint8_t j=0; j<24; j++) {
+                    max_abs = MAX(max_abs, fabsF(KHP1[i][j]));
+                }
+            }
+            for (uint8_t i=0; i<24; i++) {
+                for (uint8_t j=0; j<24; j++) {
+                    EXPECT_LE(fabsF(KHP1[i][j] - KHP2[i][j]), tol * max_abs) << pattern.name << " " << int(i) << "," << int(j);
+                }
+                // the variance check before the update sees the same values
+                EXPECT_EQ(KHP1[i][i] > P[i][i], KHP2[i][i] > P[i][i]) << pattern.name;
+            }
+        }
+    }
+}
+
+AP_GTEST_MAIN()
+
+#endif // HAL_SITL or HAL_LINUX
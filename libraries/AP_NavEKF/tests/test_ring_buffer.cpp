@@ -119,6 +119,75 @@ TEST(EKF_Buffer, EKF_Buffer)
     EXPECT_FALSE(buf.recall(d2, 103));
 }
 
+/*
+  data pushed out of time order must not be skipped over
+ */
+TEST(EKF_Buffer, EKF_Buffer_out_of_order)
+{
+    struct test_data : EKF_obs_element_t {
+        uint32_t data;
+    };
+    EKF_obs_buffer_t<test_data> buf;
+    buf.init(8);
+    struct test_data d, d2;
+
+    d.time_ms = 950;
+    d.data = 1;
+    buf.push(d);
+    d.time_ms = 100;
+    d.data = 2;
+    buf.push(d);
+    d.time_ms = 1100;
+    d.data = 3;
+    buf.push(d);
+
+    // the second element is too old, so the first is used
+    EXPECT_TRUE(buf.recall(d2, 1000));
+    EXPECT_EQ(d2.data, 1U);
+    EXPECT_TRUE(buf.recall(d2, 1100));
+    EXPECT_EQ(d2.data, 3U);
+    EXPECT_FALSE(buf.recall(d2, 1200));
+
+    // an element younger than the sample time stops the search
+    d.time_ms = 1300;
+    d.data = 4;
+    buf.push(d);
+    d.time_ms = 1250;
+    d.data = 5;
+    buf.push(d);
+    EXPECT_FALSE(buf.recall(d2, 1260));
+    EXPECT_TRUE(buf.recall(d2, 1300));
+    EXPECT_EQ(d2.data, 5U);
+}
+
+/*
+  recall from a deep buffer that has wrapped
+ */
+TEST(EKF_Buffer, EKF_Buffer_deep)
+{
+    struct test_data : EKF_obs_element_t {
+        uint32_t data;
+    };
+    EKF_obs_buffer_t<test_data> buf;
+    buf.init(50);
+    struct test_data d, d2;
+
+    for (uint32_t i=0; i<120; i++) {
+        d.time_ms = 1000 + i*10;
+        d.data = i;
+        buf.push(d);
+    }
+    // only the last 50 remain
+    EXPECT_FALSE(buf.recall(d2, 1000 + 69*10));
+    EXPECT_TRUE(buf.recall(d2, 1000 + 75*10 + 5));
+    EXPECT_EQ(d2.data, 75U);
+    EXPECT_TRUE(buf.recall(d2, 1000 + 76*10));
+    EXPECT_EQ(d2.data, 76U);
+    EXPECT_TRUE(buf.recall(d2, 1000 + 119*10 + 50));
+    EXPECT_EQ(d2.data, 119U);
+    EXPECT_FALSE(buf.recall(d2, 1000 + 119*10 + 50));
+}
+
 AP_GTEST_MAIN()
 
 #endif // HAL_SITL or HAL_LINUX
@@ -737,6 +737,15 @@ const AP_Param::GroupInfo NavEKF3::var_info2[] = {
     // @Units: m
     AP_GROUPINFO("GPS_VACC_MAX", 10, NavEKF3, _gpsVAccThreshold, 0.0f),
 
+#if EK3_FEATURE_PARALLEL_CORES
+    // @Param: CORE_THREADS
+    // @DisplayName: Run EKF cores on separate threads
+    // @Description: When enabled and more than one EKF3 core is running, each core after the first is updated on its own thread, in parallel with the first core. This lets more cores run at the full rate on boards with multiple CPU cores. Takes effect once the EKF origin has been set. Setting it to 0 stops the threads and runs the cores in turn again.
+    // @Values: 0:Disabled,1:Enabled
+    // @User: Advanced
+    AP_GROUPINFO("CORE_THREADS", 11, NavEKF3, _coreThreads, 0),
+#endif
+
     AP_GROUPEND
 };
 
@@ -905,19 +914,41 @@ void NavEKF3::UpdateFilter(void)
         return;
     }
 
+    EK3_PROFILE(UpdateFilter);
+
     imuSampleTime_us = AP::dal().micros64();
 
-    for (uint8_t i=0; i<num_cores; i++) {
-        // if we have not overrun by more than 3 IMU frames, and we
-        // have already used more than 1/3 of the CPU budget for this
-        // loop then suppress the prediction step. This allows
-        // multiple EKF instances to cooperate on scheduling
-        bool allow_state_prediction = true;
-        if (core[i].getFramesSincePredict() < (_framesPerPrediction+3) &&
-            AP::dal().ekf_low_time_remaining(AP_DAL::EKFType::EKF3, i)) {
-            allow_state_prediction = false;
+#if EK3_FEATURE_PARALLEL_CORES
+    /*
+      the origin is shared between cores and set by whichever core
+      gets there first, so only run cores in parallel once it is set
+     */
+    if (_coreThreads <= 0 && coreWorkers.started()) {
+        coreWorkers.stop();
+    }
+    if (_coreThreads > 0 && num_cores > 1 && common_origin_valid &&
+        coreWorkers.start(core, num_cores)) {
+        bool allow_state_prediction[MAX_EKF_CORES];
+        uint32_t run_time_us[MAX_EKF_CORES];
+        for (uint8_t i=0; i<num_cores; i++) {
+            allow_state_prediction[i] = coreAllowStatePrediction(i);
+        }
+        coreWorkers.update(allow_state_prediction, run_time_us);
+        for (uint8_t i=0; i<num_cores; i++) {
+            updateCoreRunTime(i, run_time_us[i]);
+        }
+    } else
+#endif
+    {
+        for (uint8_t i=0; i<num_cores; i++) {
+#if EK3_FEATURE_PARALLEL_CORES
+            const uint32_t start_us = AP_HAL::micros();
+#endif
+            core[i].UpdateFilter(coreAllowStatePrediction(i));
+#if EK3_FEATURE_PARALLEL_CORES
+            updateCoreRunTime(i, AP_HAL::micros() - start_us);
+#endif
         }
-        core[i].UpdateFilter(allow_state_prediction);
     }
 
     // If the current core selected has a bad error score or is unhealthy, switch to a healthy core with the lowest fault score
@@ -1006,6 +1037,29 @@ void NavEKF3::UpdateFilter(void)
     sources.align_inactive_sources();
 }
 
+/*
+  if we have not overrun by more than 3 IMU frames, and we have
+  already used more than 1/3 of the CPU budget for this loop then
+  suppress the prediction step. This allows multiple EKF instances
+  to cooperate on scheduling
+*/
+bool NavEKF3::coreAllowStatePrediction(uint8_t i)
+{
+    return !(core[i].getFramesSincePredict() < (_framesPerPrediction+3) &&
+             AP::dal().ekf_low_time_remaining(AP_DAL::EKFType::EKF3, i));
+}
+
+#if EK3_FEATURE_PARALLEL_CORES
+// accumulate the time taken to update a core for logging
+void NavEKF3::updateCoreRunTime(uint8_t i, uint32_t dt_us)
+{
+    auto &t = coreRunTime[i];
+    t.count++;
+    t.total_us += dt_us;
+    t.max_us = MAX(t.max_us, dt_us);
+}
+#endif
+
 /*
   check if switching lanes will reduce the normalised
   innovations. This is called when the vehicle code is about to
@@ -2053,3 +2107,14 @@ const EKFGSF_yaw *NavEKF3::get_yawEstimator(void) const
     }
     return nullptr;
 }
+
+#if EK3_FEATURE_PROFILE
+// time spent in each function of a core
+const NavEKF3_Profile *NavEKF3::get_core_profile(uint8_t i) const
+{
+    if (!core || i >= num_cores) {
+        return nullptr;
+    }
+    return &core[i].get_profile();
+}
+#endif
@@ -24,6 +24,9 @@
 #include <AP_Param/AP_Param.h>
 #include <AP_NavEKF/AP_Nav_Common.h>
 #include <AP_NavEKF/AP_NavEKF_Source.h>
+#include "AP_NavEKF3_feature.h"
+#include "AP_NavEKF3_CoreWorkers.h"
+#include "AP_NavEKF3_Profile.h"
 
 class NavEKF3_core;
 class EKFGSF_yaw;
@@ -356,6 +359,15 @@ public:
     // get a yaw estimator instance
     const EKFGSF_yaw *get_yawEstimator(void) const;
 
+#if EK3_FEATURE_PROFILE
+    // time spent updating all cores each IMU frame
+    const NavEKF3_Profile &get_frame_profile(void) const { return profile; }
+
+    // time spent in each function of a core, nullptr if the core
+    // does not exist
+    const NavEKF3_Profile *get_core_profile(uint8_t i) const;
+#endif
+
 private:
     uint8_t num_cores; // number of allocated cores
     uint8_t primary;   // current primary core
@@ -439,6 +451,9 @@ private:
     AP_Int8 _primary_core;          // initial core number
     AP_Enum<LogLevel> _log_level;   // log verbosity level
     AP_Float _gpsVAccThreshold;     // vertical accuracy threshold to use GPS as an altitude source
+#if EK3_FEATURE_PARALLEL_CORES
+    AP_Int8 _coreThreads;           // non-zero to update cores on worker threads
+#endif
 
 // Possible values for _flowUse
 #define FLOW_USE_NONE    0
@@ -552,6 +567,29 @@ private:
     // checks for alignment
     bool coreBetterScore(uint8_t new_core, uint8_t current_core) const;
 
+    // return false if a core should skip its state prediction as
+    // the loop is short of time
+    bool coreAllowStatePrediction(uint8_t i);
+
+#if EK3_FEATURE_PARALLEL_CORES
+    NavEKF3_CoreWorkers coreWorkers;
+
+    // time taken to update each core since it was last logged
+    struct {
+        uint32_t count;
+        uint32_t total_us;
+        uint32_t max_us;
+    } coreRunTime[MAX_EKF_CORES];
+    uint32_t lastCoreRunTimeLog_ms;
+
+    void updateCoreRunTime(uint8_t i, uint32_t dt_us);
+    void Log_Write_CoreRunTime(void);
+#endif
+
+#if EK3_FEATURE_PROFILE
+    NavEKF3_Profile profile;
+#endif
+
     // position, velocity and yaw source control
     AP_NavEKF_Source sources;
 };
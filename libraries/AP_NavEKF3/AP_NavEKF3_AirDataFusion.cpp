@@ -19,6 +19,8 @@
 */
 void NavEKF3_core::FuseAirspeed()
 {
+    EK3_PROFILE(FuseAirspeed);
+
     // declarations
     ftype vn;
     ftype ve;
@@ -156,31 +158,19 @@ void NavEKF3_core::FuseAirspeed()
             stateStruct.quat.normalize();
 
             // correct the covariance P = (I - K*H)*P
-            // take advantage of the empty columns in KH to reduce the
-            // number of operations
-            for (unsigned i = 0; i<=stateIndexLim; i++) {
-                for (unsigned j = 0; j<=3; j++) {
-                    KH[i][j] = 0.0f;
-                }
-                for (unsigned j = 4; j<=6; j++) {
-                    KH[i][j] = Kfusion[i] * H_TAS[j];
-                }
-                for (unsigned j = 7; j<=21; j++) {
-                    KH[i][j] = 0.0f;
-                }
-                for (unsigned j = 22; j<=23; j++) {
-                    KH[i][j] = Kfusion[i] * H_TAS[j];
-                }
-            }
+            // K*H is an outer product, so form H*P once from the non-zero
+            // elements of H and scale it by each gain
+            ftype HP[24];
             for (unsigned j = 0; j<=stateIndexLim; j++) {
-                for (unsigned i = 0; i<=stateIndexLim; i++) {
-                    ftype res = 0;
-                    res += KH[i][4] * P[4][j];
-                    res += KH[i][5] * P[5][j];
-                    res += KH[i][6] * P[6][j];
-                    res += KH[i][22] * P[22][j];
-                    res += KH[i][23] * P[23][j];
-                    KHP[i][j] = res;
+                HP[j] = H_TAS[4] * P[4][j]
+                      + H_TAS[5] * P[5][j]
+                      + H_TAS[6] * P[6][j]
+                      + H_TAS[22] * P[22][j]
+                      + H_TAS[23] * P[23][j];
+            }
+            for (unsigned i = 0; i<=stateIndexLim; i++) {
+                for (unsigned j = 0; j<=stateIndexLim; j++) {
+                    KHP[i][j] = Kfusion[i] * HP[j];
                 }
             }
             for (unsigned i = 0; i<=stateIndexLim; i++) {
@@ -280,6 +270,8 @@ void NavEKF3_core::SelectBetaDragFusion()
 */
 void NavEKF3_core::FuseSideslip()
 {
+    EK3_PROFILE(FuseSideslip);
+
     // declarations
     ftype q0;
     ftype q1;
@@ -442,32 +434,23 @@ void NavEKF3_core::FuseSideslip()
         stateStruct.quat.normalize();
 
         // correct the covariance P = (I - K*H)*P
-        // take advantage of the empty columns in KH to reduce the
-        // number of operations
-        for (unsigned i = 0; i<=stateIndexLim; i++) {
-            for (unsigned j = 0; j<=6; j++) {
-                KH[i][j] = Kfusion[i] * H_BETA[j];
-            }
-            for (unsigned j = 7; j<=21; j++) {
-                KH[i][j] = 0.0f;
-            }
-            for (unsigned j = 22; j<=23; j++) {
-                KH[i][j] = Kfusion[i] * H_BETA[j];
-            }
-        }
+        // K*H is an outer product, so form H*P once from the non-zero
+        // elements of H and scale it by each gain
+        ftype HP[24];
         for (unsigned j = 0; j<=stateIndexLim; j++) {
-            for (unsigned i = 0; i<=stateIndexLim; i++) {
-                ftype res = 0;
-                res += KH[i][0] * P[0][j];
-                res += KH[i][1] * P[1][j];
-                res += KH[i][2] * P[2][j];
-                res += KH[i][3] * P[3][j];
-                res += KH[i][4] * P[4][j];
-                res += KH[i][5] * P[5][j];
-                res += KH[i][6] * P[6][j];
-                res += KH[i][22] * P[22][j];
-                res += KH[i][23] * P[23][j];
-                KHP[i][j] = res;
+            HP[j] = H_BETA[0] * P[0][j]
+                  + H_BETA[1] * P[1][j]
+                  + H_BETA[2] * P[2][j]
+                  + H_BETA[3] * P[3][j]
+                  + H_BETA[4] * P[4][j]
+                  + H_BETA[5] * P[5][j]
+                  + H_BETA[6] * P[6][j]
+                  + H_BETA[22] * P[22][j]
+                  + H_BETA[23] * P[23][j];
+        }
+        for (unsigned i = 0; i<=stateIndexLim; i++) {
+            for (unsigned j = 0; j<=stateIndexLim; j++) {
+                KHP[i][j] = Kfusion[i] * HP[j];
             }
         }
         for (unsigned i = 0; i<=stateIndexLim; i++) {
@@ -490,6 +473,8 @@ void NavEKF3_core::FuseSideslip()
 */
 void NavEKF3_core::FuseDragForces()
 {
+    EK3_PROFILE(FuseDragForces);
+
     // drag model parameters
     const ftype bcoef_x = frontend->_ballisticCoef_x;
     const ftype bcoef_y = frontend->_ballisticCoef_y;
@@ -717,32 +702,23 @@ void NavEKF3_core::FuseDragForces()
         stateStruct.quat.normalize();
 
         // correct the covariance P = (I - K*H)*P
-        // take advantage of the empty columns in KH to reduce the
-        // number of operations
-        for (unsigned i = 0; i<=stateIndexLim; i++) {
-            for (unsigned j = 0; j<=6; j++) {
-                KH[i][j] = Kfusion[i] * Hfusion[j];
-            }
-            for (unsigned j = 7; j<=21; j++) {
-                KH[i][j] = 0.0f;
-            }
-            for (unsigned j = 22; j<=23; j++) {
-                KH[i][j] = Kfusion[i] * Hfusion[j];
-            }
-        }
+        // K*H is an outer product, so form H*P once from the non-zero
+        // elements of H and scale it by each gain
+        ftype HP[24];
         for (unsigned j = 0; j<=stateIndexLim; j++) {
-            for (unsigned i = 0; i<=stateIndexLim; i++) {
-                ftype res = 0;
-                res += KH[i][0] * P[0][j];
-                res += KH[i][1] * P[1][j];
-                res += KH[i][2] * P[2][j];
-                res += KH[i][3] * P[3][j];
-                res += KH[i][4] * P[4][j];
-                res += KH[i][5] * P[5][j];
-                res += KH[i][6] * P[6][j];
-                res += KH[i][22] * P[22][j];
-                res += KH[i][23] * P[23][j];
-                KHP[i][j] = res;
+            HP[j] = Hfusion[0] * P[0][j]
+                  + Hfusion[1] * P[1][j]
+                  + Hfusion[2] * P[2][j]
+                  + Hfusion[3] * P[3][j]
+                  + Hfusion[4] * P[4][j]
+                  + Hfusion[5] * P[5][j]
+                  + Hfusion[6] * P[6][j]
+                  + Hfusion[22] * P[22][j]
+                  + Hfusion[23] * P[23][j];
+        }
+        for (unsigned i = 0; i<=stateIndexLim; i++) {
+            for (unsigned j = 0; j<=stateIndexLim; j++) {
+                KHP[i][j] = Kfusion[i] * HP[j];
             }
         }
         for (unsigned i = 0; i<=stateIndexLim; i++) {
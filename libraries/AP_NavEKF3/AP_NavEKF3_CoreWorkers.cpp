@@ -0,0 +1,123 @@
+#include "AP_NavEKF3_CoreWorkers.h"
+
+#if EK3_FEATURE_PARALLEL_CORES
+
+#include <AP_HAL/AP_HAL.h>
+#include "AP_NavEKF3_core.h"
+
+extern const AP_HAL::HAL& hal;
+
+// the core update is stack hungry, give workers the same room as
+// the main thread would have
+#define EK3_CORE_WORKER_STACK_SIZE 65536
+
+bool NavEKF3_CoreWorkers::start(NavEKF3_core *cores, uint8_t num_cores)
+{
+    if (_started) {
+        return cores == _cores && num_cores == _num_cores;
+    }
+    if (_failed || num_cores < 2 || num_cores > max_cores) {
+        return false;
+    }
+    _cores = cores;
+    _num_cores = num_cores;
+    _next_worker = 1;
+    _frame = 0;
+    _pending = 0;
+    _running = 0;
+    _stop = false;
+    for (uint8_t i=1; i<num_cores; i++) {
+        if (!hal.scheduler->thread_create(FUNCTOR_BIND_MEMBER(&NavEKF3_CoreWorkers::worker, void),
+                                          "EK3core", EK3_CORE_WORKER_STACK_SIZE,
+                                          AP_HAL::Scheduler::PRIORITY_MAIN, 0)) {
+            // don't leave the threads we did start waiting for work
+            _failed = true;
+            stop();
+            return false;
+        }
+        pthread_mutex_lock(&_mutex);
+        _running++;
+        pthread_mutex_unlock(&_mutex);
+    }
+    _started = true;
+    return true;
+}
+
+void NavEKF3_CoreWorkers::stop(void)
+{
+    pthread_mutex_lock(&_mutex);
+    _stop = true;
+    pthread_cond_broadcast(&_start_cond);
+    while (_running > 0) {
+        pthread_cond_wait(&_done_cond, &_mutex);
+    }
+    pthread_mutex_unlock(&_mutex);
+    _started = false;
+}
+
+void NavEKF3_CoreWorkers::update(const bool *allow_state_prediction, uint32_t *run_time_us)
+{
+    pthread_mutex_lock(&_mutex);
+    for (uint8_t i=0; i<_num_cores; i++) {
+        _allow_state_prediction[i] = allow_state_prediction[i];
+    }
+    _pending = _num_cores - 1;
+    _frame++;
+    pthread_cond_broadcast(&_start_cond);
+    pthread_mutex_unlock(&_mutex);
+
+    const uint32_t start_us = AP_HAL::micros();
+    _cores[0].UpdateFilter(allow_state_prediction[0]);
+    run_time_us[0] = AP_HAL::micros() - start_us;
+
+    pthread_mutex_lock(&_mutex);
+    while (_pending > 0) {
+        pthread_cond_wait(&_done_cond, &_mutex);
+    }
+    for (uint8_t i=1; i<_num_cores; i++) {
+        run_time_us[i] = _run_time_us[i];
+    }
+    pthread_mutex_unlock(&_mutex);
+}
+
+void NavEKF3_CoreWorkers::worker(void)
+{
+    pthread_mutex_lock(&_mutex);
+    const uint8_t idx = _next_worker++;
+    pthread_mutex_unlock(&_mutex);
+
+    // start from zero rather than _frame so a frame posted before
+    // this thread got going is not missed
+    uint32_t last_frame = 0;
+
+    while (true) {
+        pthread_mutex_lock(&_mutex);
+        while (_frame == last_frame && !_stop) {
+            pthread_cond_wait(&_start_cond, &_mutex);
+        }
+        if (_stop) {
+            break;
+        }
+        last_frame = _frame;
+        const bool allow_state_prediction = _allow_state_prediction[idx];
+        pthread_mutex_unlock(&_mutex);
+
+        const uint32_t start_us = AP_HAL::micros();
+        _cores[idx].UpdateFilter(allow_state_prediction);
+        const uint32_t dt_us = AP_HAL::micros() - start_us;
+
+        pthread_mutex_lock(&_mutex);
+        _run_time_us[idx] = dt_us;
+        if (--_pending == 0) {
+            pthread_cond_broadcast(&_done_cond);
+        }
+        pthread_mutex_unlock(&_mutex);
+    }
+
+    // still holding _mutex
+    _running--;
+    pthread_cond_broadcast(&_done_cond);
+    pthread_mutex_unlock(&_mutex);
+}
+
+#endif // EK3_FEATURE_PARALLEL_CORES
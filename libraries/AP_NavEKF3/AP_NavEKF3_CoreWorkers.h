@@ -0,0 +1,83 @@
+/*
+  worker threads to run EKF3 cores in parallel
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "AP_NavEKF3_feature.h"
+
+#if EK3_FEATURE_PARALLEL_CORES
+
+#include <pthread.h>
+#include <stdint.h>
+#include <AP_NavEKF/AP_NavEKF_core_common.h>
+
+#if !HAL_NAVEKF_CORE_SCRATCH_PER_CORE
+#error "EK3_FEATURE_PARALLEL_CORES needs HAL_NAVEKF_CORE_SCRATCH_PER_CORE"
+#endif
+
+class NavEKF3_core;
+
+/*
+  runs UpdateFilter() for all but the first core on worker threads,
+  with the first core run on the calling thread. Each core has its
+  own state and scratch space. The frontend and DAL are shared but
+  are not changed while cores update, other than the DAL's takeoff
+  expected flag which cores only ever set. update() does not return
+  until all cores have finished, so lane selection always sees a
+  complete frame
+ */
+class NavEKF3_CoreWorkers {
+public:
+    // start a worker thread for each core after the first. Returns
+    // false if the threads could not be started, in which case the
+    // cores should be run in turn
+    bool start(NavEKF3_core *cores, uint8_t num_cores);
+
+    // stop the worker threads, returning once they have exited
+    void stop(void);
+
+    bool started(void) const { return _started; }
+
+    // update all cores, returning when all are done. The time taken
+    // by each core is returned in run_time_us
+    void update(const bool *allow_state_prediction, uint32_t *run_time_us);
+
+private:
+    static constexpr uint8_t max_cores = 3;
+
+    void worker(void);
+
+    NavEKF3_core *_cores;
+    uint8_t _num_cores;
+    bool _started;
+    // set if starting threads failed, so it is not tried again
+    bool _failed;
+
+    pthread_mutex_t _mutex = PTHREAD_MUTEX_INITIALIZER;
+    pthread_cond_t _start_cond = PTHREAD_COND_INITIALIZER;
+    pthread_cond_t _done_cond = PTHREAD_COND_INITIALIZER;
+
+    // protected by _mutex
+    uint8_t _next_worker;
+    uint32_t _frame;
+    uint8_t _pending;
+    uint8_t _running;       // worker threads which have not exited
+    bool _stop;
+    bool _allow_state_prediction[max_cores];
+    uint32_t _run_time_us[max_cores];
+};
+
+#endif // EK3_FEATURE_PARALLEL_CORES
@@ -360,9 +360,50 @@ void NavEKF3::Log_Write()
         core[i].Log_Write(time_us);
     }
 
+#if EK3_FEATURE_PARALLEL_CORES
+    Log_Write_CoreRunTime();
+#endif
+
     AP::dal().start_frame(AP_DAL::FrameType::LogWriteEKF3);
 }
 
+#if EK3_FEATURE_PARALLEL_CORES
+// log the time taken to update each core at 1Hz
+void NavEKF3::Log_Write_CoreRunTime(void)
+{
+    const uint32_t now_ms = AP::dal().millis();
+    if (now_ms - lastCoreRunTimeLog_ms < 1000) {
+        return;
+    }
+    lastCoreRunTimeLog_ms = now_ms;
+
+    const bool parallel = coreWorkers.started();
+    for (uint8_t i=0; i<activeCores(); i++) {
+        auto &t = coreRunTime[i];
+        if (t.count == 0) {
+            continue;
+        }
+// @LoggerMessage: XKCT
+// @Description: EKF3 core update time
+// @Field: TimeUS: Time since system startup
+// @Field: C: EKF3 core this data is for
+// @Field: Par: true if cores were updated in parallel
+// @Field: N: number of updates
+// @Field: Avg: average update time
+// @Field: Max: longest update time
+        AP::logger().Write("XKCT", "TimeUS,C,Par,N,Avg,Max",
+                           "s#--ss", "F---FF", "QBBIII",
+                           AP::dal().micros64(),
+                           DAL_CORE(i),
+                           uint8_t(parallel),
+                           t.count,
+                           t.total_us / t.count,
+                           t.max_us);
+        t = {};
+    }
+}
+#endif
+
 void NavEKF3_core::Log_Write(uint64_t time_us)
 {
     const auto level = frontend->_log_level;
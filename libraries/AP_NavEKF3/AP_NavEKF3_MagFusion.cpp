@@ -443,6 +443,8 @@ void NavEKF3_core::SelectMagFusion()
 */
 void NavEKF3_core::FuseMagnetometer()
 {
+    EK3_PROFILE(FuseMagnetometer);
+
     // declarations
     ftype &q0 = mag_state.q0;
     ftype &q1 = mag_state.q1;
@@ -813,36 +815,24 @@ void NavEKF3_core::FuseMagnetometer()
             magFusePerformed = true;
         }
         // correct the covariance P = (I - K*H)*P
-        // take advantage of the empty columns in KH to reduce the
-        // number of operations
-        for (unsigned i = 0; i<=stateIndexLim; i++) {
-            for (unsigned j = 0; j<=3; j++) {
-                KH[i][j] = Kfusion[i] * H_MAG[j];
-            }
-            for (unsigned j = 4; j<=15; j++) {
-                KH[i][j] = 0.0f;
-            }
-            for (unsigned j = 16; j<=21; j++) {
-                KH[i][j] = Kfusion[i] * H_MAG[j];
-            }
-            for (unsigned j = 22; j<=23; j++) {
-                KH[i][j] = 0.0f;
-            }
-        }
+        // K*H is an outer product, so form H*P once from the non-zero
+        // elements of H and scale it by each gain
+        ftype HP[24];
         for (unsigned j = 0; j<=stateIndexLim; j++) {
-            for (unsigned i = 0; i<=stateIndexLim; i++) {
-                ftype res = 0;
-                res += KH[i][0] * P[0][j];
-                res += KH[i][1] * P[1][j];
-                res += KH[i][2] * P[2][j];
-                res += KH[i][3] * P[3][j];
-                res += KH[i][16] * P[16][j];
-                res += KH[i][17] * P[17][j];
-                res += KH[i][18] * P[18][j];
-                res += KH[i][19] * P[19][j];
-                res += KH[i][20] * P[20][j];
-                res += KH[i][21] * P[21][j];
-                KHP[i][j] = res;
+            HP[j] = H_MAG[0] * P[0][j]
+                  + H_MAG[1] * P[1][j]
+                  + H_MAG[2] * P[2][j]
+                  + H_MAG[3] * P[3][j]
+                  + H_MAG[16] * P[16][j]
+                  + H_MAG[17] * P[17][j]
+                  + H_MAG[18] * P[18][j]
+                  + H_MAG[19] * P[19][j]
+                  + H_MAG[20] * P[20][j]
+                  + H_MAG[21] * P[21][j];
+        }
+        for (unsigned i = 0; i<=stateIndexLim; i++) {
+            for (unsigned j = 0; j<=stateIndexLim; j++) {
+                KHP[i][j] = Kfusion[i] * HP[j];
             }
         }
         // Check that we are not going to drive any variances negative and skip the update if so
@@ -898,6 +888,8 @@ void NavEKF3_core::FuseMagnetometer()
 */
 bool NavEKF3_core::fuseEulerYaw(yawFusionMethod method)
 {
+    EK3_PROFILE(FuseEulerYaw);
+
     const ftype &q0 = stateStruct.quat[0];
     const ftype &q1 = stateStruct.quat[1];
     const ftype &q2 = stateStruct.quat[2];
@@ -1176,20 +1168,19 @@ bool NavEKF3_core::fuseEulerYaw(yawFusionMethod method)
         magHealth = true;
     }
 
-    // correct the covariance using P = P - K*H*P taking advantage of the fact that only the first 3 elements in H are non zero
-    // calculate K*H*P
-    for (uint8_t row = 0; row <= stateIndexLim; row++) {
-        for (uint8_t column = 0; column <= 3; column++) {
-            KH[row][column] = Kfusion[row] * H_YAW[column];
-        }
+    // correct the covariance using P = P - K*H*P taking advantage of the fact that only the first 4 elements in H are non zero
+    // K*H is an outer product, so form H*P once from the non-zero
+    // elements of H and scale it by each gain
+    ftype HP[24];
+    for (unsigned j = 0; j<=stateIndexLim; j++) {
+        HP[j] = H_YAW[0] * P[0][j]
+              + H_YAW[1] * P[1][j]
+              + H_YAW[2] * P[2][j]
+              + H_YAW[3] * P[3][j];
     }
-    for (uint8_t row = 0; row <= stateIndexLim; row++) {
-        for (uint8_t column = 0; column <= stateIndexLim; column++) {
-            ftype tmp = KH[row][0] * P[0][column];
-            tmp += KH[row][1] * P[1][column];
-            tmp += KH[row][2] * P[2][column];
-            tmp += KH[row][3] * P[3][column];
-            KHP[row][column] = tmp;
+    for (unsigned i = 0; i<=stateIndexLim; i++) {
+        for (unsigned j = 0; j<=stateIndexLim; j++) {
+            KHP[i][j] = Kfusion[i] * HP[j];
         }
     }
 
@@ -1237,6 +1228,8 @@ bool NavEKF3_core::fuseEulerYaw(yawFusionMethod method)
 */
 void NavEKF3_core::FuseDeclination(ftype declErr)
 {
+    EK3_PROFILE(FuseDeclination);
+
     // declination error variance (rad^2)
     const ftype R_DECL = sq(declErr);
 
@@ -1358,21 +1351,16 @@ void NavEKF3_core::FuseDeclination(ftype declErr)
     }
 
     // correct the covariance P = (I - K*H)*P
-    // take advantage of the empty columns in KH to reduce the
-    // number of operations
-    for (unsigned i = 0; i<=stateIndexLim; i++) {
-        for (unsigned j = 0; j<=15; j++) {
-            KH[i][j] = 0.0f;
-        }
-        KH[i][16] = Kfusion[i] * H_DECL[16];
-        KH[i][17] = Kfusion[i] * H_DECL[17];
-        for (unsigned j = 18; j<=23; j++) {
-            KH[i][j] = 0.0f;
-        }
-    }
+    // K*H is an outer product, so form H*P once from the non-zero
+    // elements of H and scale it by each gain
+    ftype HP[24];
     for (unsigned j = 0; j<=stateIndexLim; j++) {
-        for (unsigned i = 0; i<=stateIndexLim; i++) {
-            KHP[i][j] = KH[i][16] * P[16][j] + KH[i][17] * P[17][j];
+        HP[j] = H_DECL[16] * P[16][j]
+              + H_DECL[17] * P[17][j];
+    }
+    for (unsigned i = 0; i<=stateIndexLim; i++) {
+        for (unsigned j = 0; j<=stateIndexLim; j++) {
+            KHP[i][j] = Kfusion[i] * HP[j];
         }
     }
 
@@ -276,6 +276,8 @@ void NavEKF3_core::EstimateTerrainOffset(const of_elements &ofDataDelayed)
 */
 void NavEKF3_core::FuseOptFlow(const of_elements &ofDataDelayed, bool really_fuse)
 {
+    EK3_PROFILE(FuseOptFlow);
+
     Vector24 H_LOS;
     Vector2 losPred;
 
@@ -683,27 +685,21 @@ void NavEKF3_core::FuseOptFlow(const of_elements &ofDataDelayed, bool really_fus
                 GCS_SEND_TEXT(MAV_SEVERITY_INFO, "EKF3 IMU%u fusing optical flow",(unsigned)imu_index);
             }
             // correct the covariance P = (I - K*H)*P
-            // take advantage of the empty columns in KH to reduce the
-            // number of operations
-            for (uint8_t i = 0; i<=stateIndexLim; i++) {
-                for (uint8_t j = 0; j<=6; j++) {
-                    KH[i][j] = Kfusion[i] * H_LOS[j];
-                }
-                for (uint8_t j = 7; j<=stateIndexLim; j++) {
-                    KH[i][j] = 0.0f;
-                }
-            }
+            // K*H is an outer product, so form H*P once from the non-zero
+            // elements of H and scale it by each gain
+            ftype HP[24];
             for (uint8_t j = 0; j<=stateIndexLim; j++) {
-                for (uint8_t i = 0; i<=stateIndexLim; i++) {
-                    ftype res = 0;
-                    res += KH[i][0] * P[0][j];
-                    res += KH[i][1] * P[1][j];
-                    res += KH[i][2] * P[2][j];
-                    res += KH[i][3] * P[3][j];
-                    res += KH[i][4] * P[4][j];
-                    res += KH[i][5] * P[5][j];
-                    res += KH[i][6] * P[6][j];
-                    KHP[i][j] = res;
+                HP[j] = H_LOS[0] * P[0][j]
+                      + H_LOS[1] * P[1][j]
+                      + H_LOS[2] * P[2][j]
+                      + H_LOS[3] * P[3][j]
+                      + H_LOS[4] * P[4][j]
+                      + H_LOS[5] * P[5][j]
+                      + H_LOS[6] * P[6][j];
+            }
+            for (uint8_t i = 0; i<=stateIndexLim; i++) {
+                for (uint8_t j = 0; j<=stateIndexLim; j++) {
+                    KHP[i][j] = Kfusion[i] * HP[j];
                 }
             }
 
@@ -598,6 +598,8 @@ void NavEKF3_core::SelectVelPosFusion()
 // fuse selected position, velocity and height measurements
 void NavEKF3_core::FuseVelPosNED()
 {
+    EK3_PROFILE(FuseVelPosNED);
+
     // health is set bad until test passed
     bool velCheckPassed = false; // boolean true if velocity measurements have passed innovation consistency checks
     bool posCheckPassed = false; // boolean true if position measurements have passed innovation consistency check
@@ -1254,6 +1256,8 @@ void NavEKF3_core::selectHeightForFusion()
 */
 void NavEKF3_core::FuseBodyVel()
 {
+    EK3_PROFILE(FuseBodyVel);
+
     Vector24 H_VEL;
     Vector3F bodyVelPred;
 
@@ -1833,27 +1837,21 @@ void NavEKF3_core::FuseBodyVel()
                 GCS_SEND_TEXT(MAV_SEVERITY_INFO, "EKF3 IMU%u fusing odometry",(unsigned)imu_index);
             }
             // correct the covariance P = (I - K*H)*P
-            // take advantage of the empty columns in KH to reduce the
-            // number of operations
-            for (unsigned i = 0; i<=stateIndexLim; i++) {
-                for (unsigned j = 0; j<=6; j++) {
-                    KH[i][j] = Kfusion[i] * H_VEL[j];
-                }
-                for (unsigned j = 7; j<=stateIndexLim; j++) {
-                    KH[i][j] = 0.0f;
-                }
-            }
+            // K*H is an outer product, so form H*P once from the non-zero
+            // elements of H and scale it by each gain
+            ftype HP[24];
             for (unsigned j = 0; j<=stateIndexLim; j++) {
-                for (unsigned i = 0; i<=stateIndexLim; i++) {
-                    ftype res = 0;
-                    res += KH[i][0] * P[0][j];
-                    res += KH[i][1] * P[1][j];
-                    res += KH[i][2] * P[2][j];
-                    res += KH[i][3] * P[3][j];
-                    res += KH[i][4] * P[4][j];
-                    res += KH[i][5] * P[5][j];
-                    res += KH[i][6] * P[6][j];
-                    KHP[i][j] = res;
+                HP[j] = H_VEL[0] * P[0][j]
+                      + H_VEL[1] * P[1][j]
+                      + H_VEL[2] * P[2][j]
+                      + H_VEL[3] * P[3][j]
+                      + H_VEL[4] * P[4][j]
+                      + H_VEL[5] * P[5][j]
+                      + H_VEL[6] * P[6][j];
+            }
+            for (unsigned i = 0; i<=stateIndexLim; i++) {
+                for (unsigned j = 0; j<=stateIndexLim; j++) {
+                    KHP[i][j] = Kfusion[i] * HP[j];
                 }
             }
 
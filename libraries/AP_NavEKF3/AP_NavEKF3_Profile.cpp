@@ -0,0 +1,35 @@
+#include "AP_NavEKF3_Profile.h"
+
+#if EK3_FEATURE_PROFILE
+
+void NavEKF3_Profile::add(Section s, uint32_t dt_us)
+{
+    Stats &st = stats[uint8_t(s)];
+    st.count++;
+    st.total_us += dt_us;
+    if (dt_us > st.max_us) {
+        st.max_us = dt_us;
+    }
+}
+
+const char *NavEKF3_Profile::name(Section s)
+{
+    static const char *names[num_sections] = {
+        "UpdateFilter",
+        "CovariancePrediction",
+        "FuseVelPosNED",
+        "FuseBodyVel",
+        "FuseRngBcn",
+        "FuseMagnetometer",
+        "FuseDeclination",
+        "FuseEulerYaw",
+        "FuseAirspeed",
+        "FuseSideslip",
+        "FuseDragForces",
+        "FuseOptFlow",
+    };
+    const uint8_t i = uint8_t(s);
+    return i < num_sections ? names[i] : "?";
+}
+
+#endif // EK3_FEATURE_PROFILE
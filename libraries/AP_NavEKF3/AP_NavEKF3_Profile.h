@@ -0,0 +1,85 @@
+/*
+  run time profiling of EKF3 functions
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "AP_NavEKF3_feature.h"
+
+#if EK3_FEATURE_PROFILE
+
+#include <AP_HAL/AP_HAL.h>
+
+/*
+  accumulates the wall clock time spent in the expensive EKF3
+  functions. Timing does not feed back into the filter, so profiling
+  does not change the output of a replay
+ */
+class NavEKF3_Profile {
+public:
+    enum class Section : uint8_t {
+        UpdateFilter = 0,
+        CovariancePrediction,
+        FuseVelPosNED,
+        FuseBodyVel,
+        FuseRngBcn,
+        FuseMagnetometer,
+        FuseDeclination,
+        FuseEulerYaw,
+        FuseAirspeed,
+        FuseSideslip,
+        FuseDragForces,
+        FuseOptFlow,
+        NUM_SECTIONS
+    };
+    static constexpr uint8_t num_sections = uint8_t(Section::NUM_SECTIONS);
+
+    struct Stats {
+        uint32_t count;
+        uint64_t total_us;
+        uint32_t max_us;
+    };
+
+    void add(Section s, uint32_t dt_us);
+    const Stats &get(Section s) const { return stats[uint8_t(s)]; }
+    static const char *name(Section s);
+
+    // times the enclosing scope
+    class Timer {
+    public:
+        Timer(NavEKF3_Profile &_profile, Section _section) :
+            profile(_profile),
+            section(_section),
+            start_us(AP_HAL::micros()) {}
+        ~Timer() {
+            profile.add(section, AP_HAL::micros() - start_us);
+        }
+    private:
+        NavEKF3_Profile &profile;
+        const Section section;
+        const uint32_t start_us;
+    };
+
+private:
+    Stats stats[num_sections];
+};
+
+#define EK3_PROFILE(section) NavEKF3_Profile::Timer profile_timer_ ## section(profile, NavEKF3_Profile::Section::section)
+
+#else
+
+#define EK3_PROFILE(section)
+
+#endif // EK3_FEATURE_PROFILE
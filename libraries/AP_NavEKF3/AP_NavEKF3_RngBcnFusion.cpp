@@ -41,6 +41,8 @@ void NavEKF3_core::SelectRngBcnFusion()
 
 void NavEKF3_core::FuseRngBcn()
 {
+    EK3_PROFILE(FuseRngBcn);
+
     // declarations
     ftype pn;
     ftype pe;
@@ -208,26 +210,17 @@ void NavEKF3_core::FuseRngBcn()
             lastRngBcnPassTime_ms = imuSampleTime_ms;
 
             // correct the covariance P = (I - K*H)*P
-            // take advantage of the empty columns in KH to reduce the
-            // number of operations
-            for (unsigned i = 0; i<=stateIndexLim; i++) {
-                for (unsigned j = 0; j<=6; j++) {
-                    KH[i][j] = 0.0f;
-                }
-                for (unsigned j = 7; j<=9; j++) {
-                    KH[i][j] = Kfusion[i] * H_BCN[j];
-                }
-                for (unsigned j = 10; j<=23; j++) {
-                    KH[i][j] = 0.0f;
-                }
-            }
+            // K*H is an outer product, so form H*P once from the non-zero
+            // elements of H and scale it by each gain
+            ftype HP[24];
             for (unsigned j = 0; j<=stateIndexLim; j++) {
-                for (unsigned i = 0; i<=stateIndexLim; i++) {
-                    ftype res = 0;
-                    res += KH[i][7] * P[7][j];
-                    res += KH[i][8] * P[8][j];
-                    res += KH[i][9] * P[9][j];
-                    KHP[i][j] = res;
+                HP[j] = H_BCN[7] * P[7][j]
+                      + H_BCN[8] * P[8][j]
+                      + H_BCN[9] * P[9][j];
+            }
+            for (unsigned i = 0; i<=stateIndexLim; i++) {
+                for (unsigned j = 0; j<=stateIndexLim; j++) {
+                    KHP[i][j] = Kfusion[i] * HP[j];
                 }
             }
             // Check that we are not going to drive any variances negative and skip the update if so
@@ -282,6 +275,8 @@ https://github.com/priseborough/InertialNav/blob/master/derivations/range_beacon
 */
 void NavEKF3_core::FuseRngBcnStatic()
 {
+    EK3_PROFILE(FuseRngBcn);
+
     // get the estimated range measurement variance
     const ftype R_RNG = sq(MAX(rngBcnDataDelayed.rngErr , 0.1f));
 
@@ -454,18 +449,15 @@ void NavEKF3_core::FuseRngBcnStatic()
             receiverPos.z -= K_RNG[2] * innovRngBcn;
 
             // calculate the covariance correction
+            ftype HP[3];
+            for (unsigned j = 0; j<=2; j++) {
+                HP[j] = H_RNG[0] * receiverPosCov[0][j]
+                      + H_RNG[1] * receiverPosCov[1][j]
+                      + H_RNG[2] * receiverPosCov[2][j];
+            }
             for (unsigned i = 0; i<=2; i++) {
                 for (unsigned j = 0; j<=2; j++) {
-                    KH[i][j] = K_RNG[i] * H_RNG[j];
-                }
-            }
-            for (unsigned j = 0; j<=2; j++) {
-                for (unsigned i = 0; i<=2; i++) {
-                    ftype res = 0;
-                    res += KH[i][0] * receiverPosCov[0][j];
-                    res += KH[i][1] * receiverPosCov[1][j];
-                    res += KH[i][2] * receiverPosCov[2][j];
-                    KHP[i][j] = res;
+                    KHP[i][j] = K_RNG[i] * HP[j];
                 }
             }
 
@@ -25,6 +25,7 @@
 #endif
 
 #include "AP_NavEKF3_feature.h"
+#include "AP_NavEKF3_Profile.h"
 #include <AP_Common/Location.h>
 #include <AP_Math/AP_Math.h>
 #include <AP_Math/vectorN.h>
@@ -433,6 +434,11 @@ public:
     // get a yaw estimator instance
     const EKFGSF_yaw *get_yawEstimator(void) const { return yawEstimator; }
 
+#if EK3_FEATURE_PROFILE
+    // time spent in each of the expensive functions of this core
+    const NavEKF3_Profile &get_profile(void) const { return profile; }
+#endif
+
 private:
     EKFGSF_yaw *yawEstimator;
     AP_DAL &dal;
@@ -1560,4 +1566,8 @@ private:
     void Log_Write_State_Variances(uint64_t time_us);
     void Log_Write_Timing(uint64_t time_us);
     void Log_Write_GSF(uint64_t time_us);
+
+#if EK3_FEATURE_PROFILE
+    NavEKF3_Profile profile;
+#endif
 };
@@ -25,3 +25,13 @@
 #define EK3_FEATURE_DRAG_FUSION EK3_FEATURE_ALL || BOARD_FLASH_SIZE > 1024
 #endif
 
+
+// running cores on worker threads on multi-core Linux boards
+#ifndef EK3_FEATURE_PARALLEL_CORES
+#define EK3_FEATURE_PARALLEL_CORES (CONFIG_HAL_BOARD == HAL_BOARD_LINUX)
+#endif
+
+// per-function run time profiling, reported by Replay --benchmark
+#ifndef EK3_FEATURE_PROFILE
+#define EK3_FEATURE_PROFILE APM_BUILD_TYPE(APM_BUILD_Replay)
+#endif
@@ -1,19 +1,43 @@
 # -*- coding: utf-8 -*-
 # Taken from https://github.com/PX4/ecl/commit/264c8c4e8681704e4719d0a03b848df8617c0863
 # and modified for ArduPilot
-from sympy import ccode
-from sympy.codegen.ast import float32, real
+from sympy import Float
+from sympy.printing.c import C99CodePrinter
+from sympy.codegen.ast import float32, float64, real
+
+# C printer which writes squares using the AP_Math sq() function
+class CodePrinter(C99CodePrinter):
+    def _print_Pow(self, expr):
+        if expr.exp == 2:
+            return "sq(%s)" % self._print(expr.base)
+        if expr.exp == -2:
+            return "%s/sq(%s)" % (self._print(Float(1)), self._print(expr.base))
+        return super()._print_Pow(expr)
 
 class CodeGenerator:
-    def __init__(self, file_name):
+    # precision of ftype the code is generated for, either 'float' or
+    # 'double'. This sets the type of the literals in the generated
+    # code so a double build does not lose precision to float constants
+    # and a float build does not promote expressions to double
+    default_ftype = 'float'
+
+    def __init__(self, file_name, ftype=None):
         self.file_name = file_name
+        self.ftype = ftype if ftype is not None else CodeGenerator.default_ftype
+        if self.ftype == 'double':
+            self.type_aliases = {real:float64}
+        elif self.ftype == 'float':
+            self.type_aliases = {real:float32}
+        else:
+            raise ValueError("unsupported ftype %s" % self.ftype)
+        self.printer = CodePrinter({'type_aliases': self.type_aliases})
         self.file = open(self.file_name, 'w')
 
     def print_string(self, string):
         self.file.write("// " + string + "\n")
 
     def get_ccode(self, expression):
-        return ccode(expression, type_aliases={real:float32})
+        return self.printer.doprint(expression)
 
     def write_subexpressions(self,subexpressions):
         write_string = ""
@@ -41,5 +65,27 @@ class CodeGenerator:
         write_string = write_string + "\n\n"
         self.file.write(write_string)
 
+    # write the covariance correction KHP = K*H*P for a scalar
+    # observation. K*H is an outer product, so H*P is formed once using
+    # only the non-zero elements of H and each row of KHP is that row
+    # scaled by one Kalman gain, rather than expanding KH in full
+    def write_covariance_update(self, H, h_name="Hfusion", k_name="Kfusion", khp_name="KHP"):
+        nonzero = [i for i in range(0, len(H)) if H[i] != 0]
+        write_string = "ftype HP[24];\n"
+        write_string = write_string + "for (unsigned j = 0; j<=stateIndexLim; j++) {\n"
+        terms = ["%s[%u] * P[%u][j]" % (h_name, i, i) for i in nonzero]
+        if len(terms) == 0:
+            terms = ["0"]
+        write_string = write_string + "    HP[j] = " + "\n          + ".join(terms) + ";\n"
+        write_string = write_string + "}\n"
+        write_string = write_string + "for (unsigned i = 0; i<=stateIndexLim; i++) {\n"
+        write_string = write_string + "    for (unsigned j = 0; j<=stateIndexLim; j++) {\n"
+        write_string = write_string + "        %s[i][j] = %s[i] * HP[j];\n" % (khp_name, k_name)
+        write_string = write_string + "    }\n"
+        write_string = write_string + "}\n"
+
+        write_string = write_string + "\n\n"
+        self.file.write(write_string)
+
     def close(self):
         self.file.close()
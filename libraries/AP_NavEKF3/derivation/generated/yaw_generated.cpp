@@ -1,20 +1,19 @@
 // calculate 321 yaw observation matrix - option A
-const ftype SA0 = 2*q3;
-const ftype SA1 = 2*q2;
-const ftype SA2 = SA0*q0 + SA1*q1;
-const ftype SA3 = sq(q0) + sq(q1) - sq(q2) - sq(q3);
-const ftype SA4 = 1.0/sq(SA3);
+const ftype SA0 = 2*q0;
+const ftype SA1 = 2*q1;
+const ftype SA2 = SA0*q3 + SA1*q2;
+const ftype SA3 = -2*sq(q2) - 2*sq(q3) + 1;
+const ftype SA4 = 1.0F/sq(SA3);
 const ftype SA5 = 1.0F/(sq(SA2)*SA4 + 1);
 const ftype SA6 = 1.0F/SA3;
-const ftype SA7 = SA2*SA4;
-const ftype SA8 = 2*SA7;
-const ftype SA9 = 2*SA6;
+const ftype SA7 = 2*SA5*SA6;
+const ftype SA8 = 4*SA2*SA4;
 
 
-H_YAW[0] = SA5*(SA0*SA6 - SA8*q0);
-H_YAW[1] = SA5*(SA1*SA6 - SA8*q1);
-H_YAW[2] = SA5*(SA1*SA7 + SA9*q1);
-H_YAW[3] = SA5*(SA0*SA7 + SA9*q0);
+H_YAW[0] = SA7*q3;
+H_YAW[1] = SA7*q2;
+H_YAW[2] = SA5*(SA1*SA6 + SA8*q2);
+H_YAW[3] = SA5*(SA0*SA6 + SA8*q3);
 H_YAW[4] = 0;
 H_YAW[5] = 0;
 H_YAW[6] = 0;
@@ -41,19 +40,18 @@ H_YAW[23] = 0;
 const ftype SB0 = 2*q0;
 const ftype SB1 = 2*q1;
 const ftype SB2 = SB0*q3 + SB1*q2;
-const ftype SB3 = 1.0/sq(SB2);
-const ftype SB4 = sq(q0) + sq(q1) - sq(q2) - sq(q3);
+const ftype SB3 = 1.0F/sq(SB2);
+const ftype SB4 = -2*sq(q2) - 2*sq(q3) + 1;
 const ftype SB5 = 1.0F/(SB3*sq(SB4) + 1);
-const ftype SB6 = 1.0F/SB2;
-const ftype SB7 = SB3*SB4;
-const ftype SB8 = 2*SB7;
-const ftype SB9 = 2*SB6;
+const ftype SB6 = SB3*SB4;
+const ftype SB7 = 2*SB5*SB6;
+const ftype SB8 = 4/SB2;
 
 
-H_YAW[0] = -SB5*(SB0*SB6 - SB8*q3);
-H_YAW[1] = -SB5*(SB1*SB6 - SB8*q2);
-H_YAW[2] = -SB5*(-SB1*SB7 - SB9*q2);
-H_YAW[3] = -SB5*(-SB0*SB7 - SB9*q3);
+H_YAW[0] = SB7*q3;
+H_YAW[1] = SB7*q2;
+H_YAW[2] = -SB5*(-SB1*SB6 - SB8*q2);
+H_YAW[3] = -SB5*(-SB0*SB6 - SB8*q3);
 H_YAW[4] = 0;
 H_YAW[5] = 0;
 H_YAW[6] = 0;
@@ -77,22 +75,21 @@ H_YAW[23] = 0;
 
 
 // calculate 312 yaw observation matrix - option A
-const ftype SA0 = 2*q3;
+const ftype SA0 = 2*q0;
 const ftype SA1 = 2*q2;
-const ftype SA2 = SA0*q0 - SA1*q1;
-const ftype SA3 = sq(q0) - sq(q1) + sq(q2) - sq(q3);
-const ftype SA4 = 1.0/sq(SA3);
+const ftype SA2 = SA0*q3 - SA1*q1;
+const ftype SA3 = -2*sq(q1) - 2*sq(q3) + 1;
+const ftype SA4 = 1.0F/sq(SA3);
 const ftype SA5 = 1.0F/(sq(SA2)*SA4 + 1);
 const ftype SA6 = 1.0F/SA3;
-const ftype SA7 = SA2*SA4;
-const ftype SA8 = 2*SA7;
-const ftype SA9 = 2*SA6;
+const ftype SA7 = 2*SA5*SA6;
+const ftype SA8 = 4*SA2*SA4;
 
 
-H_YAW[0] = SA5*(SA0*SA6 - SA8*q0);
+H_YAW[0] = SA7*q3;
 H_YAW[1] = SA5*(-SA1*SA6 + SA8*q1);
-H_YAW[2] = SA5*(-SA1*SA7 - SA9*q1);
-H_YAW[3] = SA5*(SA0*SA7 + SA9*q0);
+H_YAW[2] = -SA7*q1;
+H_YAW[3] = SA5*(SA0*SA6 + SA8*q3);
 H_YAW[4] = 0;
 H_YAW[5] = 0;
 H_YAW[6] = 0;
@@ -117,21 +114,19 @@ H_YAW[23] = 0;
 
 // calculate 312 yaw observation matrix - option B
 const ftype SB0 = 2*q0;
-const ftype SB1 = 2*q1;
-const ftype SB2 = -SB0*q3 + SB1*q2;
-const ftype SB3 = 1.0/sq(SB2);
-const ftype SB4 = -sq(q0) + sq(q1) - sq(q2) + sq(q3);
-const ftype SB5 = 1.0F/(SB3*sq(SB4) + 1);
-const ftype SB6 = 1.0F/SB2;
-const ftype SB7 = SB3*SB4;
-const ftype SB8 = 2*SB7;
-const ftype SB9 = 2*SB6;
-
-
-H_YAW[0] = -SB5*(-SB0*SB6 + SB8*q3);
-H_YAW[1] = -SB5*(SB1*SB6 - SB8*q2);
-H_YAW[2] = -SB5*(-SB1*SB7 - SB9*q2);
-H_YAW[3] = -SB5*(SB0*SB7 + SB9*q3);
+const ftype SB1 = -SB0*q3 + 2*q1*q2;
+const ftype SB2 = 1.0F/sq(SB1);
+const ftype SB3 = 2*sq(q1) + 2*sq(q3) - 1;
+const ftype SB4 = 1.0F/(SB2*sq(SB3) + 1);
+const ftype SB5 = SB2*SB3;
+const ftype SB6 = 2*SB4*SB5;
+const ftype SB7 = 4/SB1;
+
+
+H_YAW[0] = -SB6*q3;
+H_YAW[1] = -SB4*(-2*SB5*q2 + SB7*q1);
+H_YAW[2] = SB6*q1;
+H_YAW[3] = -SB4*(SB0*SB5 + SB7*q3);
 H_YAW[4] = 0;
 H_YAW[5] = 0;
 H_YAW[6] = 0;
@@ -154,3 +149,18 @@ H_YAW[22] = 0;
 H_YAW[23] = 0;
 
 
+// covariance update, H_YAW is non-zero only for the quaternion states
+ftype HP[24];
+for (unsigned j = 0; j<=stateIndexLim; j++) {
+    HP[j] = H_YAW[0] * P[0][j]
+          + H_YAW[1] * P[1][j]
+          + H_YAW[2] * P[2][j]
+          + H_YAW[3] * P[3][j];
+}
+for (unsigned i = 0; i<=stateIndexLim; i++) {
+    for (unsigned j = 0; j<=stateIndexLim; j++) {
+        KHP[i][j] = Kfusion[i] * HP[j];
+    }
+}
+
+
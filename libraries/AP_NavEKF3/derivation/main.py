@@ -132,6 +132,8 @@ def write_equations_to_file(equations,code_generator_id,n_obs):
         code_generator_id.write_matrix(Matrix(equations[1][0][0:24]), "Hfusion", False)
         code_generator_id.print_string("Kalman gains")
         code_generator_id.write_matrix(Matrix(equations[1][0][24:]), "Kfusion", False)
+        code_generator_id.print_string("Covariance update")
+        code_generator_id.write_covariance_update(Matrix(equations[1][0][0:24]))
     else:
         code_generator_id.print_string("Sub Expressions")
         code_generator_id.write_subexpressions(equations[0])
@@ -141,6 +143,8 @@ def write_equations_to_file(equations,code_generator_id,n_obs):
             code_generator_id.write_matrix(Matrix(equations[1][0][start_index:start_index+24]), "Hfusion", False)
             code_generator_id.print_string("Kalman gains - axis %i" % axis_index)
             code_generator_id.write_matrix(Matrix(equations[1][0][start_index+24:start_index+48]), "Kfusion", False)
+            code_generator_id.print_string("Covariance update - axis %i" % axis_index)
+            code_generator_id.write_covariance_update(Matrix(equations[1][0][start_index:start_index+24]))
 
     return
 
@@ -335,6 +339,9 @@ def yaw_observation(P,state,R_to_earth):
     yaw_code_generator.write_subexpressions(H_YAW312_B_simple[0])
     yaw_code_generator.write_matrix(Matrix(H_YAW312_B_simple[1]).T, "H_YAW", False)
 
+    yaw_code_generator.print_string("covariance update, H_YAW is non-zero only for the quaternion states")
+    yaw_code_generator.write_covariance_update(Matrix(H_YAW312_B_simple[1]).T, "H_YAW")
+
     yaw_code_generator.close()
 
     return
@@ -699,4 +706,9 @@ def generate_code():
 
 
 if __name__ == "__main__":
+    from argparse import ArgumentParser
+    parser = ArgumentParser(description=__doc__)
+    parser.add_argument("--ftype", choices=['float', 'double'], default='float', help="precision of ftype to generate code for")
+    args = parser.parse_args()
+    CodeGenerator.default_ftype = args.ftype
     generate_code()
@@ -27,6 +27,8 @@
 #include <string.h>
 
 #include <AP_Common/AP_Common.h>
+#include <AP_Common/Bitmask.h>
+#include <AP_Common/ExpandingString.h>
 #include <AP_HAL/AP_HAL.h>
 #include <AP_Math/AP_Math.h>
 #include <GCS_MAVLink/GCS.h>
@@ -130,6 +132,17 @@ StorageAccess AP_Param::_storage_bak(StorageManager::StorageParamBak);
 // flags indicating frame type
 uint16_t AP_Param::_frame_type_flags;
 
+#if AP_PARAM_STORAGE_INDEX_ENABLED
+uint16_t *AP_Param::_key_index;
+uint16_t AP_Param::_key_index_num_vars;
+uint16_t *AP_Param::_storage_index;
+uint16_t AP_Param::_storage_index_mask;
+uint16_t AP_Param::_storage_index_count;
+bool AP_Param::_storage_index_valid;
+#endif
+
+struct AP_Param::boot_timing AP_Param::_boot_timing;
+
 // write to EEPROM
 void AP_Param::eeprom_write_check(const void *ptr, uint16_t ofs, uint8_t size)
 {
@@ -165,6 +178,11 @@ void AP_Param::erase_all(void)
 
     // add a sentinal directly after the header
     write_sentinal(sizeof(struct EEPROM_header));
+
+#if AP_PARAM_STORAGE_INDEX_ENABLED
+    // storage is now empty, so an allocated index is complete
+    storage_index_reset(_storage_index != nullptr);
+#endif
 }
 
 /* the 'group_id' of a element of a group is the 18 bit identifier
@@ -299,7 +317,10 @@ const struct AP_Param::GroupInfo *AP_Param::get_group_info(const struct Info &in
 // validate the _var_info[] table
 bool AP_Param::check_var_info(void)
 {
+    const uint32_t start_us = AP_HAL::micros();
     uint16_t total_size = sizeof(struct EEPROM_header);
+    // top level keys are 9 bits
+    Bitmask<512> keys_seen;
 
     for (uint16_t i=0; i<_num_vars; i++) {
         const auto &info = var_info(i);
@@ -326,7 +347,13 @@ bool AP_Param::check_var_info(void)
             }
             total_size += size + sizeof(struct Param_header);
         }
-        if (duplicate_key(i, key)) {
+        if (key < keys_seen.size()) {
+            if (keys_seen.get(key)) {
+                // no duplicate keys allowed
+                return false;
+            }
+            keys_seen.set(key);
+        } else if (duplicate_key(i, key)) {
             return false;
         }
         if (type != AP_PARAM_GROUP && (info.flags & AP_PARAM_FLAG_POINTER)) {
@@ -335,6 +362,8 @@ bool AP_Param::check_var_info(void)
         }
     }
 
+    _boot_timing.check_var_info_us = AP_HAL::micros() - start_us;
+
     // we no longer check if total_size is larger than _eeprom_size,
     // as we allow for more variables than could fit, relying on not
     // saving default values
@@ -361,6 +390,9 @@ bool AP_Param::setup(void)
             _storage.copy_area(_storage_bak)) {
             // restored from backup
             INTERNAL_ERROR(AP_InternalError::error_t::params_restored);
+#if AP_PARAM_STORAGE_INDEX_ENABLED
+            storage_index_reset(false);
+#endif
             return true;
         }
         // header doesn't match. We can't recover any variables. Wipe
@@ -488,8 +520,21 @@ const struct AP_Param::Info *AP_Param::find_by_header_group(struct Param_header
 // return the Info structure and a pointer to the variables storage
 const struct AP_Param::Info *AP_Param::find_by_header(struct Param_header phdr, void **ptr)
 {
+    uint16_t first = 0;
+    uint16_t last = _num_vars;
+#if AP_PARAM_STORAGE_INDEX_ENABLED
+    if (key_index_update()) {
+        // only the variable with this key can match
+        first = _key_index[get_key(phdr)];
+        if (first >= _num_vars) {
+            return nullptr;
+        }
+        last = first + 1;
+    }
+#endif
+
     // loop over all named variables
-    for (uint16_t i=0; i<_num_vars; i++) {
+    for (uint16_t i=first; i<last; i++) {
         const auto &info = var_info(i);
         uint8_t type = info.type;
         uint16_t key = info.key;
@@ -741,6 +786,16 @@ bool AP_Param::is_sentinal(const Param_header &phdr)
 // if the sentinal isn't found either, the offset is set to 0xFFFF
 bool AP_Param::scan(const AP_Param::Param_header *target, uint16_t *pofs)
 {
+#if AP_PARAM_STORAGE_INDEX_ENABLED
+    if (_storage_index_valid) {
+        if (storage_index_find(*target, *pofs)) {
+            return true;
+        }
+        *pofs = sentinal_offset;
+        return false;
+    }
+#endif
+
     struct Param_header phdr;
     uint16_t ofs = sizeof(AP_Param::EEPROM_header);
     while (ofs < _storage.size()) {
@@ -1221,6 +1276,9 @@ void AP_Param::save_sync(bool force_save, bool send_to_gcs)
     write_sentinal(ofs + sizeof(phdr) + type_size((enum ap_var_type)phdr.type));
     eeprom_write_check(ap, ofs+sizeof(phdr), type_size((enum ap_var_type)phdr.type));
     eeprom_write_check(&phdr, ofs, sizeof(phdr));
+#if AP_PARAM_STORAGE_INDEX_ENABLED
+    storage_index_add(phdr, ofs);
+#endif
 
     if (send_to_gcs) {
         send_parameter(name, (enum ap_var_type)phdr.type, idx);
@@ -1519,19 +1577,30 @@ bool AP_Param::load_all()
     struct Param_header phdr;
     uint16_t ofs = sizeof(AP_Param::EEPROM_header);
 
+    const uint32_t start_us = AP_HAL::micros();
     reload_defaults_file(false);
+    _boot_timing.defaults_us = AP_HAL::micros() - start_us;
 
     if (!registered_save_handler) {
         registered_save_handler = true;
         hal.scheduler->register_io_process(FUNCTOR_BIND((&save_dummy), &AP_Param::save_io_handler, void));
     }
-    
+
+#if AP_PARAM_STORAGE_INDEX_ENABLED
+    // rebuilt as we go; only valid if we reach the sentinal
+    storage_index_reset(false);
+#endif
+    _boot_timing.num_stored = 0;
+    _boot_timing.num_loaded = 0;
+
+    bool ret = false;
     while (ofs < _storage.size()) {
         _storage.read_block(&phdr, ofs, sizeof(phdr));
         if (is_sentinal(phdr)) {
             // we've reached the sentinal
             sentinal_offset = ofs;
-            return true;
+            ret = true;
+            break;
         }
 
         const struct AP_Param::Info *info;
@@ -1540,15 +1609,147 @@ bool AP_Param::load_all()
         info = find_by_header(phdr, &ptr);
         if (info != nullptr) {
             _storage.read_block(ptr, ofs+sizeof(phdr), type_size((enum ap_var_type)phdr.type));
+            _boot_timing.num_loaded++;
         }
+#if AP_PARAM_STORAGE_INDEX_ENABLED
+        storage_index_add(phdr, ofs);
+#endif
+        _boot_timing.num_stored++;
 
         ofs += type_size((enum ap_var_type)phdr.type) + sizeof(phdr);
     }
 
-    // we didn't find the sentinal
-    Debug("no sentinal in load_all");
+#if AP_PARAM_STORAGE_INDEX_ENABLED
+    _storage_index_valid = ret && _storage_index != nullptr && _storage_index_count != 0xFFFF;
+    _boot_timing.indexed = _storage_index_valid;
+#endif
+    _boot_timing.load_all_us = AP_HAL::micros() - start_us;
+
+    if (!ret) {
+        // we didn't find the sentinal
+        Debug("no sentinal in load_all");
+    }
+    return ret;
+}
+
+#if AP_PARAM_STORAGE_INDEX_ENABLED
+/*
+  (re)build the key to _var_info index if the table has changed size.
+  Returns false if it can't be allocated
+ */
+bool AP_Param::key_index_update(void)
+{
+    const uint16_t num_keys = _sentinal_key + 1;
+    if (_key_index == nullptr) {
+        _key_index = new uint16_t[num_keys];
+        if (_key_index == nullptr) {
+            return false;
+        }
+        _key_index_num_vars = 0;
+    }
+    if (_key_index_num_vars == _num_vars) {
+        return true;
+    }
+    for (uint16_t k=0; k<num_keys; k++) {
+        _key_index[k] = 0xFFFF;
+    }
+    for (uint16_t i=0; i<_num_vars; i++) {
+        const uint16_t key = var_info(i).key;
+        if (key < num_keys && _key_index[key] == 0xFFFF) {
+            _key_index[key] = i;
+        }
+    }
+    _key_index_num_vars = _num_vars;
+    return true;
+}
+
+// hash slot for a header
+static uint16_t header_hash(const void *phdr, uint16_t mask)
+{
+    uint32_t v;
+    memcpy(&v, phdr, sizeof(v));
+    return ((v * 2654435761U) >> 16) & mask;
+}
+
+/*
+  empty the storage index, allocating it on first use. The table has
+  a slot for every four bytes of storage; a typical variable takes
+  eight, so a full storage area leaves the table about half full
+ */
+void AP_Param::storage_index_reset(bool valid)
+{
+    _storage_index_valid = false;
+    if (_storage_index == nullptr) {
+        uint16_t slots = 256;
+        while (slots < _storage.size() / 4 && slots < 0x8000) {
+            slots *= 2;
+        }
+        _storage_index = new uint16_t[slots];
+        if (_storage_index == nullptr) {
+            return;
+        }
+        _storage_index_mask = slots - 1;
+    }
+    memset(_storage_index, 0, (_storage_index_mask+1) * sizeof(uint16_t));
+    _storage_index_count = 0;
+    _storage_index_valid = valid;
+}
+
+/*
+  add a stored variable to the index. If the table gets more than 3/4
+  full it is abandoned and scan() goes back to walking storage
+ */
+void AP_Param::storage_index_add(const Param_header &phdr, uint16_t ofs)
+{
+    if (_storage_index == nullptr || _storage_index_count == 0xFFFF) {
+        return;
+    }
+    if (_storage_index_count >= (_storage_index_mask+1) / 4 * 3) {
+        _storage_index_count = 0xFFFF;
+        _storage_index_valid = false;
+        return;
+    }
+    uint16_t existing;
+    if (storage_index_find(phdr, existing)) {
+        // scan() returns the first copy in storage
+        return;
+    }
+    uint16_t i = header_hash(&phdr, _storage_index_mask);
+    while (_storage_index[i] != 0) {
+        i = (i + 1) & _storage_index_mask;
+    }
+    _storage_index[i] = ofs;
+    _storage_index_count++;
+}
+
+bool AP_Param::storage_index_find(const Param_header &phdr, uint16_t &ofs)
+{
+    uint16_t i = header_hash(&phdr, _storage_index_mask);
+    while (_storage_index[i] != 0) {
+        Param_header stored;
+        _storage.read_block(&stored, _storage_index[i], sizeof(stored));
+        if (memcmp(&stored, &phdr, sizeof(stored)) == 0) {
+            ofs = _storage_index[i];
+            return true;
+        }
+        i = (i + 1) & _storage_index_mask;
+    }
     return false;
 }
+#endif // AP_PARAM_STORAGE_INDEX_ENABLED
+
+/*
+  report time spent in parameter setup at boot
+ */
+void AP_Param::boot_timing_info(ExpandingString &str)
+{
+    str.printf("check_var_info: %uus\n", unsigned(_boot_timing.check_var_info_us));
+    str.printf("defaults: %uus\n", unsigned(_boot_timing.defaults_us));
+    str.printf("load_all: %uus\n", unsigned(_boot_timing.load_all_us));
+    str.printf("stored: %u\n", unsigned(_boot_timing.num_stored));
+    str.printf("loaded: %u\n", unsigned(_boot_timing.num_loaded));
+    str.printf("indexed: %u\n", unsigned(_boot_timing.indexed));
+}
 
 /*
  * reload from hal.util defaults file or embedded param region
@@ -2523,6 +2724,49 @@ void AP_Param::invalidate_count(void)
     _count_marker++;
 }
 
+/*
+  hash the parameter set. Values are hashed as stored so that any
+  change, including one below float precision, changes the hash
+ */
+uint32_t AP_Param::hash_parameters(uint32_t *block_hashes, uint16_t num_blocks, uint16_t block_size)
+{
+    uint32_t hash = 0;
+    uint32_t block_hash = 0;
+    uint16_t idx = 0;
+    AP_Param::ParamToken token {};
+    enum ap_var_type ptype;
+
+    for (AP_Param *vp = AP_Param::first(&token, &ptype);
+         vp != nullptr;
+         vp = AP_Param::next_scalar(&token, &ptype)) {
+        char name[AP_MAX_NAME_SIZE+1];
+        vp->copy_name_token(token, name, sizeof(name), true);
+        name[AP_MAX_NAME_SIZE] = 0;
+        const uint8_t type = ptype;
+        uint32_t h = crc32_small(0, (const uint8_t *)name, strlen(name));
+        h = crc32_small(h, &type, 1);
+        h = crc32_small(h, (const uint8_t *)vp, type_size(ptype));
+
+        hash = crc32_small(hash, (const uint8_t *)&h, sizeof(h));
+        if (block_hashes != nullptr && block_size > 0) {
+            block_hash = crc32_small(block_hash, (const uint8_t *)&h, sizeof(h));
+            const uint16_t block = idx / block_size;
+            if ((idx+1) % block_size == 0 && block < num_blocks) {
+                block_hashes[block] = block_hash;
+                block_hash = 0;
+            }
+        }
+        idx++;
+    }
+    if (block_hashes != nullptr && block_size > 0 && idx % block_size != 0) {
+        const uint16_t block = idx / block_size;
+        if (block < num_blocks) {
+            block_hashes[block] = block_hash;
+        }
+    }
+    return hash;
+}
+
 /*
   set a default value by name
  */
@@ -2946,6 +3190,10 @@ bool AP_Param::add_table(uint8_t _key, const char *prefix, uint8_t num_params)
     info.type = AP_PARAM_GROUP;
 
     invalidate_count();
+#if AP_PARAM_STORAGE_INDEX_ENABLED
+    // rebuild the key index on next use
+    _key_index_num_vars = 0;
+#endif
 
     // save the CRC
     AP_Int32 *crc_param = const_cast<AP_Int32 *>((AP_Int32 *)info.ptr);
@@ -30,6 +30,8 @@
 
 #include "float.h"
 
+class ExpandingString;
+
 #define AP_MAX_NAME_SIZE 16
 
 // optionally enable debug code for dumping keys
@@ -61,6 +63,15 @@
 #endif
 #define AP_PARAM_DYNAMIC_KEY_BASE 300
 
+/*
+  keep a RAM index of top level keys and of the variables in storage,
+  so load_all() is a single pass over storage and scan() doesn't walk
+  storage for every load and save
+ */
+#ifndef AP_PARAM_STORAGE_INDEX_ENABLED
+#define AP_PARAM_STORAGE_INDEX_ENABLED (HAL_MEM_CLASS >= HAL_MEM_CLASS_500)
+#endif
+
 /*
   flags for variables in var_info and group tables
  */
@@ -495,6 +506,9 @@ public:
     // check var table for consistency
     static bool             check_var_info(void);
 
+    // report boot time spent in each phase of parameter setup
+    static void             boot_timing_info(ExpandingString &str);
+
     // return true if the parameter is configured
     bool configured(void) const;
 
@@ -510,6 +524,12 @@ public:
     // invalidate parameter count
     static void invalidate_count(void);
 
+    // hash of the name, type and value of every parameter, in the
+    // order they are sent to a GCS. If block_hashes is given it is
+    // filled with the hash of each run of block_size parameters, so a
+    // GCS can find which parts of its cached copy are out of date
+    static uint32_t hash_parameters(uint32_t *block_hashes = nullptr, uint16_t num_blocks = 0, uint16_t block_size = 0);
+
     static void set_hide_disabled_groups(bool value) { _hide_disabled_groups = value; }
 
     // set frame type flags. Used to unhide frame specific parameters
@@ -621,6 +641,34 @@ private:
                                                  uint8_t max_bits, uint8_t prefix_length);
     static bool                 duplicate_key(uint16_t vindex, uint16_t key);
 
+#if AP_PARAM_STORAGE_INDEX_ENABLED
+    // _var_info index of each top level key, valid while
+    // _key_index_num_vars matches _num_vars
+    static uint16_t *           _key_index;
+    static uint16_t             _key_index_num_vars;
+    static bool                 key_index_update(void);
+
+    // open addressed hash table of the storage offset of each stored
+    // variable, keyed by its header. Zero marks an empty slot
+    static uint16_t *           _storage_index;
+    static uint16_t             _storage_index_mask;
+    static uint16_t             _storage_index_count;
+    static bool                 _storage_index_valid;
+    static void                 storage_index_reset(bool valid);
+    static void                 storage_index_add(const Param_header &phdr, uint16_t ofs);
+    static bool                 storage_index_find(const Param_header &phdr, uint16_t &ofs);
+#endif
+
+    // time taken by each phase of parameter setup at boot
+    static struct boot_timing {
+        uint32_t check_var_info_us;
+        uint32_t defaults_us;
+        uint32_t load_all_us;
+        uint16_t num_stored;
+        uint16_t num_loaded;
+        bool indexed;
+    } _boot_timing;
+
     static bool adjust_group_offset(uint16_t vindex, const struct GroupInfo &group_info, ptrdiff_t &new_offset);
     static bool get_base(const struct Info &info, ptrdiff_t &base);
 
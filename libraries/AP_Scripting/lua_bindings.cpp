@@ -162,11 +162,8 @@ int AP_Logger_Write(lua_State *L) {
         return luaL_argerror(L, args, "could not map message type");
     }
 
-    // work out how long the block will be
-    int16_t msg_len = AP_logger->Write_calc_msg_len(fmt_cat);
-    if (msg_len == -1) {
-        return luaL_argerror(L, args, "unknown format");
-    }
+    // the block length was calculated when the format was resolved
+    const uint8_t msg_len = f->msg_len;
 
     luaL_Buffer buffer;
     luaL_buffinit(L, &buffer);
@@ -255,10 +252,13 @@ int AP_Logger_Write(lua_State *L) {
         }
     }
 
-    AP_logger->Safe_Write_Emit_FMT(f);
+    if (buffer.n != msg_len) {
+        // a message of this name was previously written with a different format
+        return luaL_argerror(L, args, "format does not match previous use");
+    }
 
     luaL_pushresult(&buffer);
-    AP_logger->WriteBlock(buffer.b,msg_len);
+    AP_logger->WriteBlockH(f, buffer.b, msg_len, false);
 
     return 0;
 }
@@ -30,8 +30,8 @@ const AP_Param::GroupInfo AP_SmartRTL::var_info[] = {
 
     // @Param: POINTS
     // @DisplayName: SmartRTL maximum number of points on path
-    // @Description: SmartRTL maximum number of points on path. Set to 0 to disable SmartRTL.  100 points consumes about 3k of memory.
-    // @Range: 0 500
+    // @Description: SmartRTL maximum number of points on path. Set to 0 to disable SmartRTL.  100 points consumes about 3k of memory.  Boards with less than 500k of memory are limited to 500 points.
+    // @Range: 0 5000
     // @User: Advanced
     // @RebootRequired: True
     AP_GROUPINFO("POINTS", 1, AP_SmartRTL, _points_max, SMARTRTL_POINTS_DEFAULT),
@@ -67,6 +67,12 @@ const AP_Param::GroupInfo AP_SmartRTL::var_info[] = {
 *    2. Simplification uses the Ramer-Douglas-Peucker algorithm. See Wikipedia
 *    for a more complete description.
 *
+*    To avoid comparing every new segment against every earlier segment, pruning
+*    uses a spatial hash of the path's segments (see _index).  Only segments whose
+*    midpoints lie in grid cells near the new segment are compared, so the cost per
+*    new point stays roughly constant as the path grows.  Simplification only
+*    checks points added since it last completed.
+*
 *    The simplification and pruning algorithms run in the background and do not
 *    alter the path in memory.  Two definitions, SMARTRTL_SIMPLIFY_TIME_US and
 *    SMARTRTL_PRUNING_LOOP_TIME_US are used to limit how long each algorithm will
@@ -115,13 +121,27 @@ void AP_SmartRTL::init()
     _simplify.stack_max = _points_max * SMARTRTL_SIMPLIFY_STACK_LEN_MULT;
     _simplify.stack = (simplify_start_finish_t*)calloc(_simplify.stack_max, sizeof(simplify_start_finish_t));
 
+    // segment index has roughly one bucket per SMARTRTL_INDEX_BUCKETS_DIV points
+    uint16_t num_buckets = 16;
+    while (num_buckets < 0x8000 && num_buckets * SMARTRTL_INDEX_BUCKETS_DIV < _points_max) {
+        num_buckets <<= 1;
+    }
+    _index.bucket_mask = num_buckets - 1;
+    _index.bucket_head = (uint16_t*)calloc(num_buckets, sizeof(uint16_t));
+    _index.next = (uint16_t*)calloc(_points_max, sizeof(uint16_t));
+
     // check if memory allocation failed
-    if (_path == nullptr || _prune.loops == nullptr || _simplify.stack == nullptr) {
+    if (_path == nullptr || _prune.loops == nullptr || _simplify.stack == nullptr || _index.bucket_head == nullptr || _index.next == nullptr) {
         log_action(SRTL_DEACTIVATED_INIT_FAILED);
         gcs().send_text(MAV_SEVERITY_WARNING, "SmartRTL deactivated: init failed");
         free(_path);
         free(_prune.loops);
         free(_simplify.stack);
+        free(_index.bucket_head);
+        free(_index.next);
+        _path = nullptr;
+        _index.bucket_head = nullptr;
+        _index.next = nullptr;
         return;
     }
 
@@ -365,6 +385,9 @@ void AP_SmartRTL::run_background_cleanup()
     _path_points_completed_limit = SMARTRTL_POINTS_MAX;
     _path_sem.give();
 
+    // remove popped points from the segment index
+    index_truncate(path_points_completed_limit);
+
     // check if thorough cleanup is required
     if (_thorough_clean_request_ms > 0) {
         // check if we have already completed the request
@@ -511,7 +534,9 @@ void AP_SmartRTL::detect_simplifications()
     while (_simplify.stack_count > 0) { // while there is something to do
 
         // if this method has run for long enough, exit
-        if (AP_HAL::micros() - start_time_us > SMARTRTL_SIMPLIFY_TIME_US) {
+        const uint32_t elapsed_us = AP_HAL::micros() - start_time_us;
+        if (elapsed_us > SMARTRTL_SIMPLIFY_TIME_US) {
+            _simplify.elapsed_us += elapsed_us;
             return;
         }
 
@@ -540,6 +565,8 @@ void AP_SmartRTL::detect_simplifications()
             // if the to-do list is full, give up on simplifying. This should never happen.
             if (_simplify.stack_count >= _simplify.stack_max) {
                 _simplify.complete = true;
+                _simplify.elapsed_us += AP_HAL::micros() - start_time_us;
+                log_cleanup(0, _simplify.path_points_count, _simplify.elapsed_us);
                 return;
             }
             _simplify.stack[_simplify.stack_count++] = simplify_start_finish_t {start_index, farthest_point_index};
@@ -550,16 +577,22 @@ void AP_SmartRTL::detect_simplifications()
                 _simplify.bitmask.clear(i);
                 _simplify.removal_required = true;
             }
+            if (end_index > start_index + 1) {
+                _simplify.first_removed = MIN(_simplify.first_removed, start_index + 1);
+            }
         }
     }
     _simplify.path_points_completed = _simplify.path_points_count;
     _simplify.complete = true;
+    _simplify.elapsed_us += AP_HAL::micros() - start_time_us;
+    log_cleanup(0, _simplify.path_points_count, _simplify.elapsed_us);
 }
 
 /**
 *   This method runs for the allotted time, and detects loops in a path. Any detected loops are added to _prune.loops,
 *   this function does not alter the path in memory. It works by comparing the line segment between any two sequential points
 *   to the line segment between any other two sequential points. If they get close enough, anything between them could be pruned.
+*   The segment index is used so that each new segment is only compared with nearby segments.
 *
 *   reset_pruning should have been called at least once before this function is called to setup the indexes (_prune.i, etc)
 */
@@ -574,36 +607,41 @@ void AP_SmartRTL::detect_loops()
     // capture start time
     const uint32_t start_time_us = AP_HAL::micros();
 
+    // bring index up to date with all segments that may be checked
+    if (!index_add_segments(_prune.path_points_count, start_time_us)) {
+        _prune.elapsed_us += AP_HAL::micros() - start_time_us;
+        return;
+    }
+
     // run for defined amount of time
-    while (AP_HAL::micros() - start_time_us < SMARTRTL_PRUNING_LOOP_TIME_US) {
-
-        // advance inner loop
-        _prune.j++;
-        if (_prune.j > _prune.i - 2) {
-            // set inner loop back to first point
-            _prune.j = 1;
-            // reduce outer loop
-            _prune.i--;
-            // complete when outer loop has run out of new points to check
-            if (_prune.i < 4 || _prune.i < _prune.path_points_completed) {
-                _prune.complete = true;
-                _prune.path_points_completed = _prune.path_points_count;
-                return;
-            }
-        }
+    uint32_t elapsed_us;
+    while ((elapsed_us = AP_HAL::micros() - start_time_us) < SMARTRTL_PRUNING_LOOP_TIME_US) {
 
-        // find the closest distance between two line segments and the mid-point
-        dist_point dp = segment_segment_dist(_path[_prune.i], _path[_prune.i-1], _path[_prune.j-1], _path[_prune.j]);
-        if (dp.distance < SMARTRTL_PRUNING_DELTA) {
+        // find the earliest segment that comes close to this segment and the mid-point between them
+        dist_point dp;
+        const uint16_t j = index_find_loop(_prune.i, dp);
+        if (j > 0) {
             // if there is a loop here, add to loop array
-            if (!add_loop(_prune.j, _prune.i-1, dp.midpoint)) {
+            if (!add_loop(j, _prune.i-1, dp.midpoint)) {
                 // if the buffer is full, stop trying to prune
                 _prune.complete = true;
+                _prune.elapsed_us += AP_HAL::micros() - start_time_us;
+                return;
             }
-            // set inner loop forward to trigger outer loop move to next segment
-            _prune.j = _prune.i;
+        }
+
+        // move to previous segment
+        _prune.i--;
+        // complete when we have run out of new points to check
+        if (_prune.i < 4 || _prune.i < _prune.path_points_completed) {
+            _prune.complete = true;
+            _prune.path_points_completed = _prune.path_points_count;
+            _prune.elapsed_us += AP_HAL::micros() - start_time_us;
+            log_cleanup(1, _prune.path_points_count, _prune.elapsed_us);
+            return;
         }
     }
+    _prune.elapsed_us += elapsed_us;
 }
 
 // restart simplify if new points have been added to path
@@ -632,6 +670,8 @@ void AP_SmartRTL::restart_simplification(uint16_t path_points_count)
     _simplify.removal_required = false;
     _simplify.bitmask.setall();
     _simplify.stack_count = 0;
+    _simplify.first_removed = SMARTRTL_POINTS_MAX;
+    _simplify.elapsed_us = 0;
     _simplify.path_points_count = path_points_count;
 }
 
@@ -647,7 +687,7 @@ void AP_SmartRTL::restart_pruning(uint16_t path_points_count)
 {
     _prune.complete = false;
     _prune.i = (path_points_count > 0) ? path_points_count - 1 : 0;
-    _prune.j = 0;
+    _prune.elapsed_us = 0;
     _prune.path_points_count = path_points_count;
 }
 
@@ -657,6 +697,7 @@ void AP_SmartRTL::reset_pruning()
     restart_pruning(0);
     _prune.loops_count = 0; // clear the loops that we've recorded
     _prune.path_points_completed = 0;
+    index_reset();
 }
 
 // remove all simplify-able points from the path
@@ -666,9 +707,11 @@ void AP_SmartRTL::remove_points_by_simplify_bitmask()
     if (!_path_sem.take_nonblocking()) {
         return;
     }
-    uint16_t dest = 1;
+    // points before the first one flagged for removal are unchanged so start from there
+    const uint16_t first_removed = MAX(_simplify.first_removed, 1);
+    uint16_t dest = first_removed;
     uint16_t removed = 0;
-    for (uint16_t src = 1; src < _path_points_count; src++) {
+    for (uint16_t src = first_removed; src < _path_points_count; src++) {
         if (!_simplify.bitmask.get(src)) {
             log_action(SRTL_POINT_SIMPLIFY, _path[src]);
             removed++;
@@ -690,6 +733,9 @@ void AP_SmartRTL::remove_points_by_simplify_bitmask()
 
     _path_sem.give();
 
+    // segments from the first removed point onwards have changed
+    index_truncate(first_removed);
+
     // flag point removal is complete
     _simplify.bitmask.setall();
     _simplify.removal_required = false;
@@ -719,6 +765,9 @@ bool AP_SmartRTL::remove_points_by_loops(uint16_t num_points_to_remove)
         // midpoint goes into start_index (this is the end point of the first segment)
         _path[loop.start_index] = loop.midpoint;
 
+        // segments from the loop's start onwards have changed
+        index_truncate(loop.start_index);
+
         // shift points after the end of the loop down by the number of points in the loop
         uint16_t loop_num_points_to_remove = loop.end_index - loop.start_index;
         for (uint16_t dest = loop.start_index + 1; dest < _path_points_count - loop_num_points_to_remove; dest++) {
@@ -859,6 +908,164 @@ AP_SmartRTL::dist_point AP_SmartRTL::segment_segment_dist(const Vector3f &p1, co
     return {dP.length(), midpoint};
 }
 
+// reset index so that it holds no segments
+void AP_SmartRTL::index_reset()
+{
+    if (_index.bucket_head == nullptr) {
+        return;
+    }
+    memset(_index.bucket_head, 0, (_index.bucket_mask + 1) * sizeof(uint16_t));
+    _index.long_head = 0;
+    _index.num_points = 0;
+    _index.cell_size = SMARTRTL_INDEX_CELL_SIZE;
+}
+
+// remove all segments that include points at or after num_points from the index
+// segments are always added in increasing order so removed segments are at the start of each list
+void AP_SmartRTL::index_truncate(uint16_t num_points)
+{
+    if (num_points >= _index.num_points) {
+        return;
+    }
+    if (num_points <= 1) {
+        index_reset();
+        return;
+    }
+    for (uint16_t b = 0; b <= _index.bucket_mask; b++) {
+        while (_index.bucket_head[b] >= num_points) {
+            _index.bucket_head[b] = _index.next[_index.bucket_head[b]];
+        }
+    }
+    while (_index.long_head >= num_points) {
+        _index.long_head = _index.next[_index.long_head];
+    }
+    _index.num_points = num_points;
+}
+
+// add segments to index until it holds all segments joining the first num_points points
+// returns true if complete, false if it ran out of time and should be called again
+bool AP_SmartRTL::index_add_segments(uint16_t num_points, uint32_t start_time_us)
+{
+    // cell size must not change while segments are in the index
+    if (!is_equal(_index.cell_size, SMARTRTL_INDEX_CELL_SIZE)) {
+        index_reset();
+    }
+    if (_index.num_points == 0) {
+        _index.num_points = 1;
+    }
+
+    while (_index.num_points < num_points) {
+        // check for timeout every few segments
+        if (((_index.num_points & 0x1F) == 0) && (AP_HAL::micros() - start_time_us > SMARTRTL_PRUNING_LOOP_TIME_US)) {
+            return false;
+        }
+        const uint16_t seg = _index.num_points;
+        const Vector3f &p1 = _path[seg-1];
+        const Vector3f &p2 = _path[seg];
+        uint16_t *head;
+        if ((p2.xy() - p1.xy()).length_squared() > sq(_index.cell_size)) {
+            // long segments may pass through many cells
+            head = &_index.long_head;
+        } else {
+            int32_t x, y;
+            index_cell((p1 + p2) * 0.5f, x, y);
+            head = &_index.bucket_head[index_bucket(x, y)];
+        }
+        _index.next[seg] = *head;
+        *head = seg;
+        _index.num_points++;
+    }
+    return true;
+}
+
+// return the lowest numbered segment between 1 and seg-2 that passes within SMARTRTL_PRUNING_DELTA of segment seg
+// returns zero if no such segment exists, otherwise dp is filled in with the distance and midpoint
+uint16_t AP_SmartRTL::index_find_loop(uint16_t seg, dist_point &dp) const
+{
+    if (seg < 3) {
+        return 0;
+    }
+    const Vector3f &p1 = _path[seg];
+    const Vector3f &p2 = _path[seg-1];
+    const uint16_t j_max = seg - 2;
+    uint16_t j_best = 0;
+
+    // checks segment j and keeps it if it is the earliest close segment found so far
+    auto check_segment = [&](uint16_t j) {
+        if ((j > j_max) || ((j_best != 0) && (j >= j_best))) {
+            return;
+        }
+        const dist_point dp_j = segment_segment_dist(p1, p2, _path[j-1], _path[j]);
+        if (dp_j.distance < SMARTRTL_PRUNING_DELTA) {
+            j_best = j;
+            dp = dp_j;
+        }
+    };
+
+    // short segments have their midpoint within half a cell of every point on them, so only cells within
+    // half a cell plus the pruning distance of this segment's bounding box may hold close segments
+    const float expand = _index.cell_size * 0.5f + SMARTRTL_PRUNING_DELTA;
+    int32_t x_min, y_min, x_max, y_max;
+    index_cell(Vector3f{MIN(p1.x, p2.x) - expand, MIN(p1.y, p2.y) - expand, 0.0f}, x_min, y_min);
+    index_cell(Vector3f{MAX(p1.x, p2.x) + expand, MAX(p1.y, p2.y) + expand, 0.0f}, x_max, y_max);
+    const int32_t num_cells = (x_max - x_min + 1) * (y_max - y_min + 1);
+
+    if (num_cells > SMARTRTL_INDEX_QUERY_CELLS_MAX) {
+        // this segment is long so it is quicker to check all earlier segments
+        for (uint16_t j = 1; j <= j_max; j++) {
+            const dist_point dp_j = segment_segment_dist(p1, p2, _path[j-1], _path[j]);
+            if (dp_j.distance < SMARTRTL_PRUNING_DELTA) {
+                dp = dp_j;
+                return j;
+            }
+        }
+        return 0;
+    }
+
+    // different cells may share a bucket so only check each bucket once
+    uint16_t buckets_checked[SMARTRTL_INDEX_QUERY_CELLS_MAX];
+    uint8_t num_buckets_checked = 0;
+    for (int32_t x = x_min; x <= x_max; x++) {
+        for (int32_t y = y_min; y <= y_max; y++) {
+            const uint16_t bucket = index_bucket(x, y);
+            bool already_checked = false;
+            for (uint8_t b = 0; b < num_buckets_checked; b++) {
+                if (buckets_checked[b] == bucket) {
+                    already_checked = true;
+                    break;
+                }
+            }
+            if (already_checked) {
+                continue;
+            }
+            buckets_checked[num_buckets_checked++] = bucket;
+            for (uint16_t j = _index.bucket_head[bucket]; j != 0; j = _index.next[j]) {
+                check_segment(j);
+            }
+        }
+    }
+
+    // long segments are always checked
+    for (uint16_t j = _index.long_head; j != 0; j = _index.next[j]) {
+        check_segment(j);
+    }
+
+    return j_best;
+}
+
+// return index grid cell coordinates for a position
+void AP_SmartRTL::index_cell(const Vector3f& point, int32_t &x, int32_t &y) const
+{
+    x = (int32_t)floorf(point.x / _index.cell_size);
+    y = (int32_t)floorf(point.y / _index.cell_size);
+}
+
+// return hash bucket for a grid cell
+uint16_t AP_SmartRTL::index_bucket(int32_t x, int32_t y) const
+{
+    return (((uint32_t)x * 73856093U) ^ ((uint32_t)y * 19349663U)) & _index.bucket_mask;
+}
+
 // de-activate SmartRTL, send warning to GCS and logger
 void AP_SmartRTL::deactivate(SRTL_Actions action, const char *reason)
 {
@@ -875,6 +1082,28 @@ void AP_SmartRTL::log_action(SRTL_Actions action, const Vector3f &point) const
     }
 }
 
+// log time taken by a cleanup algorithm to check num_points points
+// cleanup_type is 0 for simplification, 1 for loop detection
+void AP_SmartRTL::log_cleanup(uint8_t cleanup_type, uint16_t num_points, uint32_t duration_us) const
+{
+    if (_example_mode) {
+        return;
+    }
+    // @LoggerMessage: SRTC
+    // @Description: SmartRTL path cleanup timing
+    // @Field: TimeUS: Time since system startup
+    // @Field: Type: cleanup algorithm (0:simplify, 1:loop detection)
+    // @Field: NumPts: number of points on the path when the algorithm started
+    // @Field: Loops: number of loops found that may be pruned
+    // @Field: Dur: total time spent by the algorithm
+    AP::logger().Write("SRTC", "TimeUS,Type,NumPts,Loops,Dur", "s---s", "F---F", "QBHHI",
+                       AP_HAL::micros64(),
+                       cleanup_type,
+                       num_points,
+                       _prune.loops_count,
+                       duration_us);
+}
+
 // returns true if the two loops overlap (used within add_loop to determine which loops to keep or throw away)
 bool AP_SmartRTL::loops_overlap(const prune_loop_t &loop1, const prune_loop_t &loop2) const
 {
@@ -6,8 +6,14 @@
 
 // definitions and macros
 #define SMARTRTL_ACCURACY_DEFAULT        2.0f   // default _ACCURACY parameter value.  Points will be no closer than this distance (in meters) together.
-#define SMARTRTL_POINTS_DEFAULT          300    // default _POINTS parameter value.  High numbers improve path pruning but use more memory and CPU for cleanup. Memory used will be 20bytes * this number.
+#define SMARTRTL_POINTS_DEFAULT          300    // default _POINTS parameter value.  High numbers improve path pruning but use more memory and CPU for cleanup. Memory used will be 24bytes * this number.
+#ifndef SMARTRTL_POINTS_MAX
+#if HAL_MEM_CLASS >= HAL_MEM_CLASS_500
+#define SMARTRTL_POINTS_MAX              5000   // the absolute maximum number of points this library can support.
+#else
 #define SMARTRTL_POINTS_MAX              500    // the absolute maximum number of points this library can support.
+#endif
+#endif
 #define SMARTRTL_TIMEOUT                 15000  // the time in milliseconds with no points saved to the path (for whatever reason), before SmartRTL is disabled for the flight
 #define SMARTRTL_CLEANUP_POINT_TRIGGER   50     // simplification will trigger when this many points are added to the path
 #define SMARTRTL_CLEANUP_START_MARGIN    10     // routine cleanup algorithms begin when the path array has only this many empty slots remaining
@@ -20,6 +26,9 @@
 #define SMARTRTL_PRUNING_DELTA (_accuracy * 0.99)   // How many meters apart must two points be, such that we can assume that there is no obstacle between them.  must be smaller than _ACCURACY parameter
 #define SMARTRTL_PRUNING_LOOP_BUFFER_LEN_MULT 0.25f // pruning loop buffer size as compared to maximum number of points
 #define SMARTRTL_PRUNING_LOOP_TIME_US    200    // maximum time (in microseconds) that the loop finding algorithm will run before returning
+#define SMARTRTL_INDEX_CELL_SIZE MAX(_accuracy * 4.0f, 1.0f)   // segment index grid cell size in meters.  Larger cells hold more segments but fewer cells are checked
+#define SMARTRTL_INDEX_BUCKETS_DIV       4      // segment index has one bucket per this many points (rounded up to a power of two)
+#define SMARTRTL_INDEX_QUERY_CELLS_MAX   16     // segments spanning more grid cells than this are checked against all earlier segments
 
 class AP_SmartRTL {
 
@@ -169,11 +178,31 @@ private:
     // get the closest distance between 2 line segments and the point midway between the closest points
     static dist_point segment_segment_dist(const Vector3f& p1, const Vector3f& p2, const Vector3f& p3, const Vector3f& p4);
 
+    // segment index methods.  segment n joins path points n-1 and n
+    // reset index so that it holds no segments
+    void index_reset();
+
+    // remove all segments that include points at or after num_points from the index
+    void index_truncate(uint16_t num_points);
+
+    // add segments to index until it holds all segments joining the first num_points points
+    // returns true if complete, false if it ran out of time and should be called again
+    bool index_add_segments(uint16_t num_points, uint32_t start_time_us);
+
+    // return the lowest numbered segment between 1 and seg-2 that passes within SMARTRTL_PRUNING_DELTA of segment seg
+    // returns zero if no such segment exists, otherwise dp is filled in with the distance and midpoint
+    uint16_t index_find_loop(uint16_t seg, dist_point &dp) const;
+
+    // return index grid cell coordinates and hash bucket for a position
+    void index_cell(const Vector3f& point, int32_t &x, int32_t &y) const;
+    uint16_t index_bucket(int32_t x, int32_t y) const;
+
     // de-activate SmartRTL, send warning to GCS and logger
     void deactivate(SRTL_Actions action, const char *reason);
 
     // logging
     void log_action(SRTL_Actions action, const Vector3f &point = Vector3f()) const;
+    void log_cleanup(uint8_t cleanup_type, uint16_t num_points, uint32_t duration_us) const;
 
     // parameters
     AP_Float _accuracy;
@@ -212,6 +241,8 @@ private:
         simplify_start_finish_t* stack;
         uint16_t stack_max;     // maximum number of elements in the _simplify_stack array
         uint16_t stack_count;   // number of elements in _simplify_stack array
+        uint16_t first_removed; // lowest index of any point flagged for removal (only valid if removal_required is true)
+        uint32_t elapsed_us;    // time spent in detect_simplifications since it was restarted (for logging)
         Bitmask<SMARTRTL_POINTS_MAX> bitmask;  // simplify algorithm clears bits for each point that can be removed
     } _simplify;
 
@@ -226,8 +257,8 @@ private:
         bool complete;
         uint16_t path_points_count;  // copy of _path_points_count taken when the prune algorithm started
         uint16_t path_points_completed; // number of points in that path that have already been checked for loops and should be ignored
-        uint16_t i;     // loop search's outer loop index
-        uint16_t j;     // loop search's inner loop index
+        uint16_t i;     // loop search's index of the segment being checked
+        uint32_t elapsed_us;    // time spent in detect_loops since it was restarted (for logging)
         prune_loop_t* loops;// the result of the pruning algorithm
         uint16_t loops_max; // maximum number of elements in the _prunable_loops array
         uint16_t loops_count;   // number of elements in the _prunable_loops array
@@ -235,4 +266,18 @@ private:
 
     // returns true if the two loops overlap (used within add_loop to determine which loops to keep or throw away)
     bool loops_overlap(const prune_loop_t& loop1, const prune_loop_t& loop2) const;
+
+    // Segment index
+    // spatial hash of the path's segments used by detect_loops to find segments close to a new segment without
+    // comparing it against every earlier segment.  Each segment is stored in the horizontal grid cell holding
+    // its midpoint or, if it is longer than the cell size, in a separate list that is always checked.
+    // Segments are added in increasing order so every list is ordered from the newest to the oldest segment.
+    struct {
+        uint16_t* next;         // next segment in the same bucket or long list, indexed by segment. zero terminates list
+        uint16_t* bucket_head;  // newest segment in each bucket, zero if bucket is empty
+        uint16_t bucket_mask;   // number of buckets minus one
+        uint16_t long_head;     // newest segment that is longer than the cell size, zero if none
+        uint16_t num_points;    // segments joining the first num_points points are in the index
+        float cell_size;        // grid cell size in meters
+    } _index;
 };
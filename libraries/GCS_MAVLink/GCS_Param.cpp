@@ -28,6 +28,9 @@ ObjectBuffer<GCS_MAVLINK::pending_param_reply> GCS_MAVLINK::param_replies(5);
 
 bool GCS_MAVLINK::param_timer_registered;
 
+// name of the pseudo-parameter holding the parameter set hash
+#define PARAM_HASH_CHECK_NAME "_HASH_CHECK"
+
 /**
  * @brief Send the next pending parameter, called from deferred message
  * handling code
@@ -379,6 +382,25 @@ void GCS_MAVLINK::param_io_timer(void)
     struct pending_param_reply reply;
     AP_Param *vp;
 
+    if (req.param_index == -1 && strncmp(req.param_name, PARAM_HASH_CHECK_NAME, AP_MAX_NAME_SIZE) == 0) {
+        /*
+          a GCS with a cached parameter list asks for the hash of
+          the parameter set to decide whether it needs to fetch the
+          list again. Values are sent as floats so the hash is cut to
+          24 bits to be exact; a GCS wanting more can fetch the full
+          hashes, per block, from @PARAM/param.hsh
+         */
+        reply.chan = req.chan;
+        strncpy(reply.param_name, PARAM_HASH_CHECK_NAME, AP_MAX_NAME_SIZE+1);
+        reply.param_name[AP_MAX_NAME_SIZE] = 0;
+        reply.p_type = AP_PARAM_INT32;
+        reply.value = float(AP_Param::hash_parameters() & 0xFFFFFFU);
+        reply.param_index = -1;
+        reply.count = AP_Param::count_parameters();
+        param_replies.push(reply);
+        return;
+    }
+
     if (req.param_index != -1) {
         AP_Param::ParamToken token {};
         vp = AP_Param::find_by_index(req.param_index, &reply.p_type, &token);
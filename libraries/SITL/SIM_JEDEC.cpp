@@ -65,6 +65,16 @@ void JEDEC::bulk_erase()
     }
 }
 
+bool JEDEC::busy() const
+{
+    return AP_HAL::micros64() < busy_until_us;
+}
+
+void JEDEC::start_busy(uint32_t duration_us)
+{
+    busy_until_us = AP_HAL::micros64() + duration_us;
+}
+
 uint32_t JEDEC::parse_addr (uint8_t* buffer, uint32_t len)
 {
     if (len<4) {
@@ -107,6 +117,10 @@ int JEDEC::rdwr(uint8_t count, SPI::spi_ioc_transfer *&tfrs)
         case State::WAITING: {
             // find a command
             uint8_t command = tx_buf[0];
+            if (busy() && command != JEDEC_RDSR && command != JEDEC_RDID) {
+                // a real device ignores these, which would silently corrupt the log
+                AP_HAL::panic("JEDEC: command 0x%02x while busy", (unsigned)command);
+            }
             switch (command) {
             case JEDEC_RDID:
                 state = State::READING_RDID;
@@ -129,12 +143,14 @@ int JEDEC::rdwr(uint8_t count, SPI::spi_ioc_transfer *&tfrs)
                 xfr_addr = parse_addr(tx_buf, tfr.len);
                 assert_writes_enabled();
                 sector4k_erase(xfr_addr);
+                start_busy(get_sector4k_erase_us());
                 write_enabled = false;
                 break;
             }
             case JEDEC_BULK_ERASE:  {
                 assert_writes_enabled();
                 bulk_erase();
+                start_busy(get_bulk_erase_us());
                 write_enabled = false;
                 break;
             }
@@ -142,6 +158,7 @@ int JEDEC::rdwr(uint8_t count, SPI::spi_ioc_transfer *&tfrs)
                 xfr_addr = parse_addr(tx_buf, tfr.len);
                 assert_writes_enabled();
                 block64k_erase(xfr_addr);
+                start_busy(get_block64k_erase_us());
                 write_enabled = false;
                 break;
             }
@@ -156,6 +173,10 @@ int JEDEC::rdwr(uint8_t count, SPI::spi_ioc_transfer *&tfrs)
             break;
         case State::READING_RDSR:
             fill_rdsr(rx_buf, tfr.len);
+            if (busy()) {
+                // write in progress
+                rx_buf[0] |= 0x01;
+            }
             state = State::WAITING;
             break;
         case State::READING: {
@@ -184,6 +205,7 @@ int JEDEC::rdwr(uint8_t count, SPI::spi_ioc_transfer *&tfrs)
             if (write_ret != tfr.len) {
                 AP_HAL::panic("write(): %s (%d/%u)", strerror(errno), (signed)write_ret, (unsigned)tfr.len);
             }
+            start_busy(get_page_program_us());
             state = State::WAITING;
             write_enabled = false;
             break;
@@ -30,6 +30,13 @@ protected:
     uint32_t get_storage_size() const { return get_num_pages()*get_page_size(); } // in bytes
     uint32_t get_num_pages() const { return get_num_blocks()*get_page_per_block(); }
 
+    // program and erase times in microseconds, the device reports
+    // busy in the status register until these have elapsed
+    virtual uint32_t get_page_program_us() const { return 0; }
+    virtual uint32_t get_sector4k_erase_us() const { return 0; }
+    virtual uint32_t get_block64k_erase_us() const { return 0; }
+    virtual uint32_t get_bulk_erase_us() const { return 0; }
+
 private:
 
     enum class State {
@@ -43,6 +50,11 @@ private:
     bool write_enabled;
     uint32_t xfr_addr;
 
+    // time at which the current program or erase operation completes
+    uint64_t busy_until_us;
+    bool busy() const;
+    void start_busy(uint32_t duration_us);
+
     void sector4k_erase(uint32_t addr);
     void block64k_erase(uint32_t addr);
     void page_erase(uint32_t addr);
@@ -23,6 +23,13 @@ protected:
     uint8_t get_page_per_sector() const override { return 16; }
     uint16_t get_page_size() const override { return 256; }
 
+    // typical timings from the datasheet, except chip erase (25s
+    // typical) which is shortened to keep log erases in SITL quick
+    uint32_t get_page_program_us() const override { return 1400; }
+    uint32_t get_sector4k_erase_us() const override { return 60000; }
+    uint32_t get_block64k_erase_us() const override { return 700000; }
+    uint32_t get_bulk_erase_us() const override { return 2000000; }
+
 private:
 
     static const uint8_t type = 0x20;